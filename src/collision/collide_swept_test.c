@@ -83,19 +83,19 @@ void test_collide_object_to_mesh_swept(struct test_context* t) {
     test_ltf(t, position.z, prev_pos.z * simple_cube_object.bounce);
     test_near_equalf(t, -0.5f, object.velocity.z);
 
-    test_neqi(t, (int)NULL, (int)object.active_contacts);
+    test_neqp(t, NULL, object.active_contacts);
 
     test_near_equalf(t, 0.0f, object.active_contacts->normal.x);
     test_near_equalf(t, 0.0f, object.active_contacts->normal.y);
     test_near_equalf(t, -1.0f, object.active_contacts->normal.z);
 
     collision_scene_return_contacts(&object);
-    test_eqi(t, (int)NULL, (int)object.active_contacts);
+    test_eqp(t, NULL, object.active_contacts);
 
     prev_pos = (struct Vector3){0.5f, 0.75f, -1.0f};
     position = (struct Vector3){0.5f, 0.75f, 1.0f};
 
     did_hit = collide_object_to_mesh_swept(&object, &single_traingle_mesh, &prev_pos);
     test_eqi(t, false, did_hit);
-    test_eqi(t, (int)NULL, (int)object.active_contacts);
+    test_eqp(t, NULL, object.active_contacts);
 }
\ No newline at end of file
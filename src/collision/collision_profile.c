@@ -0,0 +1,71 @@
+#include "collision_profile.h"
+
+#include <libdragon.h>
+#include <stdio.h>
+#include <string.h>
+
+struct collision_profile g_collision_profile;
+
+const char* collision_stage_names[COLLISION_STAGE_COUNT] = {
+    "integrate",
+    "swept_mesh",
+    "static_mesh",
+    "broadphase",
+    "narrowphase",
+    "projectiles",
+};
+
+void collision_profile_reset() {
+    memset(&g_collision_profile, 0, sizeof(g_collision_profile));
+}
+
+uint32_t collision_profile_ticks() {
+    return get_ticks();
+}
+
+uint32_t collision_profile_add_stage(enum collision_stage stage, uint32_t start) {
+    uint32_t ticks = get_ticks() - start;
+    g_collision_profile.stage_ticks[stage] += ticks;
+    g_collision_profile.stage_calls[stage] += 1;
+    return ticks;
+}
+
+static void collision_profile_add_iterations(uint32_t* histogram, int iterations) {
+    if (iterations > COLLISION_PROFILE_MAX_ITERATIONS) {
+        iterations = COLLISION_PROFILE_MAX_ITERATIONS;
+    }
+
+    histogram[iterations] += 1;
+}
+
+void collision_profile_gjk(int iterations) {
+    collision_profile_add_iterations(g_collision_profile.gjk_iterations, iterations);
+}
+
+void collision_profile_epa(int iterations) {
+    collision_profile_add_iterations(g_collision_profile.epa_iterations, iterations);
+}
+
+void collision_profile_report() {
+    int ticks = g_collision_profile.ticks ? g_collision_profile.ticks : 1;
+
+    fprintf(stderr, "collision profile (average over %d ticks):\n", ticks);
+
+    for (int i = 0; i < COLLISION_STAGE_COUNT; i += 1) {
+        fprintf(
+            stderr,
+            "    %-12s %5dus %4d calls\n",
+            collision_stage_names[i],
+            (int)TICKS_TO_US(g_collision_profile.stage_ticks[i] / ticks),
+            (int)(g_collision_profile.stage_calls[i] / ticks)
+        );
+    }
+
+    fprintf(
+        stderr, 
+        "    contacts %d max %d dropped %d\n", 
+        (int)(g_collision_profile.contacts / ticks), 
+        (int)g_collision_profile.max_contacts,
+        (int)g_collision_profile.contacts_dropped
+    );
+}
@@ -0,0 +1,49 @@
+#ifndef __COLLISION_COLLISION_PROFILE_H__
+#define __COLLISION_COLLISION_PROFILE_H__
+
+#include <stdint.h>
+
+// build with COLLISION_PROFILE defined to time each stage of
+// collision_scene_collide and record how long gjk and epa take
+// to converge
+
+enum collision_stage {
+    COLLISION_STAGE_INTEGRATE,
+    COLLISION_STAGE_SWEPT_MESH,
+    COLLISION_STAGE_STATIC_MESH,
+    COLLISION_STAGE_BROADPHASE,
+    COLLISION_STAGE_NARROWPHASE,
+    COLLISION_STAGE_PROJECTILES,
+
+    COLLISION_STAGE_COUNT,
+};
+
+// the last bucket counts calls that hit the iteration limit
+#define COLLISION_PROFILE_MAX_ITERATIONS    16
+#define COLLISION_PROFILE_REPORT_INTERVAL   300
+
+struct collision_profile {
+    uint64_t stage_ticks[COLLISION_STAGE_COUNT];
+    uint32_t stage_calls[COLLISION_STAGE_COUNT];
+    uint32_t gjk_iterations[COLLISION_PROFILE_MAX_ITERATIONS + 1];
+    uint32_t epa_iterations[COLLISION_PROFILE_MAX_ITERATIONS + 1];
+    uint32_t ticks;
+    uint32_t contacts;
+    uint32_t max_contacts;
+    // contacts that were dropped because the contact pool was empty
+    uint32_t contacts_dropped;
+};
+
+extern struct collision_profile g_collision_profile;
+
+extern const char* collision_stage_names[COLLISION_STAGE_COUNT];
+
+void collision_profile_reset();
+uint32_t collision_profile_ticks();
+// returns the ticks added
+uint32_t collision_profile_add_stage(enum collision_stage stage, uint32_t start);
+void collision_profile_gjk(int iterations);
+void collision_profile_epa(int iterations);
+void collision_profile_report();
+
+#endif
@@ -9,21 +9,24 @@
 #include "collide.h"
 #include "collide_swept.h"
 #include "contact.h"
-#include "../util/hash_map.h"
+#include "collision_profile.h"
+#include "../util/memory_tag.h"
+#include "../util/hash.h"
+#include "../time/frame_profile.h"
 
 struct collision_scene g_scene;
 
 void collision_scene_reset() {
-    free(g_scene.elements);
-    free(g_scene.all_contacts);
-    hash_map_destroy(&g_scene.entity_mapping);
+    tagged_free(g_scene.elements);
+    tagged_free(g_scene.all_contacts);
+    component_set_destroy(&g_scene.entity_mapping);
 
-    hash_map_init(&g_scene.entity_mapping, MIN_DYNAMIC_OBJECTS);
+    component_set_init(&g_scene.entity_mapping, MIN_DYNAMIC_OBJECTS);
 
-    g_scene.elements = malloc(sizeof(struct collision_scene_element) * MIN_DYNAMIC_OBJECTS);
+    g_scene.elements = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct collision_scene_element) * MIN_DYNAMIC_OBJECTS);
     g_scene.capacity = MIN_DYNAMIC_OBJECTS;
     g_scene.count = 0;
-    g_scene.all_contacts = malloc(sizeof(struct contact) * MAX_ACTIVE_CONTACTS);
+    g_scene.all_contacts = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct contact) * MAX_ACTIVE_CONTACTS);
     g_scene.next_free_contact = &g_scene.all_contacts[0];
 
     for (int i = 0; i + 1 < MAX_ACTIVE_CONTACTS; ++i) {
@@ -36,7 +39,7 @@ void collision_scene_reset() {
 void collision_scene_add(struct dynamic_object* object) {
     if (g_scene.count >= g_scene.capacity) {
         g_scene.capacity *= 2;
-        g_scene.elements = realloc(g_scene.elements, sizeof(struct collision_scene_element) * g_scene.capacity);
+        g_scene.elements = tagged_realloc(MEMORY_TAG_COLLISION, g_scene.elements, sizeof(struct collision_scene_element) * g_scene.capacity);
     }
 
     struct collision_scene_element* next = &g_scene.elements[g_scene.count];
@@ -45,7 +48,7 @@ void collision_scene_add(struct dynamic_object* object) {
 
     g_scene.count += 1;
 
-    hash_map_set(&g_scene.entity_mapping, object->entity_id, object);
+    component_set_add(&g_scene.entity_mapping, object->entity_id, object);
 }
 
 
@@ -54,7 +57,7 @@ struct dynamic_object* collision_scene_find_object(entity_id id) {
         return 0;
     }
 
-    return hash_map_get(&g_scene.entity_mapping, id);
+    return component_set_get(&g_scene.entity_mapping, id);
 }
 
 void collision_scene_return_contacts(struct dynamic_object* object) {
@@ -89,7 +92,7 @@ void collision_scene_remove(struct dynamic_object* object) {
         g_scene.count -= 1;
     }
 
-    hash_map_delete(&g_scene.entity_mapping, object->entity_id);
+    component_set_remove(&g_scene.entity_mapping, object->entity_id);
 }
 
 void collision_scene_use_static_collision(struct mesh_collider* collider) {
@@ -148,6 +151,10 @@ void collide_edge_sort(struct collide_edge* edges, struct collide_edge* tmp, int
 }
 
 void collision_scene_collide_dynamic() {
+#ifdef COLLISION_PROFILE
+    uint32_t broadphase_start = collision_profile_ticks();
+    uint32_t narrowphase_ticks = 0;
+#endif
     int edge_count = g_scene.count * 2;
 
     struct collide_edge collide_edges[edge_count];
@@ -186,7 +193,13 @@ void collision_scene_collide_dynamic() {
                 struct dynamic_object* b = g_scene.elements[active_objects[active_index]].object;
 
                 if (box3DHasOverlap(&a->bounding_box, &b->bounding_box)) {
+#ifdef COLLISION_PROFILE
+                    uint32_t narrowphase_start = collision_profile_ticks();
+#endif
                     collide_object_to_object(a, b);
+#ifdef COLLISION_PROFILE
+                    narrowphase_ticks += collision_profile_add_stage(COLLISION_STAGE_NARROWPHASE, narrowphase_start);
+#endif
                 }
             }
 
@@ -210,6 +223,11 @@ void collision_scene_collide_dynamic() {
             active_object_count -= 1;
         }
     }
+
+#ifdef COLLISION_PROFILE
+    // narrowphase time is recorded separately
+    collision_profile_add_stage(COLLISION_STAGE_BROADPHASE, broadphase_start + narrowphase_ticks);
+#endif
 }
 
 #define MAX_SWEPT_ITERATIONS    5
@@ -226,11 +244,24 @@ void collision_scene_collide_single(struct dynamic_object* object, struct Vector
             fabs(offset.y) > bbSize.y ||
             fabs(offset.z) > bbSize.z
         ) {
-            if (!collide_object_to_mesh_swept(object, g_scene.mesh_collider, prev_pos)) {
+#ifdef COLLISION_PROFILE
+            uint32_t swept_start = collision_profile_ticks();
+            bool did_hit = collide_object_to_mesh_swept(object, g_scene.mesh_collider, prev_pos);
+            collision_profile_add_stage(COLLISION_STAGE_SWEPT_MESH, swept_start);
+#else
+            bool did_hit = collide_object_to_mesh_swept(object, g_scene.mesh_collider, prev_pos);
+#endif
+            if (!did_hit) {
                 return;
             }
         } else {
+#ifdef COLLISION_PROFILE
+            uint32_t static_start = collision_profile_ticks();
+            collide_object_to_mesh(object, g_scene.mesh_collider);
+            collision_profile_add_stage(COLLISION_STAGE_STATIC_MESH, static_start);
+#else
             collide_object_to_mesh(object, g_scene.mesh_collider);
+#endif
             return;
         }
     }
@@ -243,8 +274,13 @@ void collision_scene_collide_single(struct dynamic_object* object, struct Vector
 }
 
 void collision_scene_collide() {
+    FRAME_PROFILE_BEGIN(FRAME_ZONE_COLLISION);
     struct Vector3 prev_pos[g_scene.count];
 
+#ifdef COLLISION_PROFILE
+    uint32_t integrate_start = collision_profile_ticks();
+#endif
+
     for (int i = 0; i < g_scene.count; ++i) {
         struct collision_scene_element* element = &g_scene.elements[i];
         prev_pos[i] = *element->object->position;
@@ -256,6 +292,10 @@ void collision_scene_collide() {
         dynamic_object_recalc_bb(element->object);
     }
 
+#ifdef COLLISION_PROFILE
+    collision_profile_add_stage(COLLISION_STAGE_INTEGRATE, integrate_start);
+#endif
+
     for (int i = 0; i < g_scene.count; ++i) {
         struct collision_scene_element* element = &g_scene.elements[i];
 
@@ -269,10 +309,30 @@ void collision_scene_collide() {
     }
 
     collision_scene_collide_dynamic();
+
+#ifdef COLLISION_PROFILE
+    uint32_t contact_count = MAX_ACTIVE_CONTACTS;
+
+    for (struct contact* contact = g_scene.next_free_contact; contact; contact = contact->next) {
+        contact_count -= 1;
+    }
+
+    g_collision_profile.ticks += 1;
+    g_collision_profile.contacts += contact_count;
+
+    if (contact_count > g_collision_profile.max_contacts) {
+        g_collision_profile.max_contacts = contact_count;
+    }
+#endif
+
+    FRAME_PROFILE_END(FRAME_ZONE_COLLISION);
 }
 
 struct contact* collision_scene_new_contact() {
     if (!g_scene.next_free_contact) {
+#ifdef COLLISION_PROFILE
+        g_collision_profile.contacts_dropped += 1;
+#endif
         return NULL;
     }
 
@@ -325,4 +385,40 @@ void collision_scene_query(struct dynamic_object_type* shape, struct Vector3* ce
 
         callback(callback_data, element->object);
     }
-}
\ No newline at end of file
+}
+
+int collision_scene_gather(int collision_layers, int collision_group, struct dynamic_object** targets, int max_targets) {
+    int result = 0;
+
+    for (int i = 0; i < g_scene.count; ++i) {
+        struct dynamic_object* object = g_scene.elements[i].object;
+
+        if (!(object->collision_layers & collision_layers) || object->is_trigger) {
+            continue;
+        }
+
+        if (collision_group && object->collision_group == collision_group) {
+            continue;
+        }
+
+        if (result < max_targets) {
+            targets[result] = object;
+        }
+
+        result += 1;
+    }
+
+    return result;
+}
+
+uint32_t collision_scene_state_hash(uint32_t hash) {
+    for (int i = 0; i < g_scene.count; ++i) {
+        struct dynamic_object* object = g_scene.elements[i].object;
+
+        hash = hash_bytes(hash, &object->entity_id, sizeof(entity_id));
+        hash = hash_bytes(hash, object->position, sizeof(struct Vector3));
+        hash = hash_bytes(hash, &object->velocity, sizeof(struct Vector3));
+    }
+
+    return hash;
+}
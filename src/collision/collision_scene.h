@@ -3,7 +3,7 @@
 
 #include "dynamic_object.h"
 #include "../collision/mesh_collider.h"
-#include "../util/hash_map.h"
+#include "../entity/component_set.h"
 #include "contact.h"
 
 typedef int collision_id;
@@ -19,7 +19,7 @@ struct collision_scene {
     struct collision_scene_element* elements;
     struct contact* next_free_contact;
     struct contact* all_contacts;
-    struct hash_map entity_mapping;
+    struct component_set entity_mapping;
     uint16_t count;
     uint16_t capacity;
 
@@ -43,4 +43,13 @@ typedef void (*collision_scene_query_callback)(void* data, struct dynamic_object
 
 void collision_scene_query(struct dynamic_object_type* shape, struct Vector3* center, int collision_layers, collision_scene_query_callback callback, void* callback_data);
 
+// fills targets with the solid objects on any of collision_layers that
+// aren't part of collision_group, returns how many matched which can
+// be more than max_targets, only max_targets are written
+int collision_scene_gather(int collision_layers, int collision_group, struct dynamic_object** targets, int max_targets);
+
+// folds the position and velocity of every object into hash, two
+// runs that end with the same hash simulated the same way
+uint32_t collision_scene_state_hash(uint32_t hash);
+
 #endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "epa.h"
+#include "collision_profile.h"
 
 #include <assert.h>
 #include "../math/plane.h"
@@ -435,7 +436,9 @@ bool epaSolve(struct Simplex* startingSimplex, void* objectA, MinkowsiSum object
     struct SimplexTriangle* closestFace = 0;
     float projection = 0.0f;
 
-    for (int i = 0; i < MAX_ITERATIONS; ++i) {
+    int i;
+
+    for (i = 0; i < MAX_ITERATIONS; ++i) {
         struct Vector3 reverseNormal;
 
         closestFace = expandingSimplexClosestFace(&simplex);
@@ -461,6 +464,10 @@ bool epaSolve(struct Simplex* startingSimplex, void* objectA, MinkowsiSum object
         expandingSimplexExpand(&simplex, nextIndex, simplex.triangleHeap[0]);
     }
 
+#ifdef COLLISION_PROFILE
+    collision_profile_epa(i);
+#endif
+
     if (closestFace) {
         result->normal = closestFace->normal;
         result->penetration = -projection;
@@ -517,7 +524,9 @@ int epaSolveSwept(struct Simplex* startingSimplex, void* objectA, MinkowsiSum ob
     struct Vector3 raycastDir;
     vector3Sub(bStart, bEnd, &raycastDir);
 
-    for (int i = 0; i < MAX_ITERATIONS; ++i) {
+    int i;
+
+    for (i = 0; i < MAX_ITERATIONS; ++i) {
         struct Vector3 reverseNormal;
 
         epaSweptFindFace(&simplex, &raycastDir, &currentTriangle, &currentEdge);
@@ -545,6 +554,10 @@ int epaSolveSwept(struct Simplex* startingSimplex, void* objectA, MinkowsiSum ob
         expandingSimplexExpand(&simplex, nextIndex, currentTriangle);
     }
 
+#ifdef COLLISION_PROFILE
+    collision_profile_epa(i);
+#endif
+
     if (closestFace) {
         vector3Normalize(&raycastDir, &raycastDir);
         vector3Normalize(&closestFace->normal, &result->normal);
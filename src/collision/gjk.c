@@ -1,5 +1,7 @@
 #include "gjk.h"
 
+#include "collision_profile.h"
+
 void simplexInit(struct Simplex* simplex) {
     simplex->nPoints = 0;
 }
@@ -185,7 +187,10 @@ int gjkCheckForOverlap(struct Simplex* simplex, void* objectA, MinkowsiSum objec
         simplexAddPoint(simplex, &aPoint, &bPoint);
     }
 
-    for (int iteration = 0; iteration < MAX_GJK_ITERATIONS; ++iteration) {
+    int result = 0;
+    int iteration;
+
+    for (iteration = 0; iteration < MAX_GJK_ITERATIONS; ++iteration) {
         struct Vector3 reverseDirection;
         vector3Negate(&nextDirection, &reverseDirection);
         objectASum(objectA, &nextDirection, &aPoint);
@@ -194,19 +199,24 @@ int gjkCheckForOverlap(struct Simplex* simplex, void* objectA, MinkowsiSum objec
         struct Vector3* addedPoint = simplexAddPoint(simplex, &aPoint, &bPoint);
 
         if (!addedPoint) {
-            return 0;
+            break;
         }
         
         if (vector3Dot(addedPoint, &nextDirection) <= 0.0f) {
-            return 0;
+            break;
         }
 
 
         if (simplexCheck(simplex, &nextDirection)) {
-            return 1;
+            result = 1;
+            break;
         }
 
     }
 
-    return 0;
+#ifdef COLLISION_PROFILE
+    collision_profile_gjk(iteration);
+#endif
+
+    return result;
 }
\ No newline at end of file
@@ -162,7 +162,7 @@ void mesh_index_lookup_triangle_indices(struct mesh_index* index, struct Box3D*
 
 float mesh_index_inv_offset(float input) {
     if (fabsf(input) < 0.000001f) {
-        return infinityf();
+        return INFINITY;
     }
 
     return 1.0f / input;
@@ -274,7 +274,7 @@ enum mesh_range_result mesh_index_swept_determine_ranges(
 }
 
 bool is_inf(float value) {
-    return value == infinityf() || value == -infinityf();
+    return value == INFINITY || value == -INFINITY;
 }
 
 bool mesh_index_swept_lookup(struct mesh_index* index, struct Box3D* end_position, struct Vector3* move_amount, triangle_callback callback, void* data) {
@@ -367,4 +367,127 @@ bool mesh_index_is_contained(struct mesh_index* index, struct Vector3* point) {
     vector3Multiply(&local_position, &index->stride_inv, &local_position);
     return local_position.x >= 0 && local_position.y >= 0 && local_position.z >= 0 &&
         local_position.x <= index->block_count.x && local_position.y <= index->block_count.y && local_position.z <= index->block_count.z;
-}
\ No newline at end of file
+}
+
+struct mesh_sweep_data {
+    struct mesh_collider* mesh;
+    struct Vector3* start;
+    struct Vector3* offset;
+    float radius;
+    struct mesh_sweep_hit* hit;
+    bool did_hit;
+};
+
+static bool mesh_sweep_sphere_triangle(struct mesh_index* index, void* data, int triangle_index) {
+    struct mesh_sweep_data* sweep = (struct mesh_sweep_data*)data;
+    struct mesh_triangle_indices* triangle = &sweep->mesh->triangles[triangle_index];
+
+    struct Vector3* a = &sweep->mesh->vertices[triangle->indices[0]];
+    struct Vector3* b = &sweep->mesh->vertices[triangle->indices[1]];
+    struct Vector3* c = &sweep->mesh->vertices[triangle->indices[2]];
+
+    struct Vector3 edge_ab;
+    struct Vector3 edge_ac;
+    struct Vector3 normal;
+    vector3Sub(b, a, &edge_ab);
+    vector3Sub(c, a, &edge_ac);
+    vector3Cross(&edge_ab, &edge_ac, &normal);
+
+    float normal_length_sqrd = vector3MagSqrd(&normal);
+
+    if (normal_length_sqrd < 0.00001f) {
+        return false;
+    }
+
+    vector3Scale(&normal, &normal, 1.0f / sqrtf(normal_length_sqrd));
+
+    float approach = vector3Dot(sweep->offset, &normal);
+
+    // moving away from or along the triangle
+    if (approach >= 0.0f) {
+        return false;
+    }
+
+    struct Vector3 relative_start;
+    vector3Sub(sweep->start, a, &relative_start);
+    float start_distance = vector3Dot(&relative_start, &normal) - sweep->radius;
+
+    // already behind the triangle
+    if (start_distance < -sweep->radius) {
+        return false;
+    }
+
+    float end_distance = start_distance + approach;
+
+    if (end_distance >= 0.0f) {
+        return false;
+    }
+
+    float distance = start_distance > 0.0f ? start_distance / (start_distance - end_distance) : 0.0f;
+
+    if (distance >= sweep->hit->distance) {
+        return false;
+    }
+
+    struct Vector3 center;
+    vector3AddScaled(sweep->start, sweep->offset, distance, &center);
+
+    struct Vector3 point;
+    struct Vector3 relative_center;
+    vector3Sub(&center, a, &relative_center);
+    vector3AddScaled(&center, &normal, -vector3Dot(&relative_center, &normal), &point);
+
+    // check the point is within radius of every edge
+    struct Vector3* vertices[3] = {a, b, c};
+
+    for (int i = 0; i < 3; i += 1) {
+        struct Vector3* from = vertices[i];
+        struct Vector3* to = vertices[i == 2 ? 0 : i + 1];
+
+        struct Vector3 edge;
+        struct Vector3 edge_normal;
+        struct Vector3 relative_point;
+        vector3Sub(to, from, &edge);
+        vector3Cross(&edge, &normal, &edge_normal);
+        vector3Normalize(&edge_normal, &edge_normal);
+        vector3Sub(&point, from, &relative_point);
+
+        // edge_normal points out of the triangle
+        if (vector3Dot(&relative_point, &edge_normal) > sweep->radius) {
+            return false;
+        }
+    }
+
+    sweep->hit->distance = distance;
+    sweep->hit->point = point;
+    sweep->hit->normal = normal;
+    sweep->did_hit = true;
+
+    return true;
+}
+
+bool mesh_collider_sweep_sphere(struct mesh_collider* mesh, struct Vector3* start, struct Vector3* offset, float radius, struct mesh_sweep_hit* hit) {
+    struct mesh_sweep_data sweep;
+    sweep.mesh = mesh;
+    sweep.start = start;
+    sweep.offset = offset;
+    sweep.radius = radius;
+    sweep.hit = hit;
+    sweep.did_hit = false;
+
+    hit->distance = 1.0f;
+
+    struct Box3D end_box;
+    vector3Add(start, offset, &end_box.min);
+    end_box.max = end_box.min;
+    end_box.min.x -= radius;
+    end_box.min.y -= radius;
+    end_box.min.z -= radius;
+    end_box.max.x += radius;
+    end_box.max.y += radius;
+    end_box.max.z += radius;
+
+    mesh_index_swept_lookup(&mesh->index, &end_box, offset, mesh_sweep_sphere_triangle, &sweep);
+
+    return sweep.did_hit;
+}
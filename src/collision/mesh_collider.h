@@ -38,6 +38,13 @@ struct mesh_triangle {
     struct mesh_triangle_indices triangle;
 };
 
+struct mesh_sweep_hit {
+    // how far along the sweep the hit happened from 0 to 1
+    float distance;
+    struct Vector3 point;
+    struct Vector3 normal;
+};
+
 typedef bool (*triangle_callback)(struct mesh_index* index, void* data, int triangle_index);
 
 void mesh_triangle_minkowski_sum(void* data, struct Vector3* direction, struct Vector3* output);
@@ -46,4 +53,9 @@ void mesh_index_lookup_triangle_indices(struct mesh_index* index, struct Box3D*
 bool mesh_index_swept_lookup(struct mesh_index* index, struct Box3D* end_position, struct Vector3* move_amount, triangle_callback callback, void* data);
 bool mesh_index_is_contained(struct mesh_index* index, struct Vector3* point);
 
+// a cheaper stand in for the gjk sweep meant for small fast objects,
+// the center is swept against each triangle pushed out by radius so
+// corners are treated a bit more generously than a true sphere
+bool mesh_collider_sweep_sphere(struct mesh_collider* mesh, struct Vector3* start, struct Vector3* offset, float radius, struct mesh_sweep_hit* hit);
+
 #endif
\ No newline at end of file
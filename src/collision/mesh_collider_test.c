@@ -96,4 +96,56 @@ void test_mesh_index_swept_lookup(struct test_context* t) {
 
     test_eqi(t, 13, lower_info.collide_count);
     test_eqi(t, 0, !(info.colliders & lower_info.colliders));
-}
\ No newline at end of file
+}
+
+static struct Vector3 test_floor_vertices[] = {
+    {-10.0f, 0.0f, -10.0f},
+    {-10.0f, 0.0f, 10.0f},
+    {10.0f, 0.0f, 10.0f},
+    {10.0f, 0.0f, -10.0f},
+};
+
+static struct mesh_triangle_indices test_floor_triangles[] = {
+    {{0, 1, 2}},
+    {{0, 2, 3}},
+};
+
+static struct mesh_index_block test_floor_blocks[] = {
+    {0, 2},
+};
+
+static uint16_t test_floor_index_indices[] = {0, 1};
+
+void test_mesh_collider_sweep_sphere(struct test_context* t) {
+    struct mesh_collider floor = {
+        .vertices = test_floor_vertices,
+        .triangles = test_floor_triangles,
+        .triangle_count = 2,
+        .index = {
+            .min = {-10.0f, -1.0f, -10.0f},
+            .stride_inv = {1.0f / 20.0f, 1.0f / 2.0f, 1.0f / 20.0f},
+            .block_count = {1, 1, 1},
+            .blocks = test_floor_blocks,
+            .index_indices = test_floor_index_indices,
+        },
+    };
+
+    struct mesh_sweep_hit hit;
+
+    test_eqi(t, 1, mesh_collider_sweep_sphere(&floor, &(struct Vector3){0.0f, 2.0f, 0.0f}, &(struct Vector3){0.0f, -4.0f, 0.0f}, 0.25f, &hit));
+    test_near_equalf(t, 0.4375f, hit.distance);
+    test_near_equalf(t, 1.0f, hit.normal.y);
+    test_near_equalf(t, 0.0f, hit.point.y);
+
+    // moving away or stopping short
+    test_eqi(t, 0, mesh_collider_sweep_sphere(&floor, &(struct Vector3){0.0f, 2.0f, 0.0f}, &(struct Vector3){0.0f, 1.0f, 0.0f}, 0.25f, &hit));
+    test_eqi(t, 0, mesh_collider_sweep_sphere(&floor, &(struct Vector3){0.0f, 2.0f, 0.0f}, &(struct Vector3){1.0f, -1.0f, 0.0f}, 0.25f, &hit));
+
+    // clipping the edge counts, missing it by more than the radius doesn't
+    test_eqi(t, 1, mesh_collider_sweep_sphere(&floor, &(struct Vector3){10.2f, 1.0f, 0.0f}, &(struct Vector3){0.0f, -2.0f, 0.0f}, 0.25f, &hit));
+    test_eqi(t, 0, mesh_collider_sweep_sphere(&floor, &(struct Vector3){11.0f, 1.0f, 0.0f}, &(struct Vector3){0.0f, -2.0f, 0.0f}, 0.25f, &hit));
+
+    // starting within the radius of the floor is a hit right away
+    test_eqi(t, 1, mesh_collider_sweep_sphere(&floor, &(struct Vector3){0.0f, 0.1f, 0.0f}, &(struct Vector3){0.0f, -0.5f, 0.0f}, 0.25f, &hit));
+    test_near_equalf(t, 0.0f, hit.distance);
+}
@@ -5,6 +5,7 @@
 #include <assert.h>
 
 #include "../time/time.h"
+#include "../util/memory_tag.h"
 
 #define EXPECTED_HEADER 0x4354534E
 
@@ -23,7 +24,7 @@ char* cutscene_load_string(FILE* file) {
         length = lower_length;
     }
 
-    char* result = malloc(length + 1);
+    char* result = tagged_malloc(MEMORY_TAG_CUTSCENE, length + 1);
     fread(result, 1, length, file);
     result[length] = '\0';
     return result;
@@ -37,7 +38,7 @@ void cutscene_load_template_string(struct templated_string* string, FILE* file)
 }
 
 void cutscene_destroy_template_string(struct templated_string* string) {
-    free(string->template);
+    tagged_free(string->template);
 }
 
 struct cutscene* cutscene_load(char* filename) {
@@ -89,6 +90,21 @@ struct cutscene* cutscene_load(char* filename) {
             case CUTSCENE_STEP_TYPE_SET_GLOBAL:
                 fread(&step->data.store_variable, 4, 1, file);
                 break;
+            case CUTSCENE_STEP_TYPE_JUMP_IF_NOT_COMPARE: {
+                fread(&step->data.jump_compare, 6, 1, file);
+                fread(&step->data.jump_compare.literal, 4, 1, file);
+                int16_t offset;
+                fread(&offset, 2, 1, file);
+                step->data.jump_compare.offset = offset;
+                break;
+            }
+            case CUTSCENE_STEP_TYPE_JUMP_IF_NOT_EXPRESSION: {
+                expression_load(&step->data.jump_expression.expression, file);
+                int16_t offset;
+                fread(&offset, 2, 1, file);
+                step->data.jump_expression.offset = offset;
+                break;
+            }
         }
     }
 
@@ -98,11 +114,11 @@ struct cutscene* cutscene_load(char* filename) {
 }
 
 void cutscene_init(struct cutscene* cutscene, int capacity, int locals_size) {
-    cutscene->steps = malloc(sizeof(struct cutscene_step) * capacity);
+    cutscene->steps = tagged_malloc(MEMORY_TAG_CUTSCENE, sizeof(struct cutscene_step) * capacity);
     cutscene->step_count = capacity;
     cutscene->locals_size = locals_size;
     if (locals_size) {
-        cutscene->locals = malloc(locals_size);
+        cutscene->locals = tagged_malloc(MEMORY_TAG_CUTSCENE, locals_size);
     } else {
         cutscene->locals = NULL;
     }
@@ -119,17 +135,20 @@ void cutscene_destroy(struct cutscene* cutscene) {
             case CUTSCENE_STEP_TYPE_EXPRESSION:
                 expression_destroy(&step->data.expression.expression);
                 break;
+            case CUTSCENE_STEP_TYPE_JUMP_IF_NOT_EXPRESSION:
+                expression_destroy(&step->data.jump_expression.expression);
+                break;
             default:
                 break;
         }
     }
 
-    free(cutscene->steps);
-    free(cutscene->locals);
+    tagged_free(cutscene->steps);
+    tagged_free(cutscene->locals);
 }
 
 struct cutscene* cutscene_new(int capacity, int locals_capacity) {
-    struct cutscene* result = malloc(sizeof(struct cutscene));
+    struct cutscene* result = tagged_malloc(MEMORY_TAG_CUTSCENE, sizeof(struct cutscene));
     cutscene_init(result, capacity, locals_capacity);
     return result;
 }
@@ -139,7 +158,7 @@ void cutscene_free(struct cutscene* cutscene) {
         return;
     }
     cutscene_destroy(cutscene);
-    free(cutscene);
+    tagged_free(cutscene);
 }
 
 void cutscene_builder_init(struct cutscene_builder* builder) {
@@ -172,8 +191,8 @@ void cutscene_builder_pause(struct cutscene_builder* builder, bool should_pause,
 void cutscene_builder_dialog(struct cutscene_builder* builder, char* message) {
     struct cutscene_step* step = cutscene_builder_next_step(builder);
 
-    char* message_copy = malloc(strlen(message) + 1);
-    // free(message_copy) is done in cutscene_load_template_string
+    char* message_copy = tagged_malloc(MEMORY_TAG_CUTSCENE, strlen(message) + 1);
+    // tagged_free(message_copy) is done in cutscene_load_template_string
     strcpy(message_copy, message);
 
     *step = (struct cutscene_step){
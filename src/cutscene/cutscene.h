@@ -16,6 +16,18 @@ enum cutscene_step_type {
     CUTSCENE_STEP_TYPE_SET_LOCAL,
     CUTSCENE_STEP_TYPE_SET_GLOBAL,
     CUTSCENE_STEP_TYPE_DELAY,
+    // conditions the script compiler fused with the jump after them
+    CUTSCENE_STEP_TYPE_JUMP_IF_NOT_COMPARE,
+    CUTSCENE_STEP_TYPE_JUMP_IF_NOT_EXPRESSION,
+};
+
+enum cutscene_compare {
+    CUTSCENE_COMPARE_EQ,
+    CUTSCENE_COMPARE_NEQ,
+    CUTSCENE_COMPARE_GT,
+    CUTSCENE_COMPARE_GTE,
+    CUTSCENE_COMPARE_LT,
+    CUTSCENE_COMPARE_LTE,
 };
 
 struct cutscene_step;
@@ -62,6 +74,18 @@ union cutscene_step_data {
     struct {
         float duration;
     } delay;
+    struct {
+        uint16_t data_type;
+        uint16_t word_offset;
+        uint8_t is_global;
+        uint8_t compare;
+        int literal;
+        int offset;
+    } jump_compare;
+    struct {
+        struct expression expression;
+        int offset;
+    } jump_expression;
 };
 
 struct cutscene_step {
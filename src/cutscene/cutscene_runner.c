@@ -79,6 +79,8 @@ void cutscene_runner_init_step(struct cutscene_active_entry* cutscene, struct cu
             expression_evaluate(&cutscene->context, &step->data.expression.expression);
             break;
         case CUTSCENE_STEP_TYPE_JUMP_IF_NOT:
+        case CUTSCENE_STEP_TYPE_JUMP_IF_NOT_COMPARE:
+        case CUTSCENE_STEP_TYPE_JUMP_IF_NOT_EXPRESSION:
         case CUTSCENE_STEP_TYPE_JUMP:
             // logic is done in update step
             break;
@@ -111,6 +113,29 @@ void cutscene_runner_init_step(struct cutscene_active_entry* cutscene, struct cu
     }
 }
 
+static bool cutscene_runner_compare(struct cutscene_active_entry* cutscene, struct cutscene_step* step) {
+    void* data = step->data.jump_compare.is_global ? savefile_get_globals() : cutscene->context.local_varaibles;
+    int value = evaluation_context_load(data, step->data.jump_compare.data_type, step->data.jump_compare.word_offset);
+    int literal = step->data.jump_compare.literal;
+
+    switch (step->data.jump_compare.compare) {
+        case CUTSCENE_COMPARE_EQ:
+            return value == literal;
+        case CUTSCENE_COMPARE_NEQ:
+            return value != literal;
+        case CUTSCENE_COMPARE_GT:
+            return value > literal;
+        case CUTSCENE_COMPARE_GTE:
+            return value >= literal;
+        case CUTSCENE_COMPARE_LT:
+            return value < literal;
+        case CUTSCENE_COMPARE_LTE:
+            return value <= literal;
+        default:
+            return false;
+    }
+}
+
 bool cutscene_runner_update_step(struct cutscene_active_entry* cutscene, struct cutscene_step* step) {
     switch (step->type)
     {
@@ -134,6 +159,18 @@ bool cutscene_runner_update_step(struct cutscene_active_entry* cutscene, struct
         case CUTSCENE_STEP_TYPE_JUMP:
             cutscene->current_instruction += step->data.jump.offset;
             return true;
+        case CUTSCENE_STEP_TYPE_JUMP_IF_NOT_COMPARE:
+            if (!cutscene_runner_compare(cutscene, step)) {
+                cutscene->current_instruction += step->data.jump_compare.offset;
+            }
+            return true;
+        case CUTSCENE_STEP_TYPE_JUMP_IF_NOT_EXPRESSION:
+            expression_evaluate(&cutscene->context, &step->data.jump_expression.expression);
+
+            if (!evaluation_context_pop(&cutscene->context)) {
+                cutscene->current_instruction += step->data.jump_expression.offset;
+            }
+            return true;
         case CUTSCENE_STEP_TYPE_DELAY:
             cutscene_runner.active_step_data.delay.time -= fixed_time_step;
             return cutscene_runner.active_step_data.delay.time <= 0.0f;
@@ -3,14 +3,16 @@
 #include <assert.h>
 #include <malloc.h>
 #include <memory.h>
+#include <stdint.h>
+#include "../util/memory_tag.h"
 
 void evaluation_context_init(struct evaluation_context* context, int locals_size) {
     context->current_stack = 0;
-    context->local_varaibles = locals_size ? malloc(locals_size) : NULL;
+    context->local_varaibles = locals_size ? tagged_malloc(MEMORY_TAG_CUTSCENE, locals_size) : NULL;
 }
 
 void evaluation_context_destroy(struct evaluation_context* context) {
-    free(context->local_varaibles);
+    tagged_free(context->local_varaibles);
 }
 
 void evaluation_context_push(struct evaluation_context* context, int value) {
@@ -48,7 +50,7 @@ int evaluation_context_load(void* data, enum data_type data_type, int word_offse
             return (mask & word) != 0;
         }
         case DATA_TYPE_ADDRESS:
-            return (int)((char*)data + word_offset);
+            return (int)(intptr_t)((char*)data + word_offset);
         default:
             return 0;
     }
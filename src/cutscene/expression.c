@@ -3,21 +3,180 @@
 #include <libdragon.h>
 #include <assert.h>
 #include <malloc.h>
+#include <string.h>
+#include "../util/memory_tag.h"
+#include "evaluation_context.h"
 
 // EXPR
 #define EXPECTED_HEADER 0x45585052
 
+static uint8_t expression_type_to_op[] = {
+    [EXPRESSION_TYPE_END] = EXPRESSION_OP_END,
+    [EXPRESSION_TYPE_LOAD_LOCAL] = EXPRESSION_OP_LITERAL,
+    [EXPRESSION_TYPE_LOAD_GLOBAL] = EXPRESSION_OP_LITERAL,
+    [EXPRESSION_TYPE_LOAD_LITERAL] = EXPRESSION_OP_LITERAL,
+
+    [EXPRESSION_TYPE_AND] = EXPRESSION_OP_AND,
+    [EXPRESSION_TYPE_OR] = EXPRESSION_OP_OR,
+    [EXPRESSION_TYPE_NOT] = EXPRESSION_OP_NOT,
+
+    [EXPRESSION_TYPE_EQ] = EXPRESSION_OP_EQ,
+    [EXPRESSION_TYPE_NEQ] = EXPRESSION_OP_NEQ,
+    [EXPRESSION_TYPE_GT] = EXPRESSION_OP_GT,
+    [EXPRESSION_TYPE_GTE] = EXPRESSION_OP_GTE,
+
+    [EXPRESSION_TYPE_ADD] = EXPRESSION_OP_ADD,
+    [EXPRESSION_TYPE_SUB] = EXPRESSION_OP_SUB,
+    [EXPRESSION_TYPE_MUL] = EXPRESSION_OP_MUL,
+    [EXPRESSION_TYPE_DIV] = EXPRESSION_OP_DIV,
+    [EXPRESSION_TYPE_NEGATE] = EXPRESSION_OP_NEGATE,
+
+    [EXPRESSION_TYPE_GTF] = EXPRESSION_OP_GTF,
+    [EXPRESSION_TYPE_GTEF] = EXPRESSION_OP_GTEF,
+
+    [EXPRESSION_TYPE_ADDF] = EXPRESSION_OP_ADDF,
+    [EXPRESSION_TYPE_SUBF] = EXPRESSION_OP_SUBF,
+    [EXPRESSION_TYPE_MULF] = EXPRESSION_OP_MULF,
+    [EXPRESSION_TYPE_DIVF] = EXPRESSION_OP_DIVF,
+    [EXPRESSION_TYPE_NEGATEF] = EXPRESSION_OP_NEGATEF,
+
+    [EXPRESSION_TYPE_ITOF] = EXPRESSION_OP_ITOF,
+    [EXPRESSION_TYPE_FTOI] = EXPRESSION_OP_FTOI,
+};
+
+// how much each instruction grows the stack by
+static int8_t expression_type_stack_change[] = {
+    [EXPRESSION_TYPE_END] = 0,
+    [EXPRESSION_TYPE_LOAD_LOCAL] = 1,
+    [EXPRESSION_TYPE_LOAD_GLOBAL] = 1,
+    [EXPRESSION_TYPE_LOAD_LITERAL] = 1,
+
+    [EXPRESSION_TYPE_AND] = -1,
+    [EXPRESSION_TYPE_OR] = -1,
+    [EXPRESSION_TYPE_NOT] = 0,
+
+    [EXPRESSION_TYPE_EQ] = -1,
+    [EXPRESSION_TYPE_NEQ] = -1,
+    [EXPRESSION_TYPE_GT] = -1,
+    [EXPRESSION_TYPE_GTE] = -1,
+
+    [EXPRESSION_TYPE_ADD] = -1,
+    [EXPRESSION_TYPE_SUB] = -1,
+    [EXPRESSION_TYPE_MUL] = -1,
+    [EXPRESSION_TYPE_DIV] = -1,
+    [EXPRESSION_TYPE_NEGATE] = 0,
+
+    [EXPRESSION_TYPE_GTF] = -1,
+    [EXPRESSION_TYPE_GTEF] = -1,
+
+    [EXPRESSION_TYPE_ADDF] = -1,
+    [EXPRESSION_TYPE_SUBF] = -1,
+    [EXPRESSION_TYPE_MULF] = -1,
+    [EXPRESSION_TYPE_DIVF] = -1,
+    [EXPRESSION_TYPE_NEGATEF] = 0,
+
+    [EXPRESSION_TYPE_ITOF] = 0,
+    [EXPRESSION_TYPE_FTOI] = 0,
+};
+
+static void expression_translate_load(struct expression_instruction* instruction, union expression_data* data) {
+    int word_offset = data->load_variable.word_offset;
+
+    switch (data->load_variable.data_type) {
+        case DATA_TYPE_S8:
+            instruction->op = EXPRESSION_OP_LOAD_S8;
+            break;
+        case DATA_TYPE_S16:
+            instruction->op = EXPRESSION_OP_LOAD_S16;
+            break;
+        case DATA_TYPE_S32:
+        case DATA_TYPE_F32:
+            instruction->op = EXPRESSION_OP_LOAD_S32;
+            break;
+        case DATA_TYPE_BOOL:
+            instruction->op = EXPRESSION_OP_LOAD_BOOL;
+            instruction->data.mask = (uint32_t)0x80000000 >> (word_offset & 0x1F);
+            word_offset >>= 5;
+            break;
+        case DATA_TYPE_ADDRESS:
+            instruction->op = EXPRESSION_OP_LOAD_ADDRESS;
+            break;
+        default:
+            // a variable without a type always reads as 0
+            instruction->op = EXPRESSION_OP_LITERAL;
+            instruction->data.literal = 0;
+            word_offset = 0;
+            break;
+    }
+
+    instruction->word_offset = word_offset;
+}
+
+int expression_translate(const void* program, struct expression_instruction* instructions) {
+    const uint8_t* current = program;
+    int count = 0;
+    int depth = 0;
+
+    while (true) {
+        int type = *current;
+        ++current;
+
+        assert(type < sizeof(expression_type_to_op) / sizeof(*expression_type_to_op));
+
+        depth += expression_type_stack_change[type];
+        assert(depth >= (type == EXPRESSION_TYPE_END ? 0 : 1) && depth <= EXPRESSION_MAX_DEPTH);
+
+        bool has_data = type == EXPRESSION_TYPE_LOAD_LOCAL || type == EXPRESSION_TYPE_LOAD_GLOBAL || type == EXPRESSION_TYPE_LOAD_LITERAL;
+        union expression_data data;
+
+        if (has_data) {
+            // this avoids alignment issues
+            memcpy(&data, current, sizeof(union expression_data));
+            current += sizeof(union expression_data);
+        }
+
+        if (instructions) {
+            struct expression_instruction* instruction = &instructions[count];
+            instruction->op = expression_type_to_op[type];
+            instruction->is_global = type == EXPRESSION_TYPE_LOAD_GLOBAL;
+            instruction->word_offset = 0;
+            instruction->data.literal = has_data ? data.literal : 0;
+
+            if (type == EXPRESSION_TYPE_LOAD_LOCAL || type == EXPRESSION_TYPE_LOAD_GLOBAL) {
+                expression_translate_load(instruction, &data);
+            } else if (type == EXPRESSION_TYPE_END) {
+                instruction->data.has_result = depth != 0;
+            }
+        }
+
+        count += 1;
+
+        if (type == EXPRESSION_TYPE_END) {
+            assert(depth <= 1);
+            return count;
+        }
+    }
+}
+
+void expression_init(struct expression* expression, const void* program) {
+    int count = expression_translate(program, NULL);
+    expression->instructions = tagged_malloc(MEMORY_TAG_CUTSCENE, sizeof(struct expression_instruction) * count);
+    expression_translate(program, expression->instructions);
+}
+
 void expression_load(struct expression* expression, FILE* file) {
     int header;
     fread(&header, 1, 4, file);
     assert(header == EXPECTED_HEADER);
     uint16_t byte_size;
     fread(&byte_size, 1, 2, file);
-    expression->expression_program = malloc(byte_size);
-    fread(expression->expression_program, 1, byte_size, file);
+    void* program = tagged_malloc(MEMORY_TAG_CUTSCENE, byte_size);
+    fread(program, 1, byte_size, file);
+    expression_init(expression, program);
+    tagged_free(program);
 }
 
 void expression_destroy(struct expression* expression) {
-    free(expression->expression_program);
-    expression->expression_program = NULL;
-}
\ No newline at end of file
+    tagged_free(expression->instructions);
+    expression->instructions = NULL;
+}
@@ -46,11 +46,75 @@ union expression_data {
     int literal;
 };
 
+// expression programs are translated into these when they are loaded
+// so evaluating never decodes a byte stream or checks a data type
+enum expression_op {
+    EXPRESSION_OP_END,
+    EXPRESSION_OP_LITERAL,
+    EXPRESSION_OP_LOAD_S8,
+    EXPRESSION_OP_LOAD_S16,
+    EXPRESSION_OP_LOAD_S32,
+    EXPRESSION_OP_LOAD_BOOL,
+    EXPRESSION_OP_LOAD_ADDRESS,
+
+    EXPRESSION_OP_AND,
+    EXPRESSION_OP_OR,
+    EXPRESSION_OP_NOT,
+
+    EXPRESSION_OP_EQ,
+    EXPRESSION_OP_NEQ,
+    EXPRESSION_OP_GT,
+    EXPRESSION_OP_GTE,
+
+    EXPRESSION_OP_ADD,
+    EXPRESSION_OP_SUB,
+    EXPRESSION_OP_MUL,
+    EXPRESSION_OP_DIV,
+    EXPRESSION_OP_NEGATE,
+
+    EXPRESSION_OP_GTF,
+    EXPRESSION_OP_GTEF,
+
+    EXPRESSION_OP_ADDF,
+    EXPRESSION_OP_SUBF,
+    EXPRESSION_OP_MULF,
+    EXPRESSION_OP_DIVF,
+    EXPRESSION_OP_NEGATEF,
+
+    EXPRESSION_OP_ITOF,
+    EXPRESSION_OP_FTOI,
+
+    EXPRESSION_OP_COUNT,
+};
+
+// the deepest an expression can push, checked when it is translated
+#define EXPRESSION_MAX_DEPTH    32
+
+struct expression_instruction {
+    uint8_t op;
+    uint8_t is_global;
+    // for bools this is the word holding the bit
+    uint16_t word_offset;
+    union {
+        int literal;
+        // the bit of a bool in its word
+        uint32_t mask;
+        // for EXPRESSION_OP_END, if the result is pushed
+        int has_result;
+    } data;
+};
+
 struct expression {
-    void* expression_program;
+    struct expression_instruction* instructions;
 };
 
 void expression_load(struct expression* expression, FILE* file);
+// translates program, the bytes are not needed after this returns
+void expression_init(struct expression* expression, const void* program);
 void expression_destroy(struct expression* expression);
 
+// writes the translated program into instructions and returns how
+// many there are, instructions can be null to size the array
+int expression_translate(const void* program, struct expression_instruction* instructions);
+
 #endif
\ No newline at end of file
@@ -2,109 +2,163 @@
 
 #include "../savefile/savefile.h"
 
+union expression_value {
+    int i;
+    float f;
+};
+
+static inline float expression_as_float(int value) {
+    union expression_value result;
+    result.i = value;
+    return result.f;
+}
+
+static inline int expression_from_float(float value) {
+    union expression_value result;
+    result.f = value;
+    return result.i;
+}
+
+// every instruction jumps straight to the next one instead of going
+// back through a switch and the value on top of the stack is kept in
+// a register
+#define EXPRESSION_DISPATCH()       goto *dispatch[current->op]
+#define EXPRESSION_NEXT()           do { ++current; EXPRESSION_DISPATCH(); } while (0)
+#define EXPRESSION_PUSH(value)      do { *stack_top++ = top; top = (value); } while (0)
+#define EXPRESSION_POP()            (*--stack_top)
+
+#define EXPRESSION_BINARY(operation) do { \
+        int b = EXPRESSION_POP(); \
+        top = (operation); \
+        EXPRESSION_NEXT(); \
+    } while (0)
+
+#define EXPRESSION_BINARY_FLOAT(operation) do { \
+        float a = expression_as_float(top); \
+        float b = expression_as_float(EXPRESSION_POP()); \
+        top = (operation); \
+        EXPRESSION_NEXT(); \
+    } while (0)
+
 void expression_evaluate(struct evaluation_context* context, struct expression* expression) {
-    uint8_t* current = expression->expression_program;
-
-    while (*current != EXPRESSION_TYPE_END) {
-        int instruction = *current;
-        ++current;
-
-        union expression_data data;
-
-        switch (instruction) {
-            case EXPRESSION_TYPE_LOAD_LOCAL:
-                // this avoids alignment issues
-                memcpy(&data, current, sizeof(union expression_data));
-                
-                evaluation_context_push(context, evaluation_context_load(context->local_varaibles, data.load_variable.data_type, data.load_variable.word_offset));
-                current += sizeof(union expression_data);
-                break;
-            case EXPRESSION_TYPE_LOAD_GLOBAL:
-                // this avoids alignment issues
-                memcpy(&data, current, sizeof(union expression_data));
-
-                evaluation_context_push(context, evaluation_context_load(savefile_get_globals(), data.load_variable.data_type, data.load_variable.word_offset));
-                current += sizeof(union expression_data);
-                break;
-            case EXPRESSION_TYPE_LOAD_LITERAL:
-                // this avoids alignment issues
-                memcpy(&data, current, sizeof(union expression_data));
-
-                evaluation_context_push(context, data.literal);
-                current += sizeof(union expression_data);
-                break;
-            case EXPRESSION_TYPE_AND: {
-                int a = evaluation_context_pop(context);
-                int b = evaluation_context_pop(context);
-                evaluation_context_push(context, a && b);
-                break;
-            }
-            case EXPRESSION_TYPE_OR: {
-                int a = evaluation_context_pop(context);
-                int b = evaluation_context_pop(context);
-                evaluation_context_push(context, a || b);
-                break;
-            }
-            case EXPRESSION_TYPE_NOT:
-                evaluation_context_push(
-                    context,
-                    !evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_EQ:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) == evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_NEQ:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) != evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_GT:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) > evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_GTE:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) >= evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_ADD:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) + evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_SUB:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) - evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_MUL:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) * evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_DIV:
-                evaluation_context_push(
-                    context,
-                    evaluation_context_pop(context) / evaluation_context_pop(context)
-                );
-                break;
-            case EXPRESSION_TYPE_NEGATE:
-                evaluation_context_push(
-                    context,
-                    -evaluation_context_pop(context)
-                );
-                break;
-        }
+    static const void* dispatch[EXPRESSION_OP_COUNT] = {
+        [EXPRESSION_OP_END] = &&op_end,
+        [EXPRESSION_OP_LITERAL] = &&op_literal,
+        [EXPRESSION_OP_LOAD_S8] = &&op_load_s8,
+        [EXPRESSION_OP_LOAD_S16] = &&op_load_s16,
+        [EXPRESSION_OP_LOAD_S32] = &&op_load_s32,
+        [EXPRESSION_OP_LOAD_BOOL] = &&op_load_bool,
+        [EXPRESSION_OP_LOAD_ADDRESS] = &&op_load_address,
+        [EXPRESSION_OP_AND] = &&op_and,
+        [EXPRESSION_OP_OR] = &&op_or,
+        [EXPRESSION_OP_NOT] = &&op_not,
+        [EXPRESSION_OP_EQ] = &&op_eq,
+        [EXPRESSION_OP_NEQ] = &&op_neq,
+        [EXPRESSION_OP_GT] = &&op_gt,
+        [EXPRESSION_OP_GTE] = &&op_gte,
+        [EXPRESSION_OP_ADD] = &&op_add,
+        [EXPRESSION_OP_SUB] = &&op_sub,
+        [EXPRESSION_OP_MUL] = &&op_mul,
+        [EXPRESSION_OP_DIV] = &&op_div,
+        [EXPRESSION_OP_NEGATE] = &&op_negate,
+        [EXPRESSION_OP_GTF] = &&op_gtf,
+        [EXPRESSION_OP_GTEF] = &&op_gtef,
+        [EXPRESSION_OP_ADDF] = &&op_addf,
+        [EXPRESSION_OP_SUBF] = &&op_subf,
+        [EXPRESSION_OP_MULF] = &&op_mulf,
+        [EXPRESSION_OP_DIVF] = &&op_divf,
+        [EXPRESSION_OP_NEGATEF] = &&op_negatef,
+        [EXPRESSION_OP_ITOF] = &&op_itof,
+        [EXPRESSION_OP_FTOI] = &&op_ftoi,
+    };
+
+    // translating checked that a program never pops more than it
+    // pushed so it can run on its own stack and only the result ends
+    // up in the context
+    int stack[EXPRESSION_MAX_DEPTH];
+    int* stack_top = stack;
+    int top = 0;
+
+    char* bases[2] = {context->local_varaibles, savefile_get_globals()};
+    struct expression_instruction* current = expression->instructions;
+
+    EXPRESSION_DISPATCH();
+
+op_end:
+    if (current->data.has_result) {
+        evaluation_context_push(context, top);
     }
+    return;
+
+op_literal:
+    EXPRESSION_PUSH(current->data.literal);
+    EXPRESSION_NEXT();
+op_load_s8:
+    EXPRESSION_PUSH(((int8_t*)bases[current->is_global])[current->word_offset]);
+    EXPRESSION_NEXT();
+op_load_s16:
+    EXPRESSION_PUSH(((int16_t*)bases[current->is_global])[current->word_offset]);
+    EXPRESSION_NEXT();
+op_load_s32:
+    EXPRESSION_PUSH(((int32_t*)bases[current->is_global])[current->word_offset]);
+    EXPRESSION_NEXT();
+op_load_bool:
+    EXPRESSION_PUSH((((uint32_t*)bases[current->is_global])[current->word_offset] & current->data.mask) != 0);
+    EXPRESSION_NEXT();
+op_load_address:
+    EXPRESSION_PUSH((int)(intptr_t)(bases[current->is_global] + current->word_offset));
+    EXPRESSION_NEXT();
+
+op_and:
+    EXPRESSION_BINARY(top && b);
+op_or:
+    EXPRESSION_BINARY(top || b);
+op_not:
+    top = !top;
+    EXPRESSION_NEXT();
+
+op_eq:
+    EXPRESSION_BINARY(top == b);
+op_neq:
+    EXPRESSION_BINARY(top != b);
+op_gt:
+    EXPRESSION_BINARY(top > b);
+op_gte:
+    EXPRESSION_BINARY(top >= b);
+
+op_add:
+    EXPRESSION_BINARY(top + b);
+op_sub:
+    EXPRESSION_BINARY(top - b);
+op_mul:
+    EXPRESSION_BINARY(top * b);
+op_div:
+    EXPRESSION_BINARY(top / b);
+op_negate:
+    top = -top;
+    EXPRESSION_NEXT();
+
+op_gtf:
+    EXPRESSION_BINARY_FLOAT(a > b);
+op_gtef:
+    EXPRESSION_BINARY_FLOAT(a >= b);
+
+op_addf:
+    EXPRESSION_BINARY_FLOAT(expression_from_float(a + b));
+op_subf:
+    EXPRESSION_BINARY_FLOAT(expression_from_float(a - b));
+op_mulf:
+    EXPRESSION_BINARY_FLOAT(expression_from_float(a * b));
+op_divf:
+    EXPRESSION_BINARY_FLOAT(expression_from_float(a / b));
+op_negatef:
+    top = expression_from_float(-expression_as_float(top));
+    EXPRESSION_NEXT();
+
+op_itof:
+    top = expression_from_float((float)top);
+    EXPRESSION_NEXT();
+op_ftoi:
+    top = (int)expression_as_float(top);
+    EXPRESSION_NEXT();
 }
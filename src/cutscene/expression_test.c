@@ -0,0 +1,137 @@
+#include "expression_evaluate.h"
+#include "../test/framework_test.h"
+
+#include <string.h>
+
+struct expression_test_writer {
+    uint8_t bytes[64];
+    int length;
+};
+
+static void expression_test_op(struct expression_test_writer* writer, int type) {
+    writer->bytes[writer->length] = type;
+    writer->length += 1;
+}
+
+static void expression_test_data(struct expression_test_writer* writer, int type, union expression_data data) {
+    expression_test_op(writer, type);
+    memcpy(&writer->bytes[writer->length], &data, sizeof(data));
+    writer->length += sizeof(data);
+}
+
+static void expression_test_literal(struct expression_test_writer* writer, int value) {
+    expression_test_data(writer, EXPRESSION_TYPE_LOAD_LITERAL, (union expression_data){ .literal = value });
+}
+
+static void expression_test_literalf(struct expression_test_writer* writer, float value) {
+    union expression_data data;
+    memcpy(&data.literal, &value, sizeof(float));
+    expression_test_data(writer, EXPRESSION_TYPE_LOAD_LITERAL, data);
+}
+
+static void expression_test_local(struct expression_test_writer* writer, int data_type, int word_offset) {
+    union expression_data data;
+    data.load_variable.data_type = data_type;
+    data.load_variable.word_offset = word_offset;
+    expression_test_data(writer, EXPRESSION_TYPE_LOAD_LOCAL, data);
+}
+
+static int expression_test_run(struct evaluation_context* context, struct expression_test_writer* writer) {
+    expression_test_op(writer, EXPRESSION_TYPE_END);
+
+    struct expression expression;
+    expression_init(&expression, writer->bytes);
+    expression_evaluate(context, &expression);
+    expression_destroy(&expression);
+
+    writer->length = 0;
+    return evaluation_context_pop(context);
+}
+
+static float expression_test_runf(struct evaluation_context* context, struct expression_test_writer* writer) {
+    int result = expression_test_run(context, writer);
+    float as_float;
+    memcpy(&as_float, &result, sizeof(float));
+    return as_float;
+}
+
+void test_expression_evaluate(struct test_context* t) {
+    struct evaluation_context context;
+    evaluation_context_init(&context, 16);
+    memset(context.local_varaibles, 0, 16);
+
+    struct expression_test_writer writer;
+    writer.length = 0;
+
+    // the left operand is pushed last so 7 - 2
+    expression_test_literal(&writer, 2);
+    expression_test_literal(&writer, 7);
+    expression_test_op(&writer, EXPRESSION_TYPE_SUB);
+    test_eqi(t, 5, expression_test_run(&context, &writer));
+
+    // (3 + 4) * 2 > 13
+    expression_test_literal(&writer, 13);
+    expression_test_literal(&writer, 2);
+    expression_test_literal(&writer, 4);
+    expression_test_literal(&writer, 3);
+    expression_test_op(&writer, EXPRESSION_TYPE_ADD);
+    expression_test_op(&writer, EXPRESSION_TYPE_MUL);
+    expression_test_op(&writer, EXPRESSION_TYPE_GT);
+    test_eqi(t, 1, expression_test_run(&context, &writer));
+
+    expression_test_literal(&writer, 0);
+    expression_test_op(&writer, EXPRESSION_TYPE_NOT);
+    expression_test_literal(&writer, 1);
+    expression_test_op(&writer, EXPRESSION_TYPE_AND);
+    test_eqi(t, 1, expression_test_run(&context, &writer));
+
+    int32_t* words = context.local_varaibles;
+    words[0] = 0x40000000;
+    ((int16_t*)context.local_varaibles)[2] = -12;
+    words[2] = 1000;
+
+    expression_test_local(&writer, DATA_TYPE_BOOL, 1);
+    test_eqi(t, 1, expression_test_run(&context, &writer));
+    expression_test_local(&writer, DATA_TYPE_BOOL, 2);
+    test_eqi(t, 0, expression_test_run(&context, &writer));
+    expression_test_local(&writer, DATA_TYPE_S16, 2);
+    test_eqi(t, -12, expression_test_run(&context, &writer));
+    expression_test_local(&writer, DATA_TYPE_S32, 2);
+    expression_test_op(&writer, EXPRESSION_TYPE_NEGATE);
+    test_eqi(t, -1000, expression_test_run(&context, &writer));
+
+    // 1.5 * 3 - 0.25
+    expression_test_literalf(&writer, 0.25f);
+    expression_test_literal(&writer, 3);
+    expression_test_op(&writer, EXPRESSION_TYPE_ITOF);
+    expression_test_literalf(&writer, 1.5f);
+    expression_test_op(&writer, EXPRESSION_TYPE_MULF);
+    expression_test_op(&writer, EXPRESSION_TYPE_SUBF);
+    test_near_equalf(t, 4.25f, expression_test_runf(&context, &writer));
+
+    expression_test_literalf(&writer, 2.0f);
+    expression_test_literalf(&writer, 9.0f);
+    expression_test_op(&writer, EXPRESSION_TYPE_DIVF);
+    expression_test_op(&writer, EXPRESSION_TYPE_NEGATEF);
+    expression_test_op(&writer, EXPRESSION_TYPE_FTOI);
+    test_eqi(t, -4, expression_test_run(&context, &writer));
+
+    expression_test_literalf(&writer, 2.0f);
+    expression_test_literalf(&writer, 2.0f);
+    expression_test_op(&writer, EXPRESSION_TYPE_GTEF);
+    test_eqi(t, 1, expression_test_run(&context, &writer));
+
+    expression_test_literalf(&writer, 2.0f);
+    expression_test_literalf(&writer, 2.0f);
+    expression_test_op(&writer, EXPRESSION_TYPE_GTF);
+    test_eqi(t, 0, expression_test_run(&context, &writer));
+
+    // whatever is already on the stack is left alone
+    evaluation_context_push(&context, 42);
+    expression_test_literal(&writer, 1);
+    test_eqi(t, 1, expression_test_run(&context, &writer));
+    test_eqi(t, 1, context.current_stack);
+    test_eqi(t, 42, evaluation_context_pop(&context));
+
+    evaluation_context_destroy(&context);
+}
@@ -4,22 +4,24 @@
 #include "../menu/menu_common.h"
 #include "../math/mathf.h"
 #include "../resource/material_cache.h"
+#include "../input/input.h"
+#include "../resource/asset_ids.h"
 
 #define RUNE_SHOW_TIME              3.0f
 #define RUNE_FADE_TIME              0.25f
 #define RUNE_FLASH_TIME             2.0f
 
-static const char* item_icon_materials[] = {
-    [SPELL_SYMBOL_FIRE] = "rom:/materials/spell/symbols.mat",
-    [SPELL_SYMBOL_ICE] = "rom:/materials/spell/symbols.mat",
-    [SPELL_SYMBOL_EARTH] = "rom:/materials/spell/symbols.mat",
-    [SPELL_SYMBOL_AIR] = "rom:/materials/spell/symbols.mat",
-    [SPELL_SYMBOL_LIFE] = "rom:/materials/spell/symbols.mat",
+static const asset_id item_icon_materials[] = {
+    [SPELL_SYMBOL_FIRE] = ASSET_ID_MATERIALS_SPELL_SYMBOLS_MAT,
+    [SPELL_SYMBOL_ICE] = ASSET_ID_MATERIALS_SPELL_SYMBOLS_MAT,
+    [SPELL_SYMBOL_EARTH] = ASSET_ID_MATERIALS_SPELL_SYMBOLS_MAT,
+    [SPELL_SYMBOL_AIR] = ASSET_ID_MATERIALS_SPELL_SYMBOLS_MAT,
+    [SPELL_SYMBOL_LIFE] = ASSET_ID_MATERIALS_SPELL_SYMBOLS_MAT,
 
-    [SPELL_SYMBOL_RECAST] = "rom:/materials/spell/symbols.mat",
+    [SPELL_SYMBOL_RECAST] = ASSET_ID_MATERIALS_SPELL_SYMBOLS_MAT,
     // SPELL_SYMBOL_PASS_DOWN,
 
-    [ITEM_TYPE_STAFF_DEFAULT] = "rom:/materials/objects/icons/default_staff_icon.mat",
+    [ITEM_TYPE_STAFF_DEFAULT] = ASSET_ID_MATERIALS_OBJECTS_ICONS_DEFAULT_STAFF_ICON_MAT,
 };
 
 static char* item_get_message[] = {
@@ -67,7 +69,7 @@ void show_item_start(struct show_item* show_item, union cutscene_step_data* data
     if (data->show_item.should_show) {
         show_item->showing_item = data->show_item.item;
         show_item->show_item_timer = 0.0f;
-        show_item->item_material = material_cache_load(item_icon_materials[show_item->showing_item]);
+        show_item->item_material = material_cache_load_id(item_icon_materials[show_item->showing_item]);
     } else {
         show_item->show_item_timer = RUNE_FADE_TIME;
     }
@@ -77,7 +79,7 @@ bool show_item_update(struct show_item* show_item, union cutscene_step_data* dat
     float target = data->show_item.should_show ? RUNE_SHOW_TIME : 0.0f;
     show_item->show_item_timer = mathfMoveTowards(show_item->show_item_timer, target, fixed_time_step);
 
-    joypad_buttons_t buttons = joypad_get_buttons_pressed(0);
+    joypad_buttons_t buttons = input_get_buttons_pressed();
 
     if (buttons.start) {
         show_item->show_item_timer = target;
@@ -12,7 +12,7 @@ void burning_effect_update(void* data) {
     struct burning_effect* effect = (struct burning_effect*)data;
 
     if (effect->current_size == 0.0f && effect->current_time <= 0.0f && effect->size == 0.0f) {
-        update_remove(effect);
+        update_remove(effect->update_id);
         render_scene_remove(effect);
         effect_free(effect);
         return;
@@ -58,7 +58,7 @@ struct burning_effect* burning_effect_new(struct Vector3* position, float size,
     result->current_time = duration;
     result->current_size = 0.0f;
 
-    update_add(result, burning_effect_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD);
+    result->update_id = update_add(result, burning_effect_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD);
 
     return result;
 }
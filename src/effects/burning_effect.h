@@ -3,12 +3,14 @@
 
 #include "../math/vector3.h"
 #include <stdbool.h>
+#include "../time/time.h"
 
 struct burning_effect {
     struct Vector3 position;
     float size;
     float current_size;
     float current_time;
+    update_id update_id;
 };
 
 struct burning_effect* burning_effect_new(struct Vector3* position, float size, float duration);
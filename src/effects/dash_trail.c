@@ -103,7 +103,7 @@ void dash_trail_update(void* data) {
     struct dash_trail* trail = (struct dash_trail*)data;
 
     if (trail->vertex_count == 0 && !trail->active) {
-        update_remove(trail);
+        update_remove(trail->update_id);
         render_scene_remove(trail);
         effect_free(trail);
         return;
@@ -157,7 +157,7 @@ struct dash_trail* dash_trail_new(struct Vector3* emit_from, bool flipped) {
     trail->active = 1;
 
     render_scene_add(&trail->last_position, 4.0f, dash_trail_render, trail);
-    update_add(trail, dash_trail_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD);
+    trail->update_id = update_add(trail, dash_trail_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD);
 
     dash_trail_move(trail, emit_from);
 
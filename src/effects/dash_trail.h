@@ -4,6 +4,7 @@
 #include "../math/vector3.h"
 #include "../render/render_batch.h"
 #include <t3d/t3d.h>
+#include "../time/time.h"
 
 #define DASH_PARTICLE_COUNT 16
 
@@ -20,6 +21,7 @@ struct dash_trail {
 
     uint16_t first_vertex;
     uint16_t vertex_count;
+    update_id update_id;
 };
 
 struct dash_trail* dash_trail_new(struct Vector3* emit_from, bool flipped);
@@ -1,23 +1,129 @@
 #include "effect_allocator.h"
 
 #include "../util/ring_allocator.h"
+#include "../util/slab_allocator.h"
+#include "burning_effect.h"
+#include "dash_trail.h"
 #include <stdint.h>
+#include <stdio.h>
 #include <assert.h>
 
 #define EFFECT_MEMORY_SIZE  0x8000
 
+struct effect_size_class {
+    uint16_t block_size;
+    uint16_t block_count;
+};
+
+// a class per effect that uses effect_malloc, ordered smallest first
+static struct effect_size_class g_effect_size_classes[] = {
+    {sizeof(struct burning_effect), 64},
+    {sizeof(struct dash_trail), 16},
+};
+
+#define EFFECT_SIZE_CLASS_COUNT (sizeof(g_effect_size_classes) / sizeof(*g_effect_size_classes))
+
 static uint64_t g_effect_buffer[EFFECT_MEMORY_SIZE / sizeof(uint64_t)];
+static struct slab_allocator g_effect_slabs[EFFECT_SIZE_CLASS_COUNT];
 static struct ring_allocator g_effect_allocator;
 
+static uint16_t g_effect_fallback_count;
+static uint16_t g_effect_fallback_failures;
+
+static void effect_allocator_init() {
+    char* memory = (char*)g_effect_buffer;
+
+    for (int i = 0; i < EFFECT_SIZE_CLASS_COUNT; i += 1) {
+        struct effect_size_class* size_class = &g_effect_size_classes[i];
+        assert(i == 0 || size_class->block_size >= g_effect_size_classes[i - 1].block_size);
+        slab_init_with_buffer(&g_effect_slabs[i], memory, size_class->block_size, size_class->block_count);
+        // the slab rounds the block size up to keep blocks aligned
+        memory += g_effect_slabs[i].block_size * size_class->block_count;
+    }
+
+    // whatever is left over handles sizes that don't fit a class
+    int remaining = (char*)g_effect_buffer + EFFECT_MEMORY_SIZE - memory;
+    assert(remaining > 0);
+    ring_init_with_buffer(&g_effect_allocator, memory, remaining);
+}
+
 void* effect_malloc(int bytes) {
     if (!g_effect_allocator.buffer) {
-        ring_init_with_buffer(&g_effect_allocator, &g_effect_buffer, EFFECT_MEMORY_SIZE);
+        effect_allocator_init();
+    }
+
+    for (int i = 0; i < EFFECT_SIZE_CLASS_COUNT; i += 1) {
+        struct slab_allocator* slab = &g_effect_slabs[i];
+
+        if (bytes > slab->block_size) {
+            continue;
+        }
+
+        void* result = slab_malloc(slab);
+
+        if (result) {
+            return result;
+        }
+
+        // a full class spills into the ring allocator
+        break;
+    }
+
+    void* result = ring_malloc(&g_effect_allocator, bytes);
+
+    if (result) {
+        g_effect_fallback_count += 1;
+    } else {
+        g_effect_fallback_failures += 1;
     }
 
-    return ring_malloc(&g_effect_allocator, bytes);
+    return result;
 }
 
 void effect_free(void* memory) {
     assert(g_effect_allocator.buffer);
+
+    if (!memory) {
+        return;
+    }
+
+    for (int i = 0; i < EFFECT_SIZE_CLASS_COUNT; i += 1) {
+        if (slab_contains(&g_effect_slabs[i], memory)) {
+            slab_free(&g_effect_slabs[i], memory);
+            return;
+        }
+    }
+
     ring_free(&g_effect_allocator, memory);
-}
\ No newline at end of file
+}
+
+#ifdef MEMORY_PROFILE
+void effect_allocator_report() {
+    if (!g_effect_allocator.buffer) {
+        return;
+    }
+
+    fprintf(stderr, "effect_allocator:\n");
+
+    for (int i = 0; i < EFFECT_SIZE_CLASS_COUNT; i += 1) {
+        struct slab_allocator* slab = &g_effect_slabs[i];
+        fprintf(
+            stderr,
+            "    %4d bytes %3d/%3d used %3d peak %d failed\n",
+            slab->block_size,
+            slab->used_count,
+            slab->block_count,
+            slab->peak_count,
+            slab->failure_count
+        );
+    }
+
+    fprintf(
+        stderr,
+        "    fallback %d allocations %d failed %d bytes free\n",
+        g_effect_fallback_count,
+        g_effect_fallback_failures,
+        ring_get_free_memory(&g_effect_allocator)
+    );
+}
+#endif
@@ -4,4 +4,8 @@
 void* effect_malloc(int bytes);
 void effect_free(void* memory);
 
-#endif
\ No newline at end of file
+#ifdef MEMORY_PROFILE
+void effect_allocator_report();
+#endif
+
+#endif
@@ -2,8 +2,10 @@
 
 #include "../render/render_scene.h"
 #include "../time/time.h"
+#include "../time/background.h"
 #include "../collision/collision_scene.h"
 #include "../resource/animation_cache.h"
+#include "../resource/asset_ids.h"
 
 #define VISION_DISTANCE     4.0f
 #define ATTACK_RANGE        1.0f
@@ -109,7 +111,8 @@ void biter_update(struct biter* biter) {
     biter_update_target(biter);
 
     if (biter->health.current_health <= 0.0f) {
-        biter_destroy(biter);
+        // the destroy is done in idle time after the update
+        background_defer(biter, (background_deferred_callback)biter_destroy);
     }
 }
 
@@ -119,7 +122,7 @@ void biter_init(struct biter* biter, struct biter_definition* definition) {
 
     entity_id id = entity_id_new();
 
-    renderable_single_axis_init(&biter->renderable, &biter->transform, "rom:/meshes/enemies/enemy1.tmesh");
+    renderable_single_axis_init(&biter->renderable, &biter->transform, ASSET_ID_MESHES_ENEMIES_ENEMY1_TMESH);
     dynamic_object_init(
         id, 
         &biter->dynamic_object, 
@@ -145,17 +148,18 @@ void biter_init(struct biter* biter, struct biter_definition* definition) {
     collision_scene_add(&biter->dynamic_object);
     collision_scene_add(&biter->vision);
 
-    update_add(biter, (update_callback)biter_update, UPDATE_PRIORITY_SPELLS, UPDATE_LAYER_WORLD);
+    biter->update_id = update_add(biter, (update_callback)biter_update, UPDATE_PRIORITY_SPELLS, UPDATE_LAYER_WORLD);
 
     render_scene_add_renderable_single_axis(&biter->renderable, 1.73f);
 
     health_init(&biter->health, id, 10.0f);
 
-    biter->animation_set = animation_cache_load("rom:/meshes/enemies/enemy1.anim");
+    biter->animation_set = animation_cache_load_id(ASSET_ID_MESHES_ENEMIES_ENEMY1_ANIM);
     biter->animations.attack = animation_set_find_clip(biter->animation_set, "enemy1_attack");
     biter->animations.idle = animation_set_find_clip(biter->animation_set, "enemy1_idle");
     biter->animations.run = animation_set_find_clip(biter->animation_set, "enemy1_walk");
     biter->current_target = 0;
+    biter->destroyed = false;
 
     animator_init(&biter->animator, biter->renderable.armature.bone_count);
 
@@ -165,12 +169,17 @@ void biter_init(struct biter* biter, struct biter_definition* definition) {
 }
 
 void biter_destroy(struct biter* biter) {
+    if (biter->destroyed) {
+        return;
+    }
+
+    biter->destroyed = true;
     render_scene_remove(&biter->renderable);
     renderable_single_axis_destroy(&biter->renderable);
     collision_scene_remove(&biter->dynamic_object);
     collision_scene_remove(&biter->vision);
     health_destroy(&biter->health);
-    update_remove(biter);
+    update_remove(biter->update_id);
     animator_destroy(&biter->animator);
     animation_cache_release(biter->animation_set);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "../math/transform_single_axis.h"
 #include "../entity/health.h"
 #include "../render/animator.h"
+#include "../time/time.h"
 
 struct biter_animations {
     struct animation_clip* idle;
@@ -27,6 +28,12 @@ struct biter {
     struct animator animator;
 
     entity_id current_target;
+
+    // a biter destroys itself when it dies, the world still
+    // calls biter_destroy on it when the world is released
+    bool destroyed;
+
+    update_id update_id;
 };
 
 void biter_init(struct biter* biter, struct biter_definition* definition);
@@ -0,0 +1,96 @@
+#include "component_set.h"
+
+#include <string.h>
+#include <assert.h>
+#include "../util/memory_tag.h"
+
+void component_set_init(struct component_set* set, int capacity) {
+    memset(set->pages, 0, sizeof(set->pages));
+    memset(set->page_counts, 0, sizeof(set->page_counts));
+    set->components = tagged_malloc(MEMORY_TAG_COMPONENTS, sizeof(void*) * capacity);
+    set->entity_ids = tagged_malloc(MEMORY_TAG_COMPONENTS, sizeof(entity_id) * capacity);
+    set->count = 0;
+    set->capacity = capacity;
+}
+
+void component_set_destroy(struct component_set* set) {
+    for (int i = 0; i < COMPONENT_SET_PAGE_COUNT; i += 1) {
+        // tagged_malloc() for pages is done in component_set_add
+        tagged_free(set->pages[i]);
+        set->pages[i] = NULL;
+    }
+
+    tagged_free(set->components);
+    tagged_free(set->entity_ids);
+    set->components = NULL;
+    set->entity_ids = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+static uint16_t* component_set_slot(struct component_set* set, entity_id id) {
+    return &set->pages[id >> COMPONENT_SET_PAGE_BITS][id & (COMPONENT_SET_PAGE_SIZE - 1)];
+}
+
+void component_set_add(struct component_set* set, entity_id id, void* component) {
+    int page_index = id >> COMPONENT_SET_PAGE_BITS;
+
+    if (!set->pages[page_index]) {
+        set->pages[page_index] = tagged_malloc(MEMORY_TAG_COMPONENTS, sizeof(uint16_t) * COMPONENT_SET_PAGE_SIZE);
+        memset(set->pages[page_index], 0, sizeof(uint16_t) * COMPONENT_SET_PAGE_SIZE);
+    }
+
+    uint16_t* slot = component_set_slot(set, id);
+
+    if (*slot) {
+        set->components[*slot - 1] = component;
+        return;
+    }
+
+    if (set->count == set->capacity) {
+        set->capacity = set->capacity ? set->capacity * 2 : 8;
+        set->components = tagged_realloc(MEMORY_TAG_COMPONENTS, set->components, sizeof(void*) * set->capacity);
+        set->entity_ids = tagged_realloc(MEMORY_TAG_COMPONENTS, set->entity_ids, sizeof(entity_id) * set->capacity);
+    }
+
+    set->components[set->count] = component;
+    set->entity_ids[set->count] = id;
+    set->count += 1;
+    set->page_counts[page_index] += 1;
+    *slot = set->count;
+}
+
+void component_set_remove(struct component_set* set, entity_id id) {
+    int page_index = id >> COMPONENT_SET_PAGE_BITS;
+
+    if (!set->pages[page_index]) {
+        return;
+    }
+
+    uint16_t* slot = component_set_slot(set, id);
+
+    if (!*slot) {
+        return;
+    }
+
+    // move the last component into the hole to keep the array dense
+    int index = *slot - 1;
+    int last = set->count - 1;
+
+    if (index != last) {
+        set->components[index] = set->components[last];
+        set->entity_ids[index] = set->entity_ids[last];
+        *component_set_slot(set, set->entity_ids[index]) = index + 1;
+    }
+
+    *slot = 0;
+    set->count -= 1;
+    set->page_counts[page_index] -= 1;
+
+    // ids are handed out in order so a page tends to empty out once
+    // its entities are gone, it is allocated again if the ids wrap
+    if (set->page_counts[page_index] == 0) {
+        tagged_free(set->pages[page_index]);
+        set->pages[page_index] = NULL;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef __ENTITY_COMPONENT_SET_H__
+#define __ENTITY_COMPONENT_SET_H__
+
+#include "entity_id.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define COMPONENT_SET_PAGE_BITS     8
+#define COMPONENT_SET_PAGE_SIZE     (1 << COMPONENT_SET_PAGE_BITS)
+#define COMPONENT_SET_PAGE_COUNT    (0x10000 >> COMPONENT_SET_PAGE_BITS)
+
+// sparse set keyed by entity_id, components are packed
+// into a dense array so systems can loop over all of them
+// and a lookup is two array reads
+struct component_set {
+    // dense index + 1 for each entity id, 0 means not present
+    // pages are only allocated for id ranges that are in use
+    uint16_t* pages[COMPONENT_SET_PAGE_COUNT];
+    uint16_t page_counts[COMPONENT_SET_PAGE_COUNT];
+    void** components;
+    entity_id* entity_ids;
+    uint16_t count;
+    uint16_t capacity;
+};
+
+void component_set_init(struct component_set* set, int capacity);
+void component_set_destroy(struct component_set* set);
+
+void component_set_add(struct component_set* set, entity_id id, void* component);
+void component_set_remove(struct component_set* set, entity_id id);
+
+static inline void* component_set_get(struct component_set* set, entity_id id) {
+    uint16_t* page = set->pages[id >> COMPONENT_SET_PAGE_BITS];
+
+    if (!page) {
+        return NULL;
+    }
+
+    uint16_t index = page[id & (COMPONENT_SET_PAGE_SIZE - 1)];
+    return index ? set->components[index - 1] : NULL;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#include "component_set.h"
+#include "../test/framework_test.h"
+
+#include <stddef.h>
+
+void test_component_set(struct test_context* t) {
+    struct component_set set = {0};
+    component_set_init(&set, 2);
+
+    int components[4];
+
+    component_set_add(&set, 1, &components[0]);
+    component_set_add(&set, 300, &components[1]);
+    component_set_add(&set, 2, &components[2]);
+    test_eqi(t, 3, set.count);
+    test_eqp(t, &components[1], component_set_get(&set, 300));
+    test_eqp(t, NULL, component_set_get(&set, 3));
+    test_eqp(t, NULL, component_set_get(&set, 600));
+
+    // removing swaps the last component into the hole
+    component_set_remove(&set, 1);
+    test_eqi(t, 2, set.count);
+    test_eqp(t, &components[2], set.components[0]);
+    test_eqp(t, &components[2], component_set_get(&set, 2));
+    test_eqp(t, NULL, component_set_get(&set, 1));
+
+    // empty pages are released
+    component_set_remove(&set, 300);
+    test_eqp(t, NULL, set.pages[300 >> COMPONENT_SET_PAGE_BITS]);
+    test_eqp(t, NULL, component_set_get(&set, 300));
+
+    component_set_add(&set, 2, &components[3]);
+    test_eqi(t, 1, set.count);
+    test_eqp(t, &components[3], component_set_get(&set, 2));
+
+    component_set_destroy(&set);
+}
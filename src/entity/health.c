@@ -1,36 +1,44 @@
 #include "health.h"
 
-#include "../util/hash_map.h"
+#include "component_set.h"
 #include "../time/time.h"
 #include <stddef.h>
 
-static struct hash_map health_entity_mapping;
+static struct component_set health_components;
 
-void health_reset() {
-    hash_map_destroy(&health_entity_mapping);
-    hash_map_init(&health_entity_mapping, 32);
-}
+void health_update(void *data, float delta) {
+    struct health** healths = (struct health**)health_components.components;
 
-void health_update(void *data) {
-    struct health* health = (struct health*)data;
+    for (int i = 0; i < health_components.count; i += 1) {
+        struct health* health = healths[i];
 
-    if (health->frozen_timer) {
-        health->frozen_timer -= fixed_time_step;
+        if (health->frozen_timer) {
+            health->frozen_timer -= delta;
 
-        if (health->frozen_timer < 0.0f) {
-            health->frozen_timer = 0.0f;
+            if (health->frozen_timer < 0.0f) {
+                health->frozen_timer = 0.0f;
+            }
         }
-    }
 
-    if (health->burning_timer) {
-        health->burning_timer -= fixed_time_step;
+        if (health->burning_timer) {
+            health->burning_timer -= delta;
 
-        if (health->burning_timer < 0.0f) {
-            health->burning_timer = 0.0f;
+            if (health->burning_timer < 0.0f) {
+                health->burning_timer = 0.0f;
+            }
         }
     }
 }
 
+void health_reset() {
+    component_set_destroy(&health_components);
+    component_set_init(&health_components, 32);
+
+    // a single update ticks every health, update_reset()
+    // takes care of removing it with update_remove()
+    update_add_interval(&health_components, health_update, 0, UPDATE_LAYER_WORLD, UPDATE_INTERVAL_HALF);
+}
+
 void health_init(struct health* health, entity_id id, float max_health) {
     health->entity_id = id;
     health->max_health = max_health;
@@ -38,17 +46,14 @@ void health_init(struct health* health, entity_id id, float max_health) {
     health->frozen_timer = 0.0f;
     health->burning_timer = 0.0f;
 
-    hash_map_set(&health_entity_mapping, id, health);
-
-    update_add(health, health_update, 0, UPDATE_LAYER_WORLD);
+    component_set_add(&health_components, id, health);
 
     health->callback = NULL;
     health->callback_data = NULL;
 }
 
 void health_destroy(struct health* health) {
-    hash_map_delete(&health_entity_mapping, health->entity_id);
-    update_remove(health);
+    component_set_remove(&health_components, health->entity_id);
 }
 
 void health_damage(struct health* health, float amount, entity_id source, enum damage_type type) {
@@ -72,7 +77,7 @@ void health_damage(struct health* health, float amount, entity_id source, enum d
 }
 
 struct health* health_get(entity_id id) {
-    return hash_map_get(&health_entity_mapping, id);
+    return component_set_get(&health_components, id);
 }
 
 bool health_is_burning(struct health* health) {
@@ -0,0 +1,178 @@
+#include "input.h"
+
+#include <malloc.h>
+#include <string.h>
+#include <assert.h>
+
+#include "../math/mathf.h"
+
+struct input_state {
+    joypad_inputs_t current;
+    joypad_inputs_t previous;
+    enum input_mode mode;
+    struct input_recording* recording;
+    // the next tick to read when replaying
+    uint32_t replay_tick;
+    uint32_t desyncs;
+};
+
+static struct input_state g_input;
+
+struct input_recording* input_recording_new(int capacity) {
+    struct input_recording* result = malloc(sizeof(struct input_recording));
+    result->frames = malloc(sizeof(struct input_frame) * capacity);
+    result->tick_count = 0;
+    result->capacity = capacity;
+    return result;
+}
+
+void input_recording_free(struct input_recording* recording) {
+    if (!recording) {
+        return;
+    }
+
+    free(recording->frames);
+    free(recording);
+}
+
+static void input_record_frame(joypad_inputs_t* inputs) {
+    struct input_recording* recording = g_input.recording;
+
+    if (recording->tick_count == recording->capacity) {
+        recording->capacity *= 2;
+        recording->frames = realloc(recording->frames, sizeof(struct input_frame) * recording->capacity);
+    }
+
+    struct input_frame* frame = &recording->frames[recording->tick_count];
+    frame->buttons = inputs->btn.raw;
+    frame->stick_x = inputs->stick_x;
+    frame->stick_y = inputs->stick_y;
+    frame->random_seed = gRandomSeed;
+    recording->tick_count += 1;
+}
+
+static joypad_inputs_t input_replay_frame() {
+    struct input_frame* frame = &g_input.recording->frames[g_input.replay_tick];
+    g_input.replay_tick += 1;
+
+    if (frame->random_seed != gRandomSeed) {
+        g_input.desyncs += 1;
+        gRandomSeed = frame->random_seed;
+    }
+
+    joypad_inputs_t result;
+    memset(&result, 0, sizeof(result));
+    result.btn.raw = frame->buttons;
+    result.stick_x = frame->stick_x;
+    result.stick_y = frame->stick_y;
+    return result;
+}
+
+void input_poll() {
+    if (g_input.mode == INPUT_MODE_REPLAY) {
+        input_update(input_replay_frame());
+
+        if (g_input.replay_tick == g_input.recording->tick_count) {
+            // the recording belongs to whoever started the replay
+            g_input.mode = INPUT_MODE_LIVE;
+            g_input.recording = NULL;
+        }
+
+        return;
+    }
+
+    joypad_poll();
+    input_update(joypad_get_inputs(JOYPAD_PORT_1));
+}
+
+void input_update(joypad_inputs_t inputs) {
+    g_input.previous = g_input.current;
+    g_input.current = inputs;
+
+    if (g_input.mode == INPUT_MODE_RECORD) {
+        input_record_frame(&inputs);
+    }
+}
+
+joypad_inputs_t input_get_inputs() {
+    return g_input.current;
+}
+
+joypad_buttons_t input_get_buttons_held() {
+    return g_input.current.btn;
+}
+
+joypad_buttons_t input_get_buttons_pressed() {
+    joypad_buttons_t result;
+    result.raw = g_input.current.btn.raw & ~g_input.previous.btn.raw;
+    return result;
+}
+
+static int input_axis_value(joypad_inputs_t* inputs, joypad_axis_t axis) {
+    switch (axis) {
+        case JOYPAD_AXIS_STICK_X:
+            return inputs->stick_x;
+        case JOYPAD_AXIS_STICK_Y:
+            return inputs->stick_y;
+        default:
+            // only the main stick is recorded
+            assert(false);
+            return 0;
+    }
+}
+
+static int input_axis_direction(int value) {
+    if (value >= INPUT_AXIS_PRESS_THRESHOLD) {
+        return 1;
+    }
+
+    if (value <= -INPUT_AXIS_PRESS_THRESHOLD) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int input_get_axis_pressed(joypad_axis_t axis) {
+    int current = input_axis_direction(input_axis_value(&g_input.current, axis));
+    int previous = input_axis_direction(input_axis_value(&g_input.previous, axis));
+    return current != previous ? current : 0;
+}
+
+enum input_mode input_get_mode() {
+    return g_input.mode;
+}
+
+void input_record_start(int initial_capacity) {
+    assert(g_input.mode == INPUT_MODE_LIVE);
+    g_input.recording = input_recording_new(initial_capacity > 0 ? initial_capacity : 1);
+    g_input.mode = INPUT_MODE_RECORD;
+}
+
+struct input_recording* input_record_stop() {
+    if (g_input.mode != INPUT_MODE_RECORD) {
+        return NULL;
+    }
+
+    struct input_recording* result = g_input.recording;
+    g_input.recording = NULL;
+    g_input.mode = INPUT_MODE_LIVE;
+    return result;
+}
+
+void input_replay_start(struct input_recording* recording) {
+    assert(g_input.mode == INPUT_MODE_LIVE);
+    g_input.recording = recording;
+    g_input.replay_tick = 0;
+    g_input.desyncs = 0;
+    g_input.mode = recording->tick_count ? INPUT_MODE_REPLAY : INPUT_MODE_LIVE;
+    memset(&g_input.current, 0, sizeof(joypad_inputs_t));
+
+    if (recording->tick_count) {
+        gRandomSeed = recording->frames[0].random_seed;
+    }
+}
+
+uint32_t input_replay_desyncs() {
+    return g_input.desyncs;
+}
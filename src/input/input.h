@@ -0,0 +1,63 @@
+#ifndef __INPUT_INPUT_H__
+#define __INPUT_INPUT_H__
+
+#include <libdragon.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// every read of the controller goes through here so a play
+// session can be recorded and fed back in tick for tick
+
+enum input_mode {
+    INPUT_MODE_LIVE,
+    INPUT_MODE_RECORD,
+    INPUT_MODE_REPLAY,
+};
+
+// the stick has to move about half way to count as a press
+#define INPUT_AXIS_PRESS_THRESHOLD  40
+
+struct input_frame {
+    uint16_t buttons;
+    int8_t stick_x;
+    int8_t stick_y;
+    // the random seed at the start of the tick, replays restore
+    // it so anything random plays out the same way
+    uint32_t random_seed;
+};
+
+struct input_recording {
+    struct input_frame* frames;
+    uint32_t tick_count;
+    uint32_t capacity;
+};
+
+// called once per simulation tick in place of joypad_poll
+void input_poll();
+// the state of port 1 for the current tick, shifts the previous
+// tick's state over so presses can be detected
+void input_update(joypad_inputs_t inputs);
+
+joypad_inputs_t input_get_inputs();
+joypad_buttons_t input_get_buttons_held();
+joypad_buttons_t input_get_buttons_pressed();
+// returns 1 or -1 on the tick the axis passes INPUT_AXIS_PRESS_THRESHOLD
+int input_get_axis_pressed(joypad_axis_t axis);
+
+enum input_mode input_get_mode();
+
+void input_record_start(int initial_capacity);
+// the caller owns the returned recording
+struct input_recording* input_record_stop();
+
+// plays back the recording, the mode goes back to live as soon as
+// the last tick is read
+void input_replay_start(struct input_recording* recording);
+// ticks where the random seed didn't match the recording, anything
+// above zero means the replay has diverged from the original session
+uint32_t input_replay_desyncs();
+
+struct input_recording* input_recording_new(int capacity);
+void input_recording_free(struct input_recording* recording);
+
+#endif
@@ -0,0 +1,116 @@
+#include "input_recording.h"
+
+#include <malloc.h>
+#include <stdio.h>
+
+// bytes per line when dumping to the debug log
+#define INPUT_RECORDING_DUMP_LINE   32
+
+static void input_recording_write_u16(uint8_t* into, uint16_t value) {
+    into[0] = value >> 8;
+    into[1] = value;
+}
+
+static void input_recording_write_u32(uint8_t* into, uint32_t value) {
+    into[0] = value >> 24;
+    into[1] = value >> 16;
+    into[2] = value >> 8;
+    into[3] = value;
+}
+
+static uint16_t input_recording_read_u16(const uint8_t* from) {
+    return (from[0] << 8) | from[1];
+}
+
+static uint32_t input_recording_read_u32(const uint8_t* from) {
+    return ((uint32_t)from[0] << 24) | (from[1] << 16) | (from[2] << 8) | from[3];
+}
+
+int input_recording_size(struct input_recording* recording) {
+    return INPUT_RECORDING_HEADER_SIZE + recording->tick_count * INPUT_RECORDING_FRAME_SIZE;
+}
+
+void input_recording_write(struct input_recording* recording, uint8_t* into) {
+    input_recording_write_u32(into, INPUT_RECORDING_HEADER);
+    input_recording_write_u16(into + 4, INPUT_RECORDING_VERSION);
+    input_recording_write_u16(into + 6, 0);
+    input_recording_write_u32(into + 8, recording->tick_count);
+    into += INPUT_RECORDING_HEADER_SIZE;
+
+    for (int i = 0; i < recording->tick_count; i += 1) {
+        struct input_frame* frame = &recording->frames[i];
+        input_recording_write_u16(into, frame->buttons);
+        into[2] = (uint8_t)frame->stick_x;
+        into[3] = (uint8_t)frame->stick_y;
+        input_recording_write_u32(into + 4, frame->random_seed);
+        into += INPUT_RECORDING_FRAME_SIZE;
+    }
+}
+
+struct input_recording* input_recording_parse(const uint8_t* data, int size) {
+    if (size < INPUT_RECORDING_HEADER_SIZE || input_recording_read_u32(data) != INPUT_RECORDING_HEADER) {
+        return NULL;
+    }
+
+    if (input_recording_read_u16(data + 4) != INPUT_RECORDING_VERSION) {
+        return NULL;
+    }
+
+    uint32_t tick_count = input_recording_read_u32(data + 8);
+
+    if (size < INPUT_RECORDING_HEADER_SIZE + tick_count * INPUT_RECORDING_FRAME_SIZE) {
+        return NULL;
+    }
+
+    struct input_recording* result = input_recording_new(tick_count ? tick_count : 1);
+    result->tick_count = tick_count;
+    data += INPUT_RECORDING_HEADER_SIZE;
+
+    for (int i = 0; i < tick_count; i += 1) {
+        struct input_frame* frame = &result->frames[i];
+        frame->buttons = input_recording_read_u16(data);
+        frame->stick_x = (int8_t)data[2];
+        frame->stick_y = (int8_t)data[3];
+        frame->random_seed = input_recording_read_u32(data + 4);
+        data += INPUT_RECORDING_FRAME_SIZE;
+    }
+
+    return result;
+}
+
+struct input_recording* input_recording_load(const char* filename) {
+    int size;
+    uint8_t* data = asset_load(filename, &size);
+    struct input_recording* result = input_recording_parse(data, size);
+    // malloc() is done by asset_load
+    free(data);
+
+    if (!result) {
+        fprintf(stderr, "input_recording: %s is not a recording\n", filename);
+    }
+
+    return result;
+}
+
+void input_recording_dump(struct input_recording* recording) {
+    int size = input_recording_size(recording);
+    uint8_t* data = malloc(size);
+    input_recording_write(recording, data);
+
+    // the line format is parsed by tools/input_recording.py
+    fprintf(stderr, "input_recording begin %d\n", size);
+
+    for (int line = 0; line < size; line += INPUT_RECORDING_DUMP_LINE) {
+        fprintf(stderr, "input_recording d ");
+
+        for (int i = line; i < size && i < line + INPUT_RECORDING_DUMP_LINE; i += 1) {
+            fprintf(stderr, "%02x", data[i]);
+        }
+
+        fprintf(stderr, "\n");
+    }
+
+    fprintf(stderr, "input_recording end\n");
+
+    free(data);
+}
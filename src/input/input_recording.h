@@ -0,0 +1,29 @@
+#ifndef __INPUT_INPUT_RECORDING_H__
+#define __INPUT_INPUT_RECORDING_H__
+
+#include "input.h"
+
+// recordings are stored big endian, a 12 byte header then
+// 8 bytes per tick
+//
+//   header       "INPT" version:u16 reserved:u16 tick_count:u32
+//   each tick    buttons:u16 stick_x:s8 stick_y:s8 random_seed:u32
+
+#define INPUT_RECORDING_HEADER      0x494E5054
+#define INPUT_RECORDING_VERSION     1
+#define INPUT_RECORDING_HEADER_SIZE 12
+#define INPUT_RECORDING_FRAME_SIZE  8
+
+int input_recording_size(struct input_recording* recording);
+void input_recording_write(struct input_recording* recording, uint8_t* into);
+// returns NULL if data isn't a recording
+struct input_recording* input_recording_parse(const uint8_t* data, int size);
+
+struct input_recording* input_recording_load(const char* filename);
+
+// there is nowhere to save a file on the console so the recording
+// is written to the debug log, tools/input_recording.py turns the
+// log back into a .replay file
+void input_recording_dump(struct input_recording* recording);
+
+#endif
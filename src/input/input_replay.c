@@ -0,0 +1,69 @@
+#include "input_replay.h"
+
+#include <libdragon.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "input.h"
+#include "../math/mathf.h"
+#include "../util/hash.h"
+#include "../time/time.h"
+#include "../collision/collision_scene.h"
+
+#ifndef HOST_BUILD
+#include "../spell/projectile_manager.h"
+#endif
+
+static struct input_replay_stats g_replay_stats;
+
+void input_replay_reset() {
+    memset(&g_replay_stats, 0, sizeof(struct input_replay_stats));
+}
+
+uint32_t input_replay_state_hash() {
+    uint32_t hash = FNV_OFFSET_BASIS;
+    hash = (hash ^ update_tick) * FNV_PRIME;
+    hash = (hash ^ gRandomSeed) * FNV_PRIME;
+    hash = collision_scene_state_hash(hash);
+
+#ifndef HOST_BUILD
+    // projectiles aren't part of the host build
+    hash = projectile_manager_state_hash(hash);
+#endif
+
+    return hash;
+}
+
+void input_replay_frame(uint32_t ticks) {
+    g_replay_stats.total_ticks += ticks;
+    g_replay_stats.frames += 1;
+    g_replay_stats.state_hash = input_replay_state_hash();
+
+    if (ticks > g_replay_stats.max_ticks) {
+        g_replay_stats.max_ticks = ticks;
+    }
+
+#ifdef INPUT_REPLAY_TRACE
+    // a hash every tick shows where two runs start to differ
+    fprintf(stderr, "input_replay f %d %d %08x\n", (int)g_replay_stats.frames, (int)TICKS_TO_US(ticks), (unsigned)g_replay_stats.state_hash);
+#endif
+}
+
+struct input_replay_stats* input_replay_get_stats() {
+    return &g_replay_stats;
+}
+
+void input_replay_report() {
+    struct input_replay_stats* stats = &g_replay_stats;
+    int frames = stats->frames ? stats->frames : 1;
+
+    fprintf(
+        stderr,
+        "input_replay done frames %d avg %dus max %dus desyncs %d hash %08x\n",
+        (int)stats->frames,
+        (int)TICKS_TO_US(stats->total_ticks / frames),
+        (int)TICKS_TO_US(stats->max_ticks),
+        (int)input_replay_desyncs(),
+        (unsigned)stats->state_hash
+    );
+}
@@ -0,0 +1,25 @@
+#ifndef __INPUT_INPUT_REPLAY_H__
+#define __INPUT_INPUT_REPLAY_H__
+
+#include <stdint.h>
+
+// timing and state hashes for replays run without rendering, the
+// final hash should be the same on every build unless the simulation
+// itself changed
+
+struct input_replay_stats {
+    uint64_t total_ticks;
+    uint32_t max_ticks;
+    uint32_t frames;
+    uint32_t state_hash;
+};
+
+void input_replay_reset();
+uint32_t input_replay_state_hash();
+
+// call after each simulated tick with how long it took
+void input_replay_frame(uint32_t ticks);
+struct input_replay_stats* input_replay_get_stats();
+void input_replay_report();
+
+#endif
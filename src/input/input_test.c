@@ -0,0 +1,81 @@
+#include "input.h"
+#include "input_recording.h"
+#include "../math/mathf.h"
+#include "../test/framework_test.h"
+
+#include <malloc.h>
+#include <string.h>
+
+static joypad_inputs_t test_input(uint16_t buttons, int8_t stick_x) {
+    joypad_inputs_t result;
+    memset(&result, 0, sizeof(result));
+    result.btn.raw = buttons;
+    result.stick_x = stick_x;
+    return result;
+}
+
+void test_input_record_replay(struct test_context* t) {
+    joypad_buttons_t a_button = {0};
+    a_button.a = 1;
+
+    // start from a known state
+    input_update(test_input(0, 0));
+    gRandomSeed = 5;
+
+    input_record_start(1);
+    input_update(test_input(a_button.raw, 0));
+    randomInt();
+    input_update(test_input(a_button.raw, 80));
+    uint32_t last_seed = gRandomSeed;
+    input_update(test_input(0, 80));
+    struct input_recording* recording = input_record_stop();
+
+    test_eqi(t, INPUT_MODE_LIVE, input_get_mode());
+    test_eqi(t, 3, recording->tick_count);
+    test_eqi(t, 5, recording->frames[0].random_seed);
+    test_eqi(t, last_seed, recording->frames[1].random_seed);
+
+    // round trip through the file format
+    int size = input_recording_size(recording);
+    uint8_t* data = malloc(size);
+    input_recording_write(recording, data);
+    struct input_recording* loaded = input_recording_parse(data, size);
+    test_neqp(t, NULL, loaded);
+    test_eqi(t, 0, memcmp(recording->frames, loaded->frames, sizeof(struct input_frame) * recording->tick_count));
+
+    data[0] = 0;
+    test_eqp(t, NULL, input_recording_parse(data, size));
+    free(data);
+
+    gRandomSeed = 1234;
+    input_replay_start(loaded);
+    test_eqi(t, 5, gRandomSeed);
+
+    input_poll();
+    test_eqi(t, 1, input_get_buttons_pressed().a);
+    test_eqi(t, 0, input_get_axis_pressed(JOYPAD_AXIS_STICK_X));
+
+    // the simulation makes the same random calls as it did when recording
+    randomInt();
+    input_poll();
+    test_eqi(t, 0, input_get_buttons_pressed().a);
+    test_eqi(t, 1, input_get_buttons_held().a);
+    test_eqi(t, 1, input_get_axis_pressed(JOYPAD_AXIS_STICK_X));
+    test_eqi(t, last_seed, gRandomSeed);
+    test_eqi(t, 0, input_replay_desyncs());
+
+    // a seed that doesn't match the recording is a desync, the seed
+    // is put back so the rest of the replay can still be compared
+    gRandomSeed = 0;
+    input_poll();
+    test_eqi(t, last_seed, gRandomSeed);
+    test_eqi(t, 0, input_get_buttons_held().a);
+    test_eqi(t, 0, input_get_axis_pressed(JOYPAD_AXIS_STICK_X));
+    test_eqi(t, 1, input_replay_desyncs());
+
+    // after the last tick input comes from the controller
+    test_eqi(t, INPUT_MODE_LIVE, input_get_mode());
+
+    input_recording_free(recording);
+    input_recording_free(loaded);
+}
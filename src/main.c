@@ -9,16 +9,27 @@
 #include "menu/spell_building_menu.h"
 #include "savefile/savefile.h"
 #include "time/time.h"
+#include "time/background.h"
+#include "time/frame_profile.h"
 #include "collision/collision_scene.h"
+#include "collision/collision_profile.h"
+#include "spell/projectile_manager.h"
 #include "menu/menu_rendering.h"
 #include "render/render_scene.h"
 
 #include "render/render_batch.h"
 #include "scene/world_loader.h"
+#include "scene/world_prefetch.h"
 #include "objects/crate.h"
 #include "time/game_mode.h"
 #include "render/tmesh.h"
+#include "render/interpolation.h"
 #include "util/init.h"
+#include "util/memory_tag.h"
+#include "resource/resource_cache.h"
+#include "input/input.h"
+#include "input/input_recording.h"
+#include "input/input_replay.h"
 
 #include <libdragon.h>
 #include <n64sys.h>
@@ -27,6 +38,25 @@
 
 struct world* current_world;
 
+static struct transform_history camera_history;
+
+// about a minute at 30 ticks per second, it grows if needed
+#define INPUT_RECORD_CAPACITY   2048
+
+static struct input_recording* replay_recording;
+
+static struct frame_memory_pool frame_memory_pools[2];
+static uint8_t next_frame_memoy_pool;
+
+void frame_pools_configure(struct world* world) {
+    // the previous world may still be rendering out of the pools
+    rspq_wait();
+
+    for (int i = 0; i < 2; i += 1) {
+        frame_pool_resize(&frame_memory_pools[i], world->frame_memory_size);
+    }
+}
+
 void setup() {
     debug_init_isviewer();
     // fprintf(stderr, "This is how to talk");
@@ -34,10 +64,23 @@ void setup() {
     savefile_new();
 
     current_world = world_load("rom:/worlds/playerhome_basement.world");
+    frame_pools_configure(current_world);
+    transform_history_reset(&camera_history);
+
+    background_add(NULL, world_prefetch_background_step, BACKGROUND_PRIORITY_NORMAL);
+    background_add(NULL, resource_cache_background_trim, BACKGROUND_PRIORITY_LOW);
+
+#if defined(INPUT_REPLAY)
+    replay_recording = input_recording_load(INPUT_REPLAY);
+
+    if (replay_recording) {
+        input_replay_start(replay_recording);
+    }
+#elif defined(INPUT_RECORD)
+    input_record_start(INPUT_RECORD_CAPACITY);
+#endif
 }
 
-static struct frame_memory_pool frame_memory_pools[2];
-static uint8_t next_frame_memoy_pool;
 
 void transform_to_t3d(struct Transform* transform, T3DMat4FP* matrix) {
     T3DMat4 tmp;
@@ -58,19 +101,27 @@ void render_3d() {
     
     struct frame_memory_pool* pool = &frame_memory_pools[next_frame_memoy_pool];
     frame_pool_reset(pool);
+#ifdef FRAME_PROFILE
+    frame_profile_frame_pool(pool->stats.last_frame_bytes, pool->word_count * sizeof(uint64_t));
+#endif
 
     T3DViewport* viewport = frame_malloc(pool, sizeof(T3DViewport));
     *viewport = t3d_viewport_create();
 
-    render_scene_render(&current_world->camera, viewport, &frame_memory_pools[next_frame_memoy_pool]);
+    struct Camera camera = current_world->camera;
+    transform_history_sample(&camera_history, &current_world->camera.transform, &camera.transform);
+
+    render_scene_render(&camera, viewport, &frame_memory_pools[next_frame_memoy_pool]);
     
     next_frame_memoy_pool ^= 1;
 }
 
 void render_menu() {
+    FRAME_PROFILE_BEGIN(FRAME_ZONE_RENDER_MENU);
     rdpq_mode_persp(false);
     rdpq_set_mode_standard();
     menu_render();
+    FRAME_PROFILE_END(FRAME_ZONE_RENDER_MENU);
 }
 
 void render(surface_t* zbuffer) {
@@ -93,9 +144,50 @@ void on_vi_interrupt() {
     frame_happened = 1;
 }
 
-bool check_world_load() {
+static struct world_loader world_loader;
+static bool world_loading;
+
+void render_world_loading(float progress) {
+    surface_t* fb = display_try_get();
+
+    if (!fb) {
+        return;
+    }
+
+    rdpq_attach(fb, NULL);
+
+    rdpq_set_mode_fill(RGBA32(0, 0, 0, 255));
+    rdpq_fill_rectangle(0, 0, 320, 240);
+
+    rdpq_set_fill_color(RGBA32(40, 40, 40, 255));
+    rdpq_fill_rectangle(80, 200, 240, 204);
+    rdpq_set_fill_color(RGBA32(200, 200, 200, 255));
+    rdpq_fill_rectangle(80, 200, 80 + 160 * progress, 204);
+
+    rdpq_detach_show();
+}
+
+// show_progress is false in a headless replay so loading never touches the display
+bool check_world_load(bool show_progress) {
     static uint8_t frame_wait = 0;
 
+    if (world_loading) {
+        if (world_loader_step(&world_loader, WORLD_LOADER_FRAME_BUDGET)) {
+            current_world = world_loader.world;
+            world_loading = false;
+            frame_pools_configure(current_world);
+            transform_history_reset(&camera_history);
+            world_prefetch_release_dependencies();
+            return false;
+        }
+
+        if (show_progress) {
+            render_world_loading(world_loader_progress(&world_loader));
+        }
+
+        return true;
+    }
+
     if (!world_has_next()) {
         return false;
     }
@@ -112,12 +204,75 @@ bool check_world_load() {
     }
 
     world_release(current_world);
-    current_world = world_load(world_get_next());
+    current_world = NULL;
+
+    if (!world_prefetch_take(world_get_next(), &world_loader)) {
+        world_loader_begin(&world_loader, world_get_next());
+    }
+
     world_clear_next();
+    world_loading = true;
+
+    return true;
+}
+
+// a single fixed step of the simulation
+void simulate_tick() {
+    long long start = timer_ticks();
+    bool replaying = input_get_mode() == INPUT_MODE_REPLAY;
+
+    input_poll();
+    if (update_has_layer(UPDATE_LAYER_WORLD)) {
+        collision_scene_collide();
+        projectile_manager_step();
+    }
+    update_dispatch();
+
+    if (input_get_mode() != INPUT_MODE_LIVE) {
+        // deferred work normally lands whenever there is idle time
+        // so it has to be pinned to a tick to record and replay
+        background_flush_deferred();
+    }
+
+    if (replaying) {
+        input_replay_frame(timer_ticks() - start);
+    }
+}
 
-    return false;
+void check_recording() {
+#ifdef INPUT_RECORD
+    if (input_get_mode() == INPUT_MODE_RECORD && input_get_buttons_held().l && input_get_buttons_pressed().d_left) {
+        struct input_recording* recording = input_record_stop();
+        input_recording_dump(recording);
+        input_recording_free(recording);
+    }
+#endif
+
+    if (replay_recording && input_get_mode() != INPUT_MODE_REPLAY) {
+        input_replay_report();
+        input_recording_free(replay_recording);
+        replay_recording = NULL;
+    }
 }
 
+#ifdef INPUT_REPLAY_HEADLESS
+// steps through the replay as fast as possible without rendering
+// so only the cost of the simulation is measured
+void run_headless_replay() {
+    while (input_get_mode() == INPUT_MODE_REPLAY) {
+        background_flush_deferred();
+
+        if (check_world_load(false)) {
+            continue;
+        }
+
+        simulate_tick();
+    }
+
+    check_recording();
+}
+#endif
+
 #define DEBUG_CONNECT_DELAY     TICKS_FROM_MS(500)
 
 int main(void)
@@ -140,18 +295,37 @@ int main(void)
 
     setup();
 
+#ifdef INPUT_REPLAY_HEADLESS
+    run_headless_replay();
+#endif
+
     register_VI_handler(on_vi_interrupt);
 
     while(1) {
-        while (!frame_happened) {
-            // TODO process low priority tasks
-        }
+        FRAME_PROFILE_BEGIN(FRAME_ZONE_IDLE);
+        background_idle(&frame_happened);
         frame_happened = 0;
+        FRAME_PROFILE_END(FRAME_ZONE_IDLE);
+
+#ifdef FRAME_PROFILE
+        // frames are split at the vi interrupt
+        frame_profile_end_frame();
+#endif
+
+        background_flush_deferred();
+
+        FRAME_PROFILE_BEGIN(FRAME_ZONE_WORLD_LOAD);
+        bool world_load = check_world_load(true);
+        FRAME_PROFILE_END(FRAME_ZONE_WORLD_LOAD);
 
-        if (check_world_load()) {
+        if (world_load) {
+            // the time spent loading isn't caught up on
+            update_frame_skip();
             continue;
         }
 
+        FRAME_PROFILE_BEGIN(FRAME_ZONE_RENDER);
+
         if (current_game_mode == GAME_MODE_TRANSITION_TO_MENU) {
             surface_t* fb = display_get();
 
@@ -190,13 +364,38 @@ int main(void)
                 render(&zbuffer);
 
                 rdpq_detach_show();
-            } 
+            } else {
+                update_frame_dropped();
+            }
+        }
+
+        FRAME_PROFILE_END(FRAME_ZONE_RENDER);
+
+        // the simulation runs at a fixed rate no matter how
+        // long rendering takes
+        int steps = update_frame_steps();
+
+        for (int step = 0; step < steps; step += 1) {
+            simulate_tick();
+
+            // the next world starts loading on the tick that asked
+            // for it so replays see the same sequence of ticks
+            if (world_has_next()) {
+                break;
+            }
         }
 
-        joypad_poll();
-        if (update_has_layer(UPDATE_LAYER_WORLD)) {
-            collision_scene_collide();
+        check_recording();
+
+#ifdef COLLISION_PROFILE
+        if (g_collision_profile.ticks >= COLLISION_PROFILE_REPORT_INTERVAL) {
+            collision_profile_report();
+            collision_profile_reset();
         }
-        update_dispatch();
+#endif
+
+#ifdef MEMORY_PROFILE
+        memory_tag_report_update();
+#endif
     }
 }
\ No newline at end of file
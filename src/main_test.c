@@ -6,12 +6,27 @@
 
 void test_mesh_index_lookup_triangle_indices(struct test_context* t);
 void test_mesh_index_swept_lookup(struct test_context* t);
+void test_mesh_collider_sweep_sphere(struct test_context* t);
 void test_collide_object_swept_to_triangle(struct test_context* t);
 void test_collide_object_to_mesh_swept(struct test_context* t);
 void test_collision_scene_collide_single(struct test_context* t);
 void test_collision_scene_collide(struct test_context* t);
 void test_ring_malloc(struct test_context* t);
+void test_arena_malloc(struct test_context* t);
+void test_slab_malloc(struct test_context* t);
+void test_slab_fragmentation(struct test_context* t);
+void test_slab_benchmark(struct test_context* t);
+void test_hash_map_randomized(struct test_context* t);
+void test_hash_map_benchmark(struct test_context* t);
+void test_component_set(struct test_context* t);
+void test_resource_cache_zombies(struct test_context* t);
+void test_input_record_replay(struct test_context* t);
+void test_spell_data_source_pool(struct test_context* t);
+void test_spell_program_compile(struct test_context* t);
+void test_expression_evaluate(struct test_context* t);
 void test_training_dummy(struct test_context* t);
+void test_world_load_benchmark(struct test_context* t);
+void test_world_load_leaks(struct test_context* t);
 
 #define DEBUG_CONNECT_DELAY     TICKS_FROM_MS(500)
 
@@ -33,6 +48,7 @@ int main() {
 
     test_run(test_mesh_index_lookup_triangle_indices);
     test_run(test_mesh_index_swept_lookup);
+    test_run(test_mesh_collider_sweep_sphere);
 
     test_run(test_collide_object_swept_to_triangle);
     test_run(test_collide_object_to_mesh_swept);
@@ -41,9 +57,29 @@ int main() {
     test_run(test_collision_scene_collide);
 
     test_run(test_ring_malloc);
+    test_run(test_arena_malloc);
+    test_run(test_slab_malloc);
+    test_run(test_slab_fragmentation);
+    test_run(test_slab_benchmark);
+
+    test_run(test_hash_map_randomized);
+    test_run(test_hash_map_benchmark);
+
+    test_run(test_component_set);
+
+    test_run(test_resource_cache_zombies);
+
+    test_run(test_input_record_replay);
+
+    test_run(test_spell_data_source_pool);
+    test_run(test_spell_program_compile);
+    test_run(test_expression_evaluate);
 
     test_run(test_training_dummy);
 
+    test_run(test_world_load_benchmark);
+    test_run(test_world_load_leaks);
+
     test_report_failures();
 
     return 0;
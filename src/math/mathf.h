@@ -2,6 +2,8 @@
 #ifndef _MATH_MATHF_H
 #define _MATH_MATHF_H
 
+extern unsigned int gRandomSeed;
+
 int randomInt();
 int randomInRange(int min, int maxPlusOne);
 float randomInRangef(float min, float max);
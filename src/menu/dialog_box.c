@@ -5,6 +5,7 @@
 #include "menu_rendering.h"
 #include "../time/time.h"
 #include "../util/text.h"
+#include "../input/input.h"
 #include <string.h>
 
 #define CHARACTERS_PER_SECOND   45.0f
@@ -13,13 +14,14 @@ struct dialog_box dialog_box;
 
 void dialog_box_init() {
     dialog_box.current_message = NULL;
+    dialog_box.update_id = UPDATE_ID_NONE;
     dialog_box.font = font_cache_load("rom:/fonts/Amarante-Regular.font64");
     rdpq_text_register_font(1, dialog_box.font);
 }
 
 void dialog_box_update(void* data) {
-    joypad_inputs_t input = joypad_get_inputs(0);
-    joypad_buttons_t pressed = joypad_get_buttons_pressed(0);
+    joypad_inputs_t input = input_get_inputs();
+    joypad_buttons_t pressed = input_get_buttons_pressed();
 
     if (!dialog_box.paused) {
         dialog_box.requested_characters += fixed_time_step * (input.btn.a ? CHARACTERS_PER_SECOND * 4.0f : CHARACTERS_PER_SECOND);
@@ -119,7 +121,7 @@ void dialog_box_show(char* message, int* args, dialog_end_callback end_callback,
     dialog_box.current_message = dialog_box.current_text;
 
     menu_add_callback(dialog_box_render, &dialog_box, 1);
-    update_add(&dialog_box, dialog_box_update, UPDATE_PRIORITY_PLAYER, UPDATE_LAYER_DIALOG);
+    dialog_box.update_id = update_add(&dialog_box, dialog_box_update, UPDATE_PRIORITY_PLAYER, UPDATE_LAYER_DIALOG);
 
     dialog_box.current_message_start = dialog_box.current_message;
     dialog_box.current_message_end = dialog_box.current_message;
@@ -138,7 +140,8 @@ bool dialog_box_is_active() {
 
 void dialog_box_hide() {
     menu_remove_callback(&dialog_box);
-    update_remove(&dialog_box);
+    update_remove(dialog_box.update_id);
+    dialog_box.update_id = UPDATE_ID_NONE;
     dialog_box.current_message = NULL;
 }
 
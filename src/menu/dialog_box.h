@@ -3,6 +3,7 @@
 
 #include <libdragon.h>
 #include <stdbool.h>
+#include "../time/time.h"
 
 typedef void (*dialog_end_callback)(void* data);
 
@@ -22,6 +23,7 @@ struct dialog_box {
 
     dialog_end_callback end_callback;
     void* end_callback_data;
+    update_id update_id;
 };
 
 void dialog_box_init();
@@ -2,6 +2,7 @@
 
 #include "menu_common.h"
 #include "../resource/material_cache.h"
+#include "../input/input.h"
 
 void inventory_menu_init(struct inventory_menu* menu) {
     menu->cursor_x = 0;
@@ -26,7 +27,7 @@ void inventory_menu_hide(struct inventory_menu* menu) {
 }
 
 void inventory_menu_update(struct inventory_menu* menu) {
-    joypad_buttons_t pressed = joypad_get_buttons_pressed(0);
+    joypad_buttons_t pressed = input_get_buttons_pressed();
 
     if (pressed.a && menu->cursor_x < INV_STAFF_COUNT && inventory_has_item(staff_item_types[menu->cursor_x])) {
         inventory_equip_staff(staff_item_types[menu->cursor_x]);
@@ -4,6 +4,7 @@
 #include "../time/time.h"
 #include "../time/game_mode.h"
 #include "menu_rendering.h"
+#include "../input/input.h"
 
 void pause_menu_render(void *data) {
     struct pause_menu* pause_menu = (struct pause_menu*)data;
@@ -78,7 +79,7 @@ static enum active_menu prev_menu[] = {
 };
 
 void pause_menu_update(struct pause_menu* pause_menu) {
-    joypad_buttons_t pressed = joypad_get_buttons_pressed(0);
+    joypad_buttons_t pressed = input_get_buttons_pressed();
 
     if (pressed.start) {
         if (pause_menu->active_menu == ACTIVE_MENU_NONE) {
@@ -114,7 +115,7 @@ void pause_menu_update(struct pause_menu* pause_menu) {
 }
 
 void pause_menu_init(struct pause_menu* pause_menu) {
-    update_add(pause_menu, (update_callback)pause_menu_update, UPDATE_PRIORITY_PLAYER, UPDATE_LAYER_PAUSE_MENU);
+    pause_menu->update_id = update_add(pause_menu, (update_callback)pause_menu_update, UPDATE_PRIORITY_PLAYER, UPDATE_LAYER_PAUSE_MENU);
     spell_building_menu_init(&pause_menu->spell_building_menu);
     spell_menu_init(&pause_menu->spell_menu);
     menu_add_callback(pause_menu_render, pause_menu, 0);
@@ -123,7 +124,7 @@ void pause_menu_init(struct pause_menu* pause_menu) {
 }
 
 void pause_menu_destroy(struct pause_menu* pause_menu) {
-    update_remove(pause_menu);
+    update_remove(pause_menu->update_id);
     spell_building_menu_destroy(&pause_menu->spell_building_menu);
     spell_menu_destroy(&pause_menu->spell_menu);
     menu_remove_callback(pause_menu);
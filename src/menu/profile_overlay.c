@@ -0,0 +1,128 @@
+#include "profile_overlay.h"
+
+#include <libdragon.h>
+#include "menu_common.h"
+#include "menu_rendering.h"
+#include "../time/time.h"
+#include "../time/frame_profile.h"
+#include "../input/input.h"
+
+#define PROFILE_OVERLAY_FONT        2
+#define PROFILE_OVERLAY_FRAMES      30
+
+#define PROFILE_OVERLAY_X           12
+#define PROFILE_OVERLAY_Y           12
+#define PROFILE_OVERLAY_WIDTH       168
+#define PROFILE_OVERLAY_LINE_HEIGHT 10
+#define PROFILE_OVERLAY_INDENT      8
+
+// drawn over every other menu
+#define PROFILE_OVERLAY_PRIORITY    1000
+
+#define PROFILE_OVERLAY_LAYERS  (UPDATE_LAYER_WORLD | UPDATE_LAYER_PLAYER | UPDATE_LAYER_DIALOG | UPDATE_LAYER_PAUSE_MENU | UPDATE_LAYER_CUTSCENE)
+
+#define TICKS_TO_MS_F(ticks)        ((ticks) * (1000.0f / TICKS_PER_SECOND))
+#define RDP_CYCLES_TO_MS_F(cycles)  ((cycles) * (1000.0f / FRAME_PROFILE_RDP_CLOCK))
+
+static struct profile_overlay g_profile_overlay;
+
+void profile_overlay_update(void* data) {
+    struct profile_overlay* overlay = (struct profile_overlay*)data;
+
+    joypad_buttons_t held = input_get_buttons_held();
+    joypad_buttons_t pressed = input_get_buttons_pressed();
+
+    if (!held.l) {
+        return;
+    }
+
+    if (pressed.d_up) {
+        overlay->visible = !overlay->visible;
+    }
+
+    if (pressed.d_down) {
+        frame_profile_dump();
+    }
+}
+
+void profile_overlay_render(void* data) {
+    struct profile_overlay* overlay = (struct profile_overlay*)data;
+
+    if (!overlay->visible) {
+        return;
+    }
+
+    struct frame_profile_sample average;
+    frame_profile_average(&average, PROFILE_OVERLAY_FRAMES);
+
+    int line_count = FRAME_ZONE_COUNT + 4;
+
+    menu_common_render_background(
+        PROFILE_OVERLAY_X - 4, PROFILE_OVERLAY_Y - 4,
+        PROFILE_OVERLAY_WIDTH,
+        line_count * PROFILE_OVERLAY_LINE_HEIGHT + 8
+    );
+
+    int y = PROFILE_OVERLAY_Y + PROFILE_OVERLAY_LINE_HEIGHT - 2;
+
+    rdpq_text_printf(NULL, PROFILE_OVERLAY_FONT, PROFILE_OVERLAY_X, y, "frame %5.2fms", TICKS_TO_MS_F(average.frame_ticks));
+    y += PROFILE_OVERLAY_LINE_HEIGHT;
+
+    for (int zone = 0; zone < FRAME_ZONE_COUNT; zone += 1) {
+        rdpq_text_printf(
+            NULL, 
+            PROFILE_OVERLAY_FONT, 
+            PROFILE_OVERLAY_X + (frame_profile_zone_depth(zone) + 1) * PROFILE_OVERLAY_INDENT, 
+            y, 
+            "%-12s %5.2fms", 
+            frame_profile_zone_names[zone], 
+            TICKS_TO_MS_F(average.zone_ticks[zone])
+        );
+        y += PROFILE_OVERLAY_LINE_HEIGHT;
+    }
+
+    rdpq_text_printf(
+        NULL, 
+        PROFILE_OVERLAY_FONT, 
+        PROFILE_OVERLAY_X, 
+        y, 
+        "rdp %5.2fms pipe %5.2fms", 
+        RDP_CYCLES_TO_MS_F(average.rdp_busy), 
+        RDP_CYCLES_TO_MS_F(average.rdp_pipe)
+    );
+    y += PROFILE_OVERLAY_LINE_HEIGHT;
+
+    rdpq_text_printf(
+        NULL, 
+        PROFILE_OVERLAY_FONT, 
+        PROFILE_OVERLAY_X, 
+        y, 
+        "frame pool %dK/%dK", 
+        (int)(average.frame_pool_bytes / 1024), 
+        (int)(average.frame_pool_capacity / 1024)
+    );
+    y += PROFILE_OVERLAY_LINE_HEIGHT;
+
+    rdpq_text_printf(
+        NULL, 
+        PROFILE_OVERLAY_FONT, 
+        PROFILE_OVERLAY_X, 
+        y, 
+        "heap %dK/%dK", 
+        (int)(average.heap_used / 1024), 
+        (int)(average.heap_total / 1024)
+    );
+}
+
+void profile_overlay_init() {
+    rdpq_text_register_font(PROFILE_OVERLAY_FONT, rdpq_font_load_builtin(FONT_BUILTIN_DEBUG_MONO));
+
+    g_profile_overlay.visible = false;
+    g_profile_overlay.update_id = update_add(&g_profile_overlay, profile_overlay_update, UPDATE_PRIORITY_PLAYER, PROFILE_OVERLAY_LAYERS);
+    menu_add_callback(profile_overlay_render, &g_profile_overlay, PROFILE_OVERLAY_PRIORITY);
+}
+
+void profile_overlay_destroy() {
+    update_remove(g_profile_overlay.update_id);
+    menu_remove_callback(&g_profile_overlay);
+}
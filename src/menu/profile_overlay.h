@@ -0,0 +1,21 @@
+#ifndef __MENU_PROFILE_OVERLAY_H__
+#define __MENU_PROFILE_OVERLAY_H__
+
+#include <stdbool.h>
+#include "../time/time.h"
+
+// shows the frame profiler on screen, only exists in
+// builds with FRAME_PROFILE defined
+//
+// hold L and press d-pad up to toggle the overlay or
+// d-pad down to dump the frame history to the debug log
+
+struct profile_overlay {
+    bool visible;
+    update_id update_id;
+};
+
+void profile_overlay_init();
+void profile_overlay_destroy();
+
+#endif
@@ -6,6 +6,7 @@
 #include "menu_common.h"
 #include "../resource/material_cache.h"
 #include "../time/time.h"
+#include "../input/input.h"
 
 static struct material* spell_symbol_material;
 
@@ -86,7 +87,7 @@ void spell_building_render_menu(struct spell_building_menu* menu) {
 }
 
 void spell_building_menu_update(struct spell_building_menu* menu) {
-    joypad_buttons_t pressed = joypad_get_buttons_pressed(0);
+    joypad_buttons_t pressed = input_get_buttons_pressed();
 
     if (pressed.c_right && menu->spell_cursor_x < SPELL_MAX_COLS) {
         menu->spell_cursor_x += 1;
@@ -104,7 +105,7 @@ void spell_building_menu_update(struct spell_building_menu* menu) {
         menu->spell_cursor_y -= 1;
     }
 
-    int direction = joypad_get_axis_pressed(0, JOYPAD_AXIS_STICK_X);
+    int direction = input_get_axis_pressed(JOYPAD_AXIS_STICK_X);
 
     if (direction > 0 && menu->symbol_cursor_x + 1 < SPELL_SYMBOLS_PER_ROW) {
         menu->symbol_cursor_x += 1;
@@ -114,7 +115,7 @@ void spell_building_menu_update(struct spell_building_menu* menu) {
         menu->symbol_cursor_x -= 1;
     }
 
-    direction = joypad_get_axis_pressed(0, JOYPAD_AXIS_STICK_Y);
+    direction = input_get_axis_pressed(JOYPAD_AXIS_STICK_Y);
 
     if (direction > 0 && menu->symbol_cursor_y + 1 < 2) {
         menu->symbol_cursor_y += 1;
@@ -172,4 +173,6 @@ void spell_building_menu_hide(struct spell_building_menu* menu) {
             spell_set_symbol(menu->current_spell, col, row, menu->symbol_grid[row][col]);
         }
     }
+
+    spell_compile(menu->current_spell);
 }
\ No newline at end of file
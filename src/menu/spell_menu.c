@@ -1,6 +1,7 @@
 #include "spell_menu.h"
 
 #include "menu_common.h"
+#include "../input/input.h"
 
 void spell_menu_init(struct spell_menu* spell_menu) {
     spell_menu->cursor_x = 0;
@@ -50,7 +51,7 @@ void spell_menu_assign_slot(struct spell_menu* menu, int slot) {
 }
 
 struct spell* spell_menu_update(struct spell_menu* spell_menu) {
-    joypad_buttons_t pressed = joypad_get_buttons_pressed(0);
+    joypad_buttons_t pressed = input_get_buttons_pressed();
 
     if (pressed.c_up) {
         spell_menu_assign_slot(spell_menu, 0);
@@ -72,7 +73,7 @@ struct spell* spell_menu_update(struct spell_menu* spell_menu) {
         return inventory_get_custom_spell(spell_menu->cursor_x);
     }
 
-    int direction = joypad_get_axis_pressed(0, JOYPAD_AXIS_STICK_X);
+    int direction = input_get_axis_pressed(JOYPAD_AXIS_STICK_X);
 
     if (direction > 0 && spell_menu->cursor_x + 1 < INVENTORY_SPELL_COLUMNS) {
         spell_menu->cursor_x += 1;
@@ -82,7 +83,7 @@ struct spell* spell_menu_update(struct spell_menu* spell_menu) {
         spell_menu->cursor_x -= 1;
     }
 
-    direction = joypad_get_axis_pressed(0, JOYPAD_AXIS_STICK_Y);
+    direction = input_get_axis_pressed(JOYPAD_AXIS_STICK_Y);
 
     if (direction < 0 && spell_menu->cursor_y + 1 <= INVENTORY_SPELL_ROWS) {
         spell_menu->cursor_y += 1;
@@ -5,11 +5,12 @@
 #include "../resource/animation_cache.h"
 #include "../collision/collision_scene.h"
 #include "../cutscene/cutscene_runner.h"
+#include "../resource/asset_ids.h"
 
 struct npc_information npc_information[] = {
     [NPC_TYPE_MENTOR] = {
-        .mesh = "rom:/meshes/characters/mentor.tmesh",
-        .animations = "rom:/meshes/characters/mentor.anim",
+        .mesh = ASSET_ID_MESHES_CHARACTERS_MENTOR_TMESH,
+        .animations = ASSET_ID_MESHES_CHARACTERS_MENTOR_ANIM,
         .collider = {
             .minkowsi_sum = dynamic_object_capsule_minkowski_sum,
             .bounding_box = dynamic_object_capsule_bounding_box,
@@ -49,10 +50,10 @@ void npc_init(struct npc* npc, struct npc_definition* definiton) {
 
     render_scene_add_renderable_single_axis(&npc->renderable, 2.0f);
 
-    update_add(npc, npc_update, 0, UPDATE_LAYER_WORLD);
+    npc->update_id = update_add(npc, npc_update, 0, UPDATE_LAYER_WORLD);
     animator_init(&npc->animator, npc->renderable.armature.bone_count);
 
-    npc->animation_set = information->animations ? animation_cache_load(information->animations) : NULL;
+    npc->animation_set = information->animations != ASSET_ID_NONE ? animation_cache_load_id(information->animations) : NULL;
 
     npc->animations.idle = animation_set_find_clip(npc->animation_set, "mentor_idle");
     animator_run_clip(&npc->animator, npc->animations.idle, 0.0f, true);
@@ -84,7 +85,7 @@ void npc_destroy(struct npc* npc) {
     render_scene_remove(&npc->renderable);
     renderable_single_axis_destroy(&npc->renderable);
     animator_destroy(&npc->animator);
-    update_remove(npc);
+    update_remove(npc->update_id);
     collision_scene_remove(&npc->collider);
     animation_cache_release(npc->animation_set);
     interactable_destroy(&npc->interactable);
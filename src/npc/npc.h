@@ -8,10 +8,12 @@
 #include "../collision/dynamic_object.h"
 #include "../entity/interactable.h"
 #include "../cutscene/cutscene.h"
+#include "../time/time.h"
 
 struct npc_information {
-    char* mesh;
-    char* animations;
+    asset_id mesh;
+    // ASSET_ID_NONE if the npc isn't animated
+    asset_id animations;
     struct dynamic_object_type collider;
     float half_height;
 };
@@ -33,6 +35,7 @@ struct npc {
     struct interactable interactable;
 
     struct cutscene* talk_to_cutscene;
+    update_id update_id;
 };
 
 void npc_init(struct npc* npc, struct npc_definition* definiton);
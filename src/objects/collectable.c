@@ -11,6 +11,7 @@
 #include "../time/time.h"
 
 #include "../menu/dialog_box.h"
+#include "../resource/asset_ids.h"
 
 #define COLLECTABLE_RADIUS  0.75f
 
@@ -29,15 +30,15 @@ static struct dynamic_object_type collectable_collision = {
 static struct hash_map collectable_hash_map;
 
 struct collectable_information {
-    char* mesh_filename;
+    asset_id mesh;
 };
 
 static struct collectable_information collectable_information[] = {
     [COLLECTABLE_TYPE_HEALTH] = {
-        .mesh_filename = "rom:/meshes/objects/pickups/heart.tmesh",
+        .mesh = ASSET_ID_MESHES_OBJECTS_PICKUPS_HEART_TMESH,
     },
     [COLLECTABLE_TYPE_SPELL_RUNE] = {
-        .mesh_filename = "rom:/meshes/objects/pickups/scroll.tmesh",
+        .mesh = ASSET_ID_MESHES_OBJECTS_PICKUPS_SCROLL_TMESH,
     },
 };
 
@@ -63,7 +64,7 @@ void collectable_init(struct collectable* collectable, struct collectable_defini
     struct collectable_information* type = &collectable_information[definition->collectable_type];
 
     collision_scene_add(&collectable->dynamic_object);
-    renderable_single_axis_init(&collectable->renderable, &collectable->transform, type->mesh_filename);
+    renderable_single_axis_init(&collectable->renderable, &collectable->transform, type->mesh);
     render_scene_add_renderable_single_axis(&collectable->renderable, 0.2f);
     
     hash_map_set(&collectable_hash_map, collectable->dynamic_object.entity_id, collectable);
@@ -2,7 +2,9 @@
 
 #include "../render/render_scene.h"
 #include "../time/time.h"
+#include "../time/background.h"
 #include "../collision/collision_scene.h"
+#include "../resource/asset_ids.h"
 
 static struct dynamic_object_type crate_collision_type = {
     .minkowsi_sum = dynamic_object_box_minkowski_sum,
@@ -16,7 +18,8 @@ static struct dynamic_object_type crate_collision_type = {
 
 void crate_update(struct crate* crate) {
     if (crate->health.current_health <= 0.0f) {
-        crate_destroy(crate);
+        // the destroy is done in idle time after the update
+        background_defer(crate, (background_deferred_callback)crate_destroy);
     }
 }
 
@@ -26,7 +29,7 @@ void crate_init(struct crate* crate, struct crate_definition* definition) {
 
     entity_id id = entity_id_new();
 
-    renderable_single_axis_init(&crate->renderable, &crate->transform, "rom:/meshes/objects/crate.tmesh");
+    renderable_single_axis_init(&crate->renderable, &crate->transform, ASSET_ID_MESHES_OBJECTS_CRATE_TMESH);
     dynamic_object_init(
         id, 
         &crate->dynamic_object, 
@@ -36,18 +39,24 @@ void crate_init(struct crate* crate, struct crate_definition* definition) {
         &crate->transform.rotation
     );
 
-    update_add(crate, (update_callback)crate_update, UPDATE_PRIORITY_SPELLS, UPDATE_LAYER_WORLD);
+    crate->update_id = update_add(crate, (update_callback)crate_update, UPDATE_PRIORITY_SPELLS, UPDATE_LAYER_WORLD);
 
     render_scene_add_renderable_single_axis(&crate->renderable, 1.73f);
     collision_scene_add(&crate->dynamic_object);
 
     health_init(&crate->health, id, 10.0f);
+    crate->destroyed = false;
 }
 
 void crate_destroy(struct crate* crate) {
+    if (crate->destroyed) {
+        return;
+    }
+
+    crate->destroyed = true;
     render_scene_remove(&crate->renderable);
     renderable_single_axis_destroy(&crate->renderable);
     collision_scene_remove(&crate->dynamic_object);
     health_destroy(&crate->health);
-    update_remove(crate);
+    update_remove(crate->update_id);
 }
\ No newline at end of file
@@ -7,12 +7,19 @@
 #include "../collision/dynamic_object.h"
 #include "../math/transform_single_axis.h"
 #include "../entity/health.h"
+#include "../time/time.h"
 
 struct crate {
     struct TransformSingleAxis transform;
     struct renderable_single_axis renderable;
     struct dynamic_object dynamic_object;
     struct health health;
+
+    // a crate destroys itself when it breaks, the world still
+    // calls crate_destroy on it when the world is released
+    bool destroyed;
+
+    update_id update_id;
 };
 
 void crate_init(struct crate* crate, struct crate_definition* definition);
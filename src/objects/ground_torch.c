@@ -6,6 +6,7 @@
 #include "../resource/tmesh_cache.h"
 #include "../time/time.h"
 #include "../render/defs.h"
+#include "../resource/asset_ids.h"
 #include <memory.h>
 
 #define TORCH_HEIGHT    0.84124f
@@ -21,7 +22,7 @@ static struct dynamic_object_type ground_torch_collision_type = {
 }
 };
 
-void ground_torch_update(void* data) {
+void ground_torch_update(void* data, float delta) {
     struct ground_torch* torch = (struct ground_torch*)data;
 
     if (health_is_burning(&torch->health)) {
@@ -88,13 +89,13 @@ void ground_torch_init(struct ground_torch* ground_torch, struct ground_torch_de
     ground_torch->dynamic_object.center.y = 0.8f;
     ground_torch->dynamic_object.is_fixed = 1;
 
-    ground_torch->base_mesh = tmesh_cache_load("rom:/meshes/objects/torch.tmesh");
-    ground_torch->flame_mesh = tmesh_cache_load("rom:/meshes/objects/torch_flame.tmesh");
+    ground_torch->base_mesh = tmesh_cache_load_id(ASSET_ID_MESHES_OBJECTS_TORCH_TMESH);
+    ground_torch->flame_mesh = tmesh_cache_load_id(ASSET_ID_MESHES_OBJECTS_TORCH_FLAME_TMESH);
 
     render_scene_add(&ground_torch->position, 1.73f, ground_torch_render, ground_torch);
     collision_scene_add(&ground_torch->dynamic_object);
     health_init(&ground_torch->health, id, 0.0f);
-    update_add(ground_torch, ground_torch_update, 1, UPDATE_LAYER_WORLD);
+    ground_torch->update_id = update_add_interval(ground_torch, ground_torch_update, 1, UPDATE_LAYER_WORLD, UPDATE_INTERVAL_QUARTER);
 
     ground_torch->is_lit = definition->is_lit;
 }
@@ -102,6 +103,6 @@ void ground_torch_init(struct ground_torch* ground_torch, struct ground_torch_de
 void ground_torch_destroy(struct ground_torch* ground_torch) {
     render_scene_remove(ground_torch);
     collision_scene_remove(&ground_torch->dynamic_object);
-    update_remove(ground_torch);
+    update_remove(ground_torch->update_id);
     health_destroy(&ground_torch->health);
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../render/renderable.h"
 #include "../collision/dynamic_object.h"
 #include "../entity/health.h"
+#include "../time/time.h"
 
 struct ground_torch {
     struct Vector3 position;
@@ -16,6 +17,7 @@ struct ground_torch {
     struct health health;
 
     uint16_t is_lit: 1;
+    update_id update_id;
 };
 
 void ground_torch_init(struct ground_torch* ground_torch, struct ground_torch_definition* definition);
@@ -4,6 +4,7 @@
 #include "../render/render_scene.h"
 #include "../time/time.h"
 #include "../spell/assets.h"
+#include "../resource/asset_ids.h"
 #include <stddef.h>
 
 #define DUMMY_BURN_TIME 7.0f
@@ -92,7 +93,7 @@ void training_dummy_init(struct training_dummy* dummy, struct training_dummy_def
     dummy->transform.position = definition->position;
     quatAxisComplex(&gUp, &definition->rotation, &dummy->transform.rotation);
 
-    renderable_init(&dummy->renderable, &dummy->transform, "rom:/meshes/objects/training_dummy.tmesh");
+    renderable_init(&dummy->renderable, &dummy->transform, ASSET_ID_MESHES_OBJECTS_TRAINING_DUMMY_TMESH);
 
     render_scene_add_renderable(&dummy->renderable, 2.0f);
 
@@ -115,7 +116,7 @@ void training_dummy_init(struct training_dummy* dummy, struct training_dummy_def
 
     health_init(&dummy->health, entity_id, 0.0f);
     health_set_callback(&dummy->health, training_dummy_on_hit, dummy);
-    update_add(dummy, training_dummy_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD);
+    dummy->update_id = update_add(dummy, training_dummy_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD);
 
     dummy->burning_effect = NULL;
 }
@@ -129,6 +130,6 @@ void training_dummy_destroy(struct training_dummy* dummy) {
     render_scene_remove(&dummy->renderable);
     renderable_destroy(&dummy->renderable);
     collision_scene_remove(&dummy->collision);
-    update_remove(dummy);
+    update_remove(dummy->update_id);
     health_destroy(&dummy->health);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "../collision/dynamic_object.h"
 #include "../entity/health.h"
 #include "../effects/burning_effect.h"
+#include "../time/time.h"
 
 struct training_dummy {
     struct Transform transform;
@@ -16,6 +17,7 @@ struct training_dummy {
     struct health health;
     struct Vector3 angularVelocity;
     struct burning_effect* burning_effect;
+    update_id update_id;
 };
 
 void training_dummy_init(struct training_dummy* dummy, struct training_dummy_definition* definition);
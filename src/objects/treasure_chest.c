@@ -7,6 +7,7 @@
 #include "../cutscene/cutscene_runner.h"
 #include "../cutscene/show_item.h"
 #include "../player/inventory.h"
+#include "../resource/asset_ids.h"
 
 static struct dynamic_object_type treasure_chest_collision = {
     .minkowsi_sum = dynamic_object_box_minkowski_sum,
@@ -51,9 +52,9 @@ void treasure_chest_interact(struct interactable* interactable, entity_id from)
     treasure_chest->item_type = ITEM_TYPE_NONE;
 }
 
-void treasure_chest_update(void* data) {
+void treasure_chest_update(void* data, float delta) {
     struct treasure_chest* treasure_chest = (struct treasure_chest*)data;
-    animator_update(&treasure_chest->animator, treasure_chest->renderable.armature.pose, fixed_time_step);
+    animator_update(&treasure_chest->animator, treasure_chest->renderable.armature.pose, delta);
 }
 
 void treasure_chest_init(struct treasure_chest* treasure_chest, struct treasure_chest_definition* definition) {
@@ -61,7 +62,7 @@ void treasure_chest_init(struct treasure_chest* treasure_chest, struct treasure_
     treasure_chest->transform.position = definition->position;
     treasure_chest->transform.rotation = definition->rotation;
 
-    renderable_single_axis_init(&treasure_chest->renderable, &treasure_chest->transform, "rom:/meshes/objects/treasurechest.tmesh");
+    renderable_single_axis_init(&treasure_chest->renderable, &treasure_chest->transform, ASSET_ID_MESHES_OBJECTS_TREASURECHEST_TMESH);
     render_scene_add_renderable_single_axis(&treasure_chest->renderable, 0.8f);
 
     entity_id entity_id = entity_id_new();
@@ -82,11 +83,11 @@ void treasure_chest_init(struct treasure_chest* treasure_chest, struct treasure_
 
     interactable_init(&treasure_chest->interactable, entity_id, treasure_chest_interact, treasure_chest);
 
-    treasure_chest->animation_set = animation_cache_load("rom:/meshes/objects/treasurechest.anim");
+    treasure_chest->animation_set = animation_cache_load_id(ASSET_ID_MESHES_OBJECTS_TREASURECHEST_ANIM);
     treasure_chest->animations.open = animation_set_find_clip(treasure_chest->animation_set, "open");
 
     animator_init(&treasure_chest->animator, treasure_chest->renderable.armature.bone_count);
-    update_add(treasure_chest, treasure_chest_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD | UPDATE_LAYER_CUTSCENE);
+    treasure_chest->update_id = update_add_interval(treasure_chest, treasure_chest_update, UPDATE_PRIORITY_EFFECTS, UPDATE_LAYER_WORLD | UPDATE_LAYER_CUTSCENE, UPDATE_INTERVAL_HALF);
 
     if (inventory_has_item(definition->item)) {
         animator_run_clip(&treasure_chest->animator, treasure_chest->animations.open, animation_clip_get_duration(treasure_chest->animations.open), false);
@@ -100,5 +101,5 @@ void treasure_chest_destroy(struct treasure_chest* treasure_chest) {
     collision_scene_remove(&treasure_chest->dynamic_object);
     animator_destroy(&treasure_chest->animator);
     animation_cache_release(treasure_chest->animation_set);
-    update_remove(treasure_chest);
+    update_remove(treasure_chest->update_id);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "../entity/interactable.h"
 #include "../render/animation_clip.h"
 #include "../render/animator.h"
+#include "../time/time.h"
 
 struct treasure_animations {
     struct animation_clip* open;
@@ -22,6 +23,7 @@ struct treasure_chest {
     struct animation_set* animation_set;
     struct treasure_animations animations;
     struct animator animator;
+    update_id update_id;
 };
 
 void treasure_chest_init(struct treasure_chest* treasure_chest, struct treasure_chest_definition* definition);
@@ -65,6 +65,10 @@ void inventory_init() {
     inventory.spell_slots[1] = &dash_spell;
     inventory.spell_slots[2] = &projectile_spell;
 
+    spell_compile(&flame_spell);
+    spell_compile(&dash_spell);
+    spell_compile(&projectile_spell);
+
     for (int i = 0; i < MAX_CUSTOM_SPELLS; i += 1) {
         spell_init(&inventory.custom_spells[i], SPELL_MAX_COLS, SPELL_MAX_ROWS, SPELL_ICON_CUSTOM_0 + i);
     }
@@ -129,6 +133,10 @@ struct spell* inventory_get_equipped_spell(unsigned index) {
 void inventory_set_equipped_spell(unsigned index, struct spell* spell) {
     assert(index < MAX_SPELL_SLOTS);
     inventory.spell_slots[index] = spell;
+
+    if (spell) {
+        spell_compile(spell);
+    }
 }
 
 struct spell* inventory_get_built_in_spell(unsigned x, unsigned y) {
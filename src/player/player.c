@@ -10,6 +10,8 @@
 #include "../objects/collectable.h"
 #include "../entity/interactable.h"
 #include "../resource/tmesh_cache.h"
+#include "../input/input.h"
+#include "../resource/asset_ids.h"
 
 #define PLAYER_MAX_SPEED    4.2f
 
@@ -37,6 +39,14 @@ static struct dynamic_object_type player_visual_shape = {
     }
 };
 
+// the player builds the biggest spells so gets the biggest pool,
+// an old spell is cut short rather than dropping a new cast
+static struct spell_exec_definition player_spell_exec = {
+    .slot_capacity = 16,
+    .modifier_capacity = 32,
+    .evict_oldest = 1,
+};
+
 void player_get_move_basis(struct Transform* transform, struct Vector3* forward, struct Vector3* right) {
     quatMultVector(&transform->rotation, &gForward, forward);
     quatMultVector(&transform->rotation, &gRight, right);
@@ -134,8 +144,8 @@ void player_update(struct player* player) {
     animator_update(&player->animator, player->renderable.armature.pose, playback_speed * fixed_time_step);
     player_get_move_basis(player->camera_transform, &forward, &right);
 
-    joypad_inputs_t input = joypad_get_inputs(0);
-    joypad_buttons_t pressed = joypad_get_buttons_pressed(0);
+    joypad_inputs_t input = input_get_inputs();
+    joypad_buttons_t pressed = input_get_buttons_pressed();
 
     struct Vector2 direction;
 
@@ -212,14 +222,14 @@ void player_init(struct player* player, struct player_definition* definition, st
     entity_id entity_id = entity_id_new();
 
     transformInitIdentity(&player->transform);
-    renderable_init(&player->renderable, &player->transform, "rom:/meshes/characters/apprentice.tmesh");
+    renderable_init(&player->renderable, &player->transform, ASSET_ID_MESHES_CHARACTERS_APPRENTICE_TMESH);
 
     player->camera_transform = camera_transform;
 
     player->transform.position = definition->location;
 
     render_scene_add_renderable(&player->renderable, 2.0f);
-    update_add(player, (update_callback)player_update, UPDATE_PRIORITY_PLAYER, UPDATE_LAYER_WORLD);
+    player->update_id = update_add(player, (update_callback)player_update, UPDATE_PRIORITY_PLAYER, UPDATE_LAYER_WORLD);
 
     player->look_direction = definition->rotation;
 
@@ -240,17 +250,18 @@ void player_init(struct player* player, struct player_definition* definition, st
 
     collision_scene_add(&player->collision);
 
-    spell_exec_init(&player->spell_exec);
+    spell_exec_init(&player->spell_exec, &player_spell_exec);
 
     for (int i = 0; i < PLAYER_CAST_SOURCE_COUNT; i += 1) {
         struct spell_data_source* source = &player->player_spell_sources[i];
 
         source->flags.all = 0;
+        source->pool = NULL;
         source->reference_count = 1;
         source->target = entity_id;
     }
 
-    player->animation_set = animation_cache_load("rom:/meshes/characters/apprentice.anim");
+    player->animation_set = animation_cache_load_id(ASSET_ID_MESHES_CHARACTERS_APPRENTICE_ANIM);
     player->animations.attack = animation_set_find_clip(player->animation_set, "attack1");
     player->animations.idle = animation_set_find_clip(player->animation_set, "idle");
     player->animations.run = animation_set_find_clip(player->animation_set, "run");
@@ -259,7 +270,7 @@ void player_init(struct player* player, struct player_definition* definition, st
 
     animator_run_clip(&player->animator, player->animations.idle, 0.0f, true);
 
-    player->assets.staffs[0] = tmesh_cache_load("rom:/meshes/objects/staff_default.tmesh");
+    player->assets.staffs[0] = tmesh_cache_load_id(ASSET_ID_MESHES_OBJECTS_STAFF_DEFAULT_TMESH);
     player->assets.staffs[1] = NULL;
     player->assets.staffs[2] = NULL;
     player->assets.staffs[3] = NULL;
@@ -270,7 +281,7 @@ void player_destroy(struct player* player) {
     spell_exec_destroy(&player->spell_exec);
 
     render_scene_remove(&player->renderable);
-    update_remove(player);
+    update_remove(player->update_id);
     collision_scene_remove(&player->collision);
     animation_cache_release(player->animation_set);
     animator_destroy(&player->animator);
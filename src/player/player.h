@@ -13,6 +13,7 @@
 #include "../spell/spell_exec.h"
 
 #include "inventory.h"
+#include "../time/time.h"
 
 #define PLAYER_CAST_SOURCE_COUNT    4
 
@@ -46,6 +47,7 @@ struct player {
     struct player_animations animations;
     struct animator animator;
     struct inventory_assets assets;
+    update_id update_id;
 };
 
 void player_init(struct player* player, struct player_definition* definition, struct Transform* camera_transform);
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <malloc.h>
 #include <libdragon.h>
+#include "../util/memory_tag.h"
 
 struct animation_set_header {
     uint16_t clip_count;
@@ -27,7 +28,7 @@ struct animation_clip_header {
 // dfs_rom_addr
 
 struct animation_set* animation_set_load(const char* filename) {
-    struct animation_set* result = malloc(sizeof(struct animation_set));
+    struct animation_set* result = tagged_malloc(MEMORY_TAG_ANIMATION, sizeof(struct animation_set));
 
     assert(strncmp(filename, "rom:/", 5) == 0);
     filename += 5;
@@ -53,13 +54,13 @@ struct animation_set* animation_set_load(const char* filename) {
     struct animation_clip_header clip_headers[header.clip_count];
     dfs_read(clip_headers, sizeof(struct animation_clip_header), header.clip_count, file);
 
-    result->clips = malloc(sizeof(struct animation_clip) * header.clip_count);
+    result->clips = tagged_malloc(MEMORY_TAG_ANIMATION, sizeof(struct animation_clip) * header.clip_count);
 
     int attibute_buffer_size = sizeof(struct animation_used_attributes) * header.bone_count * header.clip_count;
-    struct animation_used_attributes* attributes_buffer = malloc(attibute_buffer_size);
+    struct animation_used_attributes* attributes_buffer = tagged_malloc(MEMORY_TAG_ANIMATION, attibute_buffer_size);
     dfs_read(attributes_buffer, attibute_buffer_size, 1, file);
     
-    char* text_buffer = malloc(header.name_buffer_length);
+    char* text_buffer = tagged_malloc(MEMORY_TAG_ANIMATION, header.name_buffer_length);
     dfs_read(text_buffer, header.name_buffer_length, 1, file);
 
     uint32_t start_address = dfs_rom_addr(filename);
@@ -105,12 +106,12 @@ void annotation_clip_set_free(struct animation_set* animation_set) {
     }
 
     if (animation_set->clip_count > 0) {
-        free(animation_set->clips[0].name);
-        free(animation_set->clips[0].used_bone_attributes);
-        free(animation_set->clips);
+        tagged_free(animation_set->clips[0].name);
+        tagged_free(animation_set->clips[0].used_bone_attributes);
+        tagged_free(animation_set->clips);
     }
 
-    free(animation_set);
+    tagged_free(animation_set);
 }
 
 struct animation_clip* animation_set_find_clip(struct animation_set* set, const char* clip_name) {
@@ -4,6 +4,7 @@
 #include <malloc.h>
 #include "../math/transform.h"
 #include "../math/mathf.h"
+#include "../scene/world_arena.h"
 
 #define MAX_ANIMATION_QUEUE_ENTRIES 20
 
@@ -18,8 +19,8 @@ void animator_init(struct animator* animator, int bone_count) {
     animator->current_time = 0.0f;
     animator->blend_lerp = 0.0f;
     int bone_state_size = ALIGN_UP(sizeof(struct armature_packed_transform) * bone_count + sizeof(uint16_t));
-    animator->bone_state[0] = malloc(bone_state_size);
-    animator->bone_state[1] = malloc(bone_state_size);
+    animator->bone_state[0] = world_malloc(bone_state_size);
+    animator->bone_state[1] = world_malloc(bone_state_size);
     data_cache_hit_writeback(animator->bone_state[0], bone_state_size);
     data_cache_hit_writeback(animator->bone_state[1], bone_state_size);
     animator->bone_state_frames[0] = -1;
@@ -30,8 +31,8 @@ void animator_init(struct animator* animator, int bone_count) {
 }
 
 void animator_destroy(struct animator* animator) {
-    free(animator->bone_state[0]);
-    free(animator->bone_state[1]);
+    world_free(animator->bone_state[0]);
+    world_free(animator->bone_state[1]);
 
     animator->bone_state[0] = NULL;
     animator->bone_state[1] = NULL;
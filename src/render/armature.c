@@ -4,6 +4,8 @@
 #include <memory.h>
 #include <math.h>
 #include "../math/matrix.h"
+#include "../scene/world_arena.h"
+#include "../util/memory_tag.h"
 
 #define POSITION_SCALE      (1.0f / 256.0f)
 #define QUATERNION_SCALE    (1.0f / 32767.0f)
@@ -29,8 +31,8 @@ void armature_definition_init(struct armature_definition* definition, int bone_c
     definition->bone_count = bone_count;
 
     if (bone_count) {
-        definition->parent_linkage = malloc(sizeof(uint8_t) * bone_count);
-        definition->default_pose = malloc(sizeof(struct armature_packed_transform) * bone_count);
+        definition->parent_linkage = tagged_malloc(MEMORY_TAG_MESH, sizeof(uint8_t) * bone_count);
+        definition->default_pose = tagged_malloc(MEMORY_TAG_MESH, sizeof(struct armature_packed_transform) * bone_count);
     } else {
         definition->parent_linkage = 0;
         definition->default_pose = 0;
@@ -38,8 +40,8 @@ void armature_definition_init(struct armature_definition* definition, int bone_c
 }
 
 void armature_definition_destroy(struct armature_definition* definition) {
-    free(definition->default_pose);
-    free(definition->parent_linkage);
+    tagged_free(definition->default_pose);
+    tagged_free(definition->parent_linkage);
     definition->default_pose = 0;
     definition->parent_linkage = 0;
 }
@@ -48,8 +50,8 @@ void armature_init(struct armature* armature, struct armature_definition* defini
     armature->bone_count = definition ? definition->bone_count : 0;
 
     if (armature->bone_count) {
-        armature->parent_linkage = malloc(sizeof(uint8_t) * definition->bone_count);
-        armature->pose = malloc(sizeof(struct Transform) * definition->bone_count);
+        armature->parent_linkage = world_malloc(sizeof(uint8_t) * definition->bone_count);
+        armature->pose = world_malloc(sizeof(struct Transform) * definition->bone_count);
 
         memcpy(armature->parent_linkage, definition->parent_linkage, sizeof(uint8_t) * definition->bone_count);
 
@@ -63,8 +65,8 @@ void armature_init(struct armature* armature, struct armature_definition* defini
 }
 
 void armature_destroy(struct armature* armature) {
-    free(armature->pose);
-    free(armature->parent_linkage);
+    world_free(armature->pose);
+    world_free(armature->parent_linkage);
     armature->pose = 0;
     armature->parent_linkage = 0;
 }
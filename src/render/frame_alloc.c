@@ -1,24 +1,167 @@
-
 #include <libdragon.h>
 #include <stddef.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
 #include "frame_alloc.h"
 
+// keeps every allocation aligned to 16 bytes
+#define FRAME_WORDS(bytes)  ((((bytes) + 15) >> 4) << 1)
+
+void frame_pool_init(struct frame_memory_pool* pool, int bytes) {
+    pool->word_count = FRAME_WORDS(bytes);
+    // malloc() is done with memalign
+    pool->memory = memalign(16, pool->word_count * sizeof(uint64_t));
+    data_cache_hit_writeback_invalidate(pool->memory, pool->word_count * sizeof(uint64_t));
+    pool->current_word = 0;
+    pool->overflow = NULL;
+    pool->current_overflow = NULL;
+    memset(&pool->stats, 0, sizeof(struct frame_memory_stats));
+}
+
+void frame_pool_destroy(struct frame_memory_pool* pool) {
+    free(pool->memory);
+    pool->memory = NULL;
+    pool->word_count = 0;
+
+    struct frame_overflow_block* current = pool->overflow;
+
+    while (current) {
+        struct frame_overflow_block* next = current->next;
+        // malloc() is done with memalign
+        free(current);
+        current = next;
+    }
+
+    pool->overflow = NULL;
+    pool->current_overflow = NULL;
+}
+
+void frame_pool_resize(struct frame_memory_pool* pool, int bytes) {
+    if (pool->memory && pool->word_count == FRAME_WORDS(bytes)) {
+        return;
+    }
+
+    frame_pool_destroy(pool);
+    frame_pool_init(pool, bytes);
+}
+
+static int frame_pool_overflow_bytes(struct frame_memory_pool* pool) {
+    int result = 0;
+
+    for (struct frame_overflow_block* block = pool->overflow; block; block = block->next) {
+        result += block->current_word * sizeof(uint64_t);
+
+        if (block == pool->current_overflow) {
+            break;
+        }
+    }
+
+    return result;
+}
+
 void frame_pool_reset(struct frame_memory_pool* pool) {
+    struct frame_memory_stats* stats = &pool->stats;
+    int used_bytes = pool->current_word * sizeof(uint64_t);
+
+    if (pool->current_overflow) {
+        stats->overflow_bytes = frame_pool_overflow_bytes(pool);
+        stats->overflow_frames += 1;
+        used_bytes += stats->overflow_bytes;
+    } else {
+        stats->overflow_bytes = 0;
+    }
+
+    stats->last_frame_bytes = used_bytes;
+
+    if (used_bytes > stats->peak_bytes) {
+        int capacity = pool->word_count * sizeof(uint64_t);
+
+        // only warn when a new peak is reached to avoid spamming the log
+        if (used_bytes * 100 >= capacity * FRAME_MEMORY_WARNING_PERCENT) {
+            fprintf(
+                stderr, 
+                "frame_alloc: %d of %d bytes used (%d overflowed)\n", 
+                used_bytes, 
+                capacity, 
+                stats->overflow_bytes
+            );
+        }
+
+        stats->peak_bytes = used_bytes;
+    }
+
+    for (struct frame_overflow_block* block = pool->overflow; block; block = block->next) {
+        block->current_word = 0;
+    }
+
     pool->current_word = 0;
+    pool->current_overflow = NULL;
 }
 
-void* frame_malloc(struct frame_memory_pool* pool, int bytes) {
-    if (pool->current_word >= FRAME_WORD_COUNT) {
+static struct frame_overflow_block* frame_pool_next_overflow(struct frame_memory_pool* pool, int word_count) {
+    struct frame_overflow_block* block = pool->current_overflow ? pool->current_overflow->next : pool->overflow;
+    struct frame_overflow_block* prev = pool->current_overflow;
+
+    // reuse blocks from previous frames that are large enough
+    while (block && block->word_count < word_count) {
+        prev = block;
+        block = block->next;
+    }
+
+    if (block) {
+        return block;
+    }
+
+    int block_words = FRAME_WORDS(FRAME_OVERFLOW_BLOCK_SIZE);
+
+    if (word_count > block_words) {
+        block_words = word_count;
+    }
+
+    block = memalign(16, sizeof(struct frame_overflow_block) + block_words * sizeof(uint64_t));
+
+    if (!block) {
         return NULL;
     }
 
-    void* result = &pool->memory[pool->current_word];
-    pool->current_word += (bytes + 7) >> 3;
+    data_cache_hit_writeback_invalidate(block->memory, block_words * sizeof(uint64_t));
+    block->next = NULL;
+    block->word_count = block_words;
+    block->current_word = 0;
+
+    if (prev) {
+        prev->next = block;
+    } else {
+        pool->overflow = block;
+    }
+
+    return block;
+}
+
+void* frame_malloc(struct frame_memory_pool* pool, int bytes) {
+    int word_count = FRAME_WORDS(bytes);
 
-    // align to 16 bytes
-    if (pool->current_word & 1) {
-        pool->current_word += 1;
+    if (!pool->current_overflow && pool->current_word + word_count <= pool->word_count) {
+        void* result = &pool->memory[pool->current_word];
+        pool->current_word += word_count;
+        return result;
     }
 
+    struct frame_overflow_block* block = pool->current_overflow;
+
+    if (!block || block->current_word + word_count > block->word_count) {
+        block = frame_pool_next_overflow(pool, word_count);
+
+        if (!block) {
+            pool->stats.failed_allocations += 1;
+            return NULL;
+        }
+
+        pool->current_overflow = block;
+    }
+
+    void* result = &block->memory[block->current_word];
+    block->current_word += word_count;
     return result;
-}
\ No newline at end of file
+}
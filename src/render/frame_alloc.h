@@ -3,15 +3,43 @@
 
 #include <stdint.h>
 
-#define FRAME_MEMORY_SIZE   32 * 1024
-#define FRAME_WORD_COUNT    (FRAME_MEMORY_SIZE / sizeof(uint64_t))
+#define FRAME_MEMORY_SIZE           32 * 1024
+#define FRAME_OVERFLOW_BLOCK_SIZE   8 * 1024
+// usage above this percent of the pool logs a warning
+#define FRAME_MEMORY_WARNING_PERCENT    90
+
+struct frame_overflow_block {
+    struct frame_overflow_block* next;
+    uint16_t word_count;
+    uint16_t current_word;
+    uint64_t memory[] __attribute__((aligned(16)));
+};
+
+struct frame_memory_stats {
+    uint32_t last_frame_bytes;
+    uint32_t peak_bytes;
+    uint32_t overflow_bytes;
+    uint16_t overflow_frames;
+    uint16_t failed_allocations;
+};
 
 struct frame_memory_pool {
-    uint64_t memory[FRAME_WORD_COUNT];
+    uint64_t* memory;
+    uint16_t word_count;
     uint16_t current_word;
-} __attribute__((aligned(16)));
+    // blocks borrowed from the heap when memory runs out
+    // they are kept around for the next overflowing frame
+    struct frame_overflow_block* overflow;
+    struct frame_overflow_block* current_overflow;
+    struct frame_memory_stats stats;
+};
+
+void frame_pool_init(struct frame_memory_pool* pool, int bytes);
+void frame_pool_destroy(struct frame_memory_pool* pool);
+// the pool must not be in use by the RSP or RDP when resizing
+void frame_pool_resize(struct frame_memory_pool* pool, int bytes);
 
 void frame_pool_reset(struct frame_memory_pool* pool);
 void* frame_malloc(struct frame_memory_pool* pool, int bytes);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,74 @@
+#include "interpolation.h"
+
+#include "../time/time.h"
+
+#define NO_TICK 0xFFFFFFFF
+// transforms that weren't rendered for longer than this snap
+#define MAX_INTERPOLATION_SPAN  4
+
+// the rendered time is one tick behind the simulation so
+// the blend doesn't have to extrapolate
+static float interpolation_lerp(uint16_t span) {
+    if (!span) {
+        return 1.0f;
+    }
+
+    return (span - 1 + render_interpolation) / span;
+}
+
+void transform_history_reset(struct transform_history* history) {
+    history->tick = NO_TICK;
+}
+
+void transform_history_sample(struct transform_history* history, struct Transform* transform, struct Transform* out) {
+    if (history->tick == NO_TICK) {
+        history->current = *transform;
+        history->tick = update_tick;
+        history->span = 0;
+    }
+
+    if (history->tick != update_tick) {
+        // if more than one tick passed since the last render the
+        // blend starts from the state that was last rendered
+        history->previous = history->current;
+        history->current = *transform;
+        history->span = update_tick - history->tick;
+        history->tick = update_tick;
+    }
+
+    if (!history->span || history->span > MAX_INTERPOLATION_SPAN) {
+        *out = history->current;
+        return;
+    }
+
+    transformLerp(&history->previous, &history->current, interpolation_lerp(history->span), out);
+}
+
+void transform_sa_history_reset(struct transform_sa_history* history) {
+    history->tick = NO_TICK;
+}
+
+void transform_sa_history_sample(struct transform_sa_history* history, struct TransformSingleAxis* transform, struct TransformSingleAxis* out) {
+    if (history->tick == NO_TICK) {
+        history->current = *transform;
+        history->tick = update_tick;
+        history->span = 0;
+    }
+
+    if (history->tick != update_tick) {
+        history->previous = history->current;
+        history->current = *transform;
+        history->span = update_tick - history->tick;
+        history->tick = update_tick;
+    }
+
+    if (!history->span || history->span > MAX_INTERPOLATION_SPAN) {
+        *out = history->current;
+        return;
+    }
+
+    float t = interpolation_lerp(history->span);
+    vector3Lerp(&history->previous.position, &history->current.position, t, &out->position);
+    vector2Lerp(&history->previous.rotation, &history->current.rotation, t, &out->rotation);
+    vector2Normalize(&out->rotation, &out->rotation);
+}
@@ -0,0 +1,32 @@
+#ifndef __RENDER_INTERPOLATION_H__
+#define __RENDER_INTERPOLATION_H__
+
+#include <stdint.h>
+#include "../math/transform.h"
+#include "../math/transform_single_axis.h"
+
+// keeps the transform from the last two simulation ticks that were
+// rendered so rendering can blend between them using render_interpolation
+struct transform_history {
+    struct Transform previous;
+    struct Transform current;
+    uint32_t tick;
+    // the number of ticks between previous and current
+    uint16_t span;
+};
+
+struct transform_sa_history {
+    struct TransformSingleAxis previous;
+    struct TransformSingleAxis current;
+    uint32_t tick;
+    uint16_t span;
+};
+
+// the next sample snaps to the transform, used after teleporting
+void transform_history_reset(struct transform_history* history);
+void transform_history_sample(struct transform_history* history, struct Transform* transform, struct Transform* out);
+
+void transform_sa_history_reset(struct transform_sa_history* history);
+void transform_sa_history_sample(struct transform_sa_history* history, struct TransformSingleAxis* transform, struct TransformSingleAxis* out);
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <t3d/t3d.h>
 #include "../resource/sprite_cache.h"
+#include "../util/memory_tag.h"
 
 void material_init(struct material* material) {
     material->block = 0;
@@ -26,7 +27,7 @@ void material_destroy(struct material* material) {
         sprite_cache_release(material->tex1.sprite);
     }
     rspq_block_free(material->block);
-    free(material->palette.tlut);
+    tagged_free(material->palette.tlut);
     material->palette.tlut = 0;
 }
 
@@ -221,7 +222,7 @@ void material_load(struct material* into, FILE* material_file) {
                 {
                     fread(&into->palette.idx, 2, 1, material_file);
                     fread(&into->palette.size, 2, 1, material_file);
-                    into->palette.tlut = malloc(sizeof(uint16_t) * into->palette.size);
+                    into->palette.tlut = tagged_malloc(MEMORY_TAG_MATERIAL, sizeof(uint16_t) * into->palette.size);
                     rdpq_tex_upload_tlut(into->palette.tlut, into->palette.idx, into->palette.size);
                 }
                 break;
@@ -4,6 +4,7 @@
 #include <malloc.h>
 #include <stdbool.h>
 #include "defs.h"
+#include "../time/frame_profile.h"
 
 #define MIN_RENDER_SCENE_SIZE   64
 
@@ -32,8 +33,11 @@ void render_scene_render_renderable(void* data, struct render_batch* batch) {
         return;
     }
 
+    struct Transform transform;
+    transform_history_sample(&renderable->history, renderable->transform, &transform);
+
     mat4x4 mtx;
-    transformToMatrix(renderable->transform, mtx);
+    transformToMatrix(&transform, mtx);
     mtx[3][0] *= SCENE_SCALE;
     mtx[3][1] *= SCENE_SCALE;
     mtx[3][2] *= SCENE_SCALE;
@@ -55,8 +59,11 @@ void render_scene_render_renderable_single_axis(void* data, struct render_batch*
         return;
     }
 
+    struct TransformSingleAxis transform;
+    transform_sa_history_sample(&renderable->history, renderable->transform, &transform);
+
     mat4x4 mtx;
-    transformSAToMatrix(renderable->transform, mtx);
+    transformSAToMatrix(&transform, mtx);
     mtx[3][0] *= SCENE_SCALE;
     mtx[3][1] *= SCENE_SCALE;
     mtx[3][2] *= SCENE_SCALE;
@@ -91,6 +98,7 @@ void render_scene_render(struct Camera* camera, T3DViewport* viewport, struct fr
     struct ClippingPlanes clipping_planes;
     mat4x4 view_proj_matrix;
 
+    FRAME_PROFILE_BEGIN(FRAME_ZONE_RENDER_SCENE);
     camera_apply(camera, viewport, &clipping_planes, view_proj_matrix);
 
     t3d_viewport_attach(viewport);
@@ -106,4 +114,5 @@ void render_scene_render(struct Camera* camera, T3DViewport* viewport, struct fr
         current = callback_list_next(&r_scene_3d.callbacks, current);
     }
     render_batch_finish(&batch, view_proj_matrix, viewport);
+    FRAME_PROFILE_END(FRAME_ZONE_RENDER_SCENE);
 }
\ No newline at end of file
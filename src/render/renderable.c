@@ -1,16 +1,18 @@
 #include "renderable.h"
 
 #include "../resource/tmesh_cache.h"
+#include "../scene/world_arena.h"
 #include <stddef.h>
 
-void renderable_init(struct renderable* renderable, struct Transform* transform, const char* mesh_filename) {
+void renderable_init(struct renderable* renderable, struct Transform* transform, asset_id mesh) {
     renderable->transform = transform;
-    renderable->mesh = tmesh_cache_load(mesh_filename);
+    renderable->mesh = tmesh_cache_load_id(mesh);
     renderable->force_material = NULL;
+    transform_history_reset(&renderable->history);
     armature_init(&renderable->armature, &renderable->mesh->armature);
 
     if (renderable->mesh->attatchment_count) {
-        renderable->attachments = malloc(sizeof(struct tmesh*) * renderable->mesh->attatchment_count);
+        renderable->attachments = world_malloc(sizeof(struct tmesh*) * renderable->mesh->attatchment_count);
         memset(renderable->attachments, 0, sizeof(struct tmesh*) * renderable->mesh->attatchment_count);
     } else {
         renderable->attachments = NULL;
@@ -19,18 +21,19 @@ void renderable_init(struct renderable* renderable, struct Transform* transform,
 
 void renderable_destroy(struct renderable* renderable) {
     tmesh_cache_release(renderable->mesh);
-    free(renderable->attachments);
+    world_free(renderable->attachments);
     renderable->mesh = NULL;
 }
 
-void renderable_single_axis_init(struct renderable_single_axis* renderable, struct TransformSingleAxis* transform, const char* mesh_filename) {
+void renderable_single_axis_init(struct renderable_single_axis* renderable, struct TransformSingleAxis* transform, asset_id mesh) {
     renderable->transform = transform;
-    renderable->mesh = tmesh_cache_load(mesh_filename);
+    renderable->mesh = tmesh_cache_load_id(mesh);
     renderable->force_material = NULL;
+    transform_sa_history_reset(&renderable->history);
     armature_init(&renderable->armature, &renderable->mesh->armature);
 
     if (renderable->mesh->attatchment_count) {
-        renderable->attachments = malloc(sizeof(struct tmesh*) * renderable->mesh->attatchment_count);
+        renderable->attachments = world_malloc(sizeof(struct tmesh*) * renderable->mesh->attatchment_count);
         memset(renderable->attachments, 0, sizeof(struct tmesh*) * renderable->mesh->attatchment_count);
     } else {
         renderable->attachments = NULL;
@@ -39,6 +42,6 @@ void renderable_single_axis_init(struct renderable_single_axis* renderable, stru
 
 void renderable_single_axis_destroy(struct renderable_single_axis* renderable) {
     tmesh_cache_release(renderable->mesh);
-    free(renderable->attachments);
+    world_free(renderable->attachments);
     renderable->mesh = NULL;
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "../math/transform.h"
 #include "../math/transform_single_axis.h"
 #include "armature.h"
+#include "interpolation.h"
+#include "../resource/asset_manifest.h"
 
 struct renderable {
     struct Transform* transform;
@@ -11,9 +13,10 @@ struct renderable {
     struct armature armature;
     struct material* force_material;
     struct tmesh** attachments;
+    struct transform_history history;
 };
 
-void renderable_init(struct renderable* renderable, struct Transform* transform, const char* mesh_filename);
+void renderable_init(struct renderable* renderable, struct Transform* transform, asset_id mesh);
 void renderable_destroy(struct renderable* renderable);
 
 struct renderable_single_axis {
@@ -22,9 +25,10 @@ struct renderable_single_axis {
     struct armature armature;
     struct material* force_material;
     struct tmesh** attachments;
+    struct transform_sa_history history;
 };
 
-void renderable_single_axis_init(struct renderable_single_axis* renderable, struct TransformSingleAxis* transform, const char* mesh_filename);
+void renderable_single_axis_init(struct renderable_single_axis* renderable, struct TransformSingleAxis* transform, asset_id mesh);
 void renderable_single_axis_destroy(struct renderable_single_axis* renderable);
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "tmesh.h"
 
 #include "../resource/material_cache.h"
+#include "../util/memory_tag.h"
 
 // T3MS
 #define EXPECTED_HEADER 0x54334D53
@@ -37,7 +38,7 @@ void tmesh_load_attachment(struct armature_attatchment* attatchment, FILE* file)
     uint8_t str_len;
     fread(&str_len, 1, 1, file);
 
-    attatchment->name = malloc(str_len + 1);
+    attatchment->name = tagged_malloc(MEMORY_TAG_MESH, str_len + 1);
     fread(attatchment->name, 1, str_len, file);
     attatchment->name[str_len] = '\0';
 
@@ -82,7 +83,7 @@ void tmesh_load(struct tmesh* tmesh, FILE* file) {
     // load vertices
 
     fread(&tmesh->vertex_count, sizeof(uint16_t), 1, file);
-    tmesh->vertices = malloc(sizeof(T3DVertPacked) * tmesh->vertex_count);
+    tmesh->vertices = tagged_malloc(MEMORY_TAG_MESH, sizeof(T3DVertPacked) * tmesh->vertex_count);
     fread(&tmesh->vertices[0], sizeof(T3DVertPacked), tmesh->vertex_count, file);
     data_cache_hit_writeback(&tmesh->vertices[0], sizeof(T3DVertPacked) * tmesh->vertex_count);
 
@@ -93,7 +94,7 @@ void tmesh_load(struct tmesh* tmesh, FILE* file) {
     tmesh->material_transition_count = transition_count;
 
     if (transition_count) {
-        tmesh->transition_materials = malloc(sizeof(struct material) * transition_count);
+        tmesh->transition_materials = tagged_malloc(MEMORY_TAG_MESH, sizeof(struct material) * transition_count);
 
         for (int i = 0; i < transition_count; i += 1) {
             material_load(&tmesh->transition_materials[i], file);
@@ -112,7 +113,7 @@ void tmesh_load(struct tmesh* tmesh, FILE* file) {
     fread(tmesh->armature.default_pose, sizeof(struct armature_packed_transform), bone_count, file);
 
     if (bone_count) {
-        tmesh->armature_pose = malloc(sizeof(T3DMat4FP) * bone_count);
+        tmesh->armature_pose = tagged_malloc(MEMORY_TAG_MESH, sizeof(T3DMat4FP) * bone_count);
         armature_def_apply(&tmesh->armature, tmesh->armature_pose);
     } else {
         tmesh->armature_pose = NULL;
@@ -122,7 +123,7 @@ void tmesh_load(struct tmesh* tmesh, FILE* file) {
     fread(&tmesh->attatchment_count, 2, 1, file);
 
     if (tmesh->attatchment_count) {
-        tmesh->attatchments = malloc(sizeof(struct armature_attatchment) * tmesh->attatchment_count);
+        tmesh->attatchments = tagged_malloc(MEMORY_TAG_MESH, sizeof(struct armature_attatchment) * tmesh->attatchment_count);
 
         for (int i = 0; i < tmesh->attatchment_count; i += 1) {
             struct armature_attatchment* attatchment = &tmesh->attatchments[i];
@@ -211,8 +212,8 @@ void tmesh_load(struct tmesh* tmesh, FILE* file) {
 
 void tmesh_release(struct tmesh* tmesh) {
     rspq_block_free(tmesh->block);
-    free(tmesh->vertices);
-    free(tmesh->armature_pose);
+    tagged_free(tmesh->vertices);
+    tagged_free(tmesh->armature_pose);
 
     if (tmesh->material) {
         material_cache_release(tmesh->material);
@@ -223,13 +224,13 @@ void tmesh_release(struct tmesh* tmesh) {
             material_release(&tmesh->transition_materials[i]);
         }
 
-        free(tmesh->transition_materials);
+        tagged_free(tmesh->transition_materials);
     }
 
     if (tmesh->attatchments) {
         for (int i = 0; i < tmesh->attatchment_count; i += 1) {
-            free(tmesh->attatchments[i].name);
+            tagged_free(tmesh->attatchments[i].name);
         }
-        free(tmesh->attatchments);
+        tagged_free(tmesh->attatchments);
     }
 }
\ No newline at end of file
@@ -2,19 +2,42 @@
 
 #include "resource_cache.h"
 
-static struct resource_cache animation_resource_cache;
+#define ANIMATION_CACHE_ZOMBIE_BUDGET   (16 * 1024)
 
+static void animation_cache_destroy(void* resource) {
+    annotation_clip_set_free(resource);
+}
+
+static struct resource_cache animation_resource_cache = {
+    .name = "animation",
+    .destroy = animation_cache_destroy,
+    .zombie_budget = ANIMATION_CACHE_ZOMBIE_BUDGET,
+    .asset_type = ASSET_TYPE_ANIMATION,
+};
+
+static uint32_t animation_cache_size(struct animation_set* animations) {
+    // the frames themselves are streamed from rom
+    return sizeof(struct animation_set) + 
+        animations->clip_count * (sizeof(struct animation_clip) + sizeof(struct animation_used_attributes) * animations->bone_count);
+}
+
+// returns a reference the caller gives back with animation_cache_release()
 struct animation_set* animation_cache_load(const char* filename) {
-    struct resource_cache_entry* entry = resource_cache_use(&animation_resource_cache, filename);
+    return animation_cache_load_id(asset_manifest_require(filename));
+}
+
+// returns a reference the caller gives back with animation_cache_release()
+struct animation_set* animation_cache_load_id(asset_id id) {
+    struct resource_cache_entry* entry = resource_cache_use(&animation_resource_cache, id);
 
     if (!entry->resource) {
-        entry->resource = animation_set_load(filename);
+        struct animation_set* animations = animation_set_load(asset_manifest_path(id));
+        resource_cache_loaded(&animation_resource_cache, entry, animations, animation_cache_size(animations));
     }
 
     return entry->resource;
 }
+
 void animation_cache_release(struct animation_set* animations) {
-    if (resource_cache_free(&animation_resource_cache, animations)) {
-        annotation_clip_set_free(animations);
-    }
-}
\ No newline at end of file
+    resource_cache_free(&animation_resource_cache, animations);
+}
@@ -2,8 +2,10 @@
 #define __RESOURCE_ANIMATION_CACHE_H__
 
 #include "../render/animation_clip.h"
+#include "asset_manifest.h"
 
 struct animation_set* animation_cache_load(const char* filename);
+struct animation_set* animation_cache_load_id(asset_id id);
 void animation_cache_release(struct animation_set* animations);
 
 #endif
\ No newline at end of file
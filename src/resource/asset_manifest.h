@@ -0,0 +1,41 @@
+#ifndef __RESOURCE_ASSET_MANIFEST_H__
+#define __RESOURCE_ASSET_MANIFEST_H__
+
+#include <stdint.h>
+
+typedef uint16_t asset_id;
+
+#define ASSET_ID_NONE   0xFFFF
+
+enum asset_type {
+    ASSET_TYPE_SPRITE,
+    ASSET_TYPE_TMESH,
+    ASSET_TYPE_MATERIAL,
+    ASSET_TYPE_FONT,
+    ASSET_TYPE_ANIMATION,
+    ASSET_TYPE_OTHER,
+
+    ASSET_TYPE_COUNT,
+};
+
+// assets of the same type have contiguous ids
+struct asset_range {
+    asset_id first;
+    uint16_t count;
+};
+
+// these are generated from the filesystem by tools/asset_manifest.py
+extern const uint16_t asset_manifest_count;
+extern const char* const asset_manifest_paths[];
+extern const struct asset_range asset_manifest_ranges[ASSET_TYPE_COUNT];
+extern const uint16_t asset_manifest_bucket_count;
+extern const uint16_t asset_manifest_displacements[];
+extern const asset_id asset_manifest_slots[];
+
+// returns ASSET_ID_NONE if path is not in the rom filesystem
+asset_id asset_manifest_find(const char* path);
+// same as asset_manifest_find but logs the path when it is missing
+asset_id asset_manifest_require(const char* path);
+const char* asset_manifest_path(asset_id id);
+
+#endif
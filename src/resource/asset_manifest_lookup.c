@@ -0,0 +1,55 @@
+#include "asset_manifest.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+// must match asset_hash in tools/asset_manifest.py
+static uint32_t asset_manifest_hash(uint32_t seed, const char* path) {
+    uint32_t hash = 2166136261u ^ seed;
+
+    for (const unsigned char* p = (const unsigned char*)path; *p != '\0'; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+asset_id asset_manifest_find(const char* path) {
+    if (!asset_manifest_count) {
+        return ASSET_ID_NONE;
+    }
+
+    uint32_t bucket = asset_manifest_hash(0, path) % asset_manifest_bucket_count;
+    uint32_t slot = asset_manifest_hash(asset_manifest_displacements[bucket], path) % asset_manifest_count;
+    asset_id result = asset_manifest_slots[slot];
+
+    // the perfect hash maps any string to some slot so check it is the right one
+    if (strcmp(asset_manifest_paths[result], path) != 0) {
+        return ASSET_ID_NONE;
+    }
+
+    return result;
+}
+
+asset_id asset_manifest_require(const char* path) {
+    asset_id result = asset_manifest_find(path);
+
+    if (result == ASSET_ID_NONE) {
+        fprintf(stderr, "asset_manifest: %s is not in the rom filesystem\n", path);
+    }
+
+    return result;
+}
+
+const char* asset_manifest_path(asset_id id) {
+    assert(id < asset_manifest_count);
+    return asset_manifest_paths[id];
+}
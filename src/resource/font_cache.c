@@ -2,20 +2,36 @@
 
 #include "resource_cache.h"
 
-static struct resource_cache font_resource_cache;
+// fonts are only loaded by name so their size isn't known
+// this is an estimate of a typical font64 file
+#define FONT_CACHE_ESTIMATED_SIZE   (16 * 1024)
+#define FONT_CACHE_ZOMBIE_BUDGET    (32 * 1024)
+
+static void font_cache_destroy(void* resource) {
+    rdpq_font_free(resource);
+}
+
+static struct resource_cache font_resource_cache = {
+    .name = "font",
+    .destroy = font_cache_destroy,
+    .zombie_budget = FONT_CACHE_ZOMBIE_BUDGET,
+    .asset_type = ASSET_TYPE_FONT,
+};
 
 rdpq_font_t* font_cache_load(char* filename) {
-    struct resource_cache_entry* entry = resource_cache_use(&font_resource_cache, filename);
+    return font_cache_load_id(asset_manifest_require(filename));
+}
+
+rdpq_font_t* font_cache_load_id(asset_id id) {
+    struct resource_cache_entry* entry = resource_cache_use(&font_resource_cache, id);
 
     if (!entry->resource) {
-        entry->resource = rdpq_font_load(filename);
+        resource_cache_loaded(&font_resource_cache, entry, rdpq_font_load(asset_manifest_path(id)), FONT_CACHE_ESTIMATED_SIZE);
     }
 
     return entry->resource;
 }
 
 void font_cache_release(rdpq_font_t* font) {
-    if (resource_cache_free(&font_resource_cache, font)) {
-        rdpq_font_free(font);
-    }
-}
\ No newline at end of file
+    resource_cache_free(&font_resource_cache, font);
+}
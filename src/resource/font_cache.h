@@ -2,8 +2,10 @@
 #define __RESOURCE_FONT_CACHE_H__
 
 #include <libdragon.h>
+#include "asset_manifest.h"
 
 rdpq_font_t* font_cache_load(char* filename);
+rdpq_font_t* font_cache_load_id(asset_id id);
 void font_cache_release(rdpq_font_t* font);
 
 #endif
\ No newline at end of file
@@ -5,28 +5,46 @@
 #include <malloc.h>
 #include "resource_cache.h"
 #include "sprite_cache.h"
+#include "../util/memory_tag.h"
 
-struct resource_cache material_resource_cache;
+// the sprites a material uses are kept by the sprite cache
+#define MATERIAL_CACHE_ZOMBIE_BUDGET    (4 * 1024)
 
+static void material_cache_destroy(void* resource) {
+    material_release(resource);
+    tagged_free(resource);
+}
+
+struct resource_cache material_resource_cache = {
+    .name = "material",
+    .destroy = material_cache_destroy,
+    .zombie_budget = MATERIAL_CACHE_ZOMBIE_BUDGET,
+    .asset_type = ASSET_TYPE_MATERIAL,
+};
+
+// returns a reference the caller gives back with material_cache_release()
 struct material* material_cache_load(const char* filename) {
-    struct resource_cache_entry* entry = resource_cache_use(&material_resource_cache, filename);
+    return material_cache_load_id(asset_manifest_require(filename));
+}
+
+// returns a reference the caller gives back with material_cache_release()
+struct material* material_cache_load_id(asset_id id) {
+    struct resource_cache_entry* entry = resource_cache_use(&material_resource_cache, id);
 
     if (!entry->resource) {
-        struct material* result = malloc(sizeof(struct material));
+        struct material* result = tagged_malloc(MEMORY_TAG_MATERIAL, sizeof(struct material));
         
-        FILE* material_file = asset_fopen(filename, NULL);
+        int size;
+        FILE* material_file = asset_fopen(asset_manifest_path(id), &size);
         material_load(result, material_file);
         fclose(material_file);
 
-        entry->resource = result;
+        resource_cache_loaded(&material_resource_cache, entry, result, sizeof(struct material) + size);
     }
 
     return entry->resource;
 }
 
 void material_cache_release(struct material* material) {
-    if (resource_cache_free(&material_resource_cache, material)) {
-        material_release(material);
-        free(material);
-    }
-}
\ No newline at end of file
+    resource_cache_free(&material_resource_cache, material);
+}
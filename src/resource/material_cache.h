@@ -2,11 +2,13 @@
 #define __RESOURCE_MATERIAL_CACHE_H__
 
 #include "../render/material.h"
+#include "asset_manifest.h"
 
 // load a material or reuse the existing one if already loaded
 // callers of this function must call material_cache_release
 // when they are done with the material
 struct material* material_cache_load(const char* filename);
+struct material* material_cache_load_id(asset_id id);
 void material_cache_release(struct material* material);
 
 #endif
\ No newline at end of file
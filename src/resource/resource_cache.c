@@ -3,285 +3,305 @@
 #include <malloc.h>
 #include <string.h>
 #include <assert.h>
+#include <stdio.h>
+#include <libdragon.h>
+#include "../util/memory_tag.h"
 
 // a 32 bit prime number
 #define MAGIC_PRIME 2748002342
 #define NO_ENTRY    -1
 #define MIN_TABLE_SIZE  32
 
-uint32_t string_hash(const void* key) {
-    uint32_t hash = 0;
-    for (const unsigned char *p = key; *p != '\0'; p++) {
-        hash = 31 * hash + *p;
-    }
-    return hash;
-}
+static struct resource_cache* resource_cache_first;
+static uint32_t resource_cache_clock;
 
+static uint32_t resource_hash(void* resource) {
+    return (uint32_t)(uintptr_t)resource * MAGIC_PRIME;
+}
 
 void resource_cache_reset(struct resource_cache* cache) {
+    if (!cache->entries) {
+        cache->next_cache = resource_cache_first;
+        resource_cache_first = cache;
+    }
+
     for (int i = 0; i < cache->entry_capacity; i += 1) {
         struct resource_cache_entry* entry = &cache->entries[i];
 
-        // skip empty entries
-        if (!entry->filename) {
-            continue;
+        // zombies are owned by the cache
+        if (entry->reference_count == 0 && entry->resource) {
+            cache->destroy(entry->resource);
         }
-
-        // malloc() 
-        free(entry->filename);
     }
 
-    free(cache->entries);
-    free(cache->filename_index);
-    free(cache->resource_index);
+    tagged_free(cache->entries);
+    tagged_free(cache->resource_index);
+
+    struct asset_range range = asset_manifest_ranges[cache->asset_type];
+
+    // the resource index is kept at most half full
+    int index_size = MIN_TABLE_SIZE;
 
-    cache->entry_capacity = MIN_TABLE_SIZE;
-    cache->next_entry_index = 0;
+    while (index_size < range.count * 2) {
+        index_size *= 2;
+    }
+
+    cache->first_id = range.first;
+    cache->entry_capacity = range.count;
     cache->entry_count = 0;
+    cache->zombie_size = 0;
+    cache->resource_index_mask = index_size - 1;
 
-    cache->entries = malloc(sizeof(struct resource_cache_entry) * MIN_TABLE_SIZE);
-    cache->filename_index = malloc(sizeof(short) * MIN_TABLE_SIZE);
-    cache->resource_index = malloc(sizeof(short) * MIN_TABLE_SIZE);
+    cache->entries = tagged_malloc(MEMORY_TAG_RESOURCES, sizeof(struct resource_cache_entry) * range.count);
+    cache->resource_index = tagged_malloc(MEMORY_TAG_RESOURCES, sizeof(short) * index_size);
 
-    for (int i = 0; i < MIN_TABLE_SIZE; ++i) {
-        cache->filename_index[i] = NO_ENTRY;
+    for (int i = 0; i < index_size; ++i) {
         cache->resource_index[i] = NO_ENTRY;
     }
 
     for (int i = 0; i < cache->entry_capacity; ++i) {
         struct resource_cache_entry* target_entry = &cache->entries[i];
 
-        target_entry->filename = NULL;
         target_entry->resource = NULL;
-        target_entry->filename_hash = 0;
-        target_entry->filename_index = 0;
+        target_entry->size = 0;
+        target_entry->last_used = 0;
         target_entry->reference_count = 0;
     }
 }
 
-struct resource_cache_entry* resource_cache_next(struct resource_cache* cache, struct resource_cache_entry* entry) {
-    int next_index = entry ? (entry - cache->entries) + 1 : 0;
-    int mask = cache->entry_capacity - 1;
+struct resource_cache_entry* resource_cache_use(struct resource_cache* cache, asset_id id) {
+    // initialize on demand
+    if (!cache->entries) {
+        resource_cache_reset(cache);
+    }
+
+    assert(id != ASSET_ID_NONE);
+    assert(id >= cache->first_id && id - cache->first_id < cache->entry_capacity);
 
-    while (next_index < cache->entry_capacity) {
-        struct resource_cache_entry* next_entry = &cache->entries[next_index];
+    struct resource_cache_entry* entry = &cache->entries[id - cache->first_id];
 
-        if (next_entry->filename) {
-            return next_entry;
+    if (!entry->resource) {
+        cache->stats.misses += 1;
+        cache->entry_count += 1;
+    } else {
+        if (entry->reference_count == 0) {
+            cache->zombie_size -= entry->size;
+            cache->stats.resurrections += 1;
         }
 
-        next_index = (next_index + 1) & mask;
+        cache->stats.hits += 1;
     }
 
-    return NULL;
+    entry->reference_count += 1;
+    return entry;
 }
 
-void resource_cache_resize(struct resource_cache* cache) {
-    int new_capacity = cache->entry_capacity * 2;
-    struct resource_cache_entry* new_entries = malloc(sizeof(struct resource_cache_entry) * new_capacity);
-    short* new_filename_index = malloc((sizeof(short) * new_capacity));
-    short* new_resource_index = malloc((sizeof(short) * new_capacity));
+void resource_cache_loaded(struct resource_cache* cache, struct resource_cache_entry* entry, void* resource, uint32_t size) {
+    assert(!entry->resource);
+    entry->resource = resource;
+    entry->size = size;
+
+    uint32_t mask = cache->resource_index_mask;
+    uint32_t index_check = resource_hash(resource) & mask;
 
-    for (int i = 0; i < new_capacity; ++i) {
-        new_filename_index[i] = NO_ENTRY;
-        new_resource_index[i] = NO_ENTRY;
+    while (cache->resource_index[index_check] != NO_ENTRY) {
+        index_check = (index_check + 1) & mask;
     }
 
-    for (int i = 0; i < new_capacity; ++i) {
-        struct resource_cache_entry* target_entry = &new_entries[i];
+    cache->resource_index[index_check] = entry - cache->entries;
+}
 
-        target_entry->filename = NULL;
-        target_entry->resource = NULL;
-        target_entry->filename_hash = 0;
-        target_entry->filename_index = 0;
-        target_entry->reference_count = 0;
+// removes a slot from the resource index without
+// breaking the probe sequence of the slots after it
+static void resource_cache_index_remove(struct resource_cache* cache, int slot) {
+    short* index = cache->resource_index;
+    uint32_t mask = cache->resource_index_mask;
+    uint32_t empty = slot;
+    uint32_t current = (slot + 1) & mask;
+
+    while (index[current] != NO_ENTRY) {
+        struct resource_cache_entry* entry = &cache->entries[index[current]];
+        uint32_t home = resource_hash(entry->resource) & mask;
+
+        // the entry can only move back if its home slot is
+        // not between the empty slot and its current slot
+        bool can_move = empty <= current ? 
+            (home <= empty || home > current) : 
+            (home <= empty && home > current);
+
+        if (can_move) {
+            index[empty] = index[current];
+            empty = current;
+        }
+
+        current = (current + 1) & mask;
     }
 
-    cache->next_entry_index = 0;
+    index[empty] = NO_ENTRY;
+}
 
-    int new_mask = new_capacity - 1;
+static int resource_cache_find_resource(struct resource_cache* cache, void* resource) {
+    uint32_t mask = cache->resource_index_mask;
+    uint32_t index_check = resource_hash(resource) & mask;
 
-    for (int i = 0; i < cache->entry_capacity; ++i) {
-        struct resource_cache_entry* entry = &cache->entries[i];
+    for (;;) {
+        int index = cache->resource_index[index_check];
 
-        // skip empty entries
-        if (!entry->filename) {
-            continue;
+        if (index == NO_ENTRY) {
+            return NO_ENTRY;
         }
 
-        struct resource_cache_entry* target_entry = &new_entries[cache->next_entry_index];
-
-        target_entry->filename = entry->filename;
-        target_entry->resource = entry->resource;
-        target_entry->reference_count = entry->reference_count;
-        target_entry->filename_hash = entry->filename_hash;
-
-        // insert filename index
-        uint32_t index_check = target_entry->filename_hash & new_mask;
-        while (new_filename_index[index_check] != NO_ENTRY) {
-            index_check = (index_check + 1) & new_mask;
+        if (cache->entries[index].resource == resource) {
+            return index_check;
         }
 
-        new_filename_index[index_check] = cache->next_entry_index;
-        target_entry->filename_index = index_check;
+        index_check = (index_check + 1) & mask;
+    }
+}
 
-        // insert resource index
-        index_check = ((uint32_t)entry->resource * MAGIC_PRIME) & new_mask;
+static void resource_cache_remove(struct resource_cache* cache, struct resource_cache_entry* entry, int resource_index) {
+    resource_cache_index_remove(cache, resource_index);
+    cache->destroy(entry->resource);
+    entry->reference_count = 0;
+    entry->resource = NULL;
+    entry->size = 0;
 
-        while (new_resource_index[index_check] != NO_ENTRY) {
-            index_check = (index_check + 1) & new_mask;
-        }
+    cache->entry_count -= 1;
+}
 
-        new_resource_index[index_check] = cache->next_entry_index;
+static struct resource_cache_entry* resource_cache_oldest_zombie(struct resource_cache* cache) {
+    struct resource_cache_entry* result = NULL;
 
-        // move to next entry index
-        cache->next_entry_index += 1;
+    if (!cache->zombie_size) {
+        return NULL;
     }
 
-    for (int i = cache->next_entry_index; i < cache->entry_capacity; ++i) {
-        struct resource_cache_entry* target_entry = &new_entries[i];
+    for (int i = 0; i < cache->entry_capacity; i += 1) {
+        struct resource_cache_entry* entry = &cache->entries[i];
 
-        target_entry->filename = NULL;
-        target_entry->resource = NULL;
-        target_entry->filename_hash = 0;
-        target_entry->filename_index = 0;
-        target_entry->reference_count = 0;
+        if (entry->reference_count || !entry->resource) {
+            continue;
+        }
+
+        if (!result || entry->last_used < result->last_used) {
+            result = entry;
+        }
     }
 
-    free(cache->entries);
-    free(cache->filename_index);
-    free(cache->resource_index);
+    return result;
+}
 
-    cache->entry_capacity = new_capacity;
-    cache->entries = new_entries;
-    cache->filename_index = new_filename_index;
-    cache->resource_index = new_resource_index;
+static void resource_cache_evict(struct resource_cache* cache, struct resource_cache_entry* entry) {
+    cache->zombie_size -= entry->size;
+    cache->stats.evictions += 1;
+    resource_cache_remove(cache, entry, resource_cache_find_resource(cache, entry->resource));
 }
 
-struct resource_cache_entry* resource_cache_insert(struct resource_cache* cache, int filename_index, uint32_t filename_hash, const char* filename) {
-    uint32_t mask = cache->entry_capacity - 1;
-    
-    if (cache->entry_count + 1 > (cache->entry_capacity / 2)) {
-        resource_cache_resize(cache);
-
-        // recalculate filename_index posiiton
-        mask = cache->entry_capacity - 1;
-        filename_index = filename_hash & mask;
-        while (cache->filename_index[filename_index] != NO_ENTRY) {
-            filename_index = (filename_index + 1) & mask;
-        }
-    }
+void resource_cache_trim(struct resource_cache* cache, uint32_t zombie_size) {
+    while (cache->zombie_size > zombie_size) {
+        struct resource_cache_entry* oldest = resource_cache_oldest_zombie(cache);
 
-    int entry_index = cache->next_entry_index;
+        if (!oldest) {
+            break;
+        }
 
-    // search for an available entry
-    while (cache->entries[entry_index].filename) {
-        entry_index = (entry_index + 1) & mask;
+        resource_cache_evict(cache, oldest);
     }
+}
 
-    struct resource_cache_entry* entry = &cache->entries[entry_index];
+void resource_cache_free(struct resource_cache* cache, void* resource) {
+    if (!resource) {
+        return;
+    }
 
-    int filename_len = strlen(filename);
-    entry->filename = malloc(filename_len  + 1);
-    strcpy(entry->filename, filename);
-    entry->resource = NULL;
-    entry->reference_count = 1;
-    entry->filename_index = filename_index;
-    entry->filename_hash = filename_hash;
+    assert(cache->entries);
 
-    cache->filename_index[filename_index] = entry_index;
-    
-    // TODO insert after resource is initialized
-    // insert resource index
-    uint32_t index_check = ((uint32_t)entry->resource * MAGIC_PRIME) & mask;
+    int index_check = resource_cache_find_resource(cache, resource);
 
-    while (cache->resource_index[index_check] != NO_ENTRY) {
-        index_check = (index_check + 1) & mask;
+    if (index_check == NO_ENTRY) {
+        // resource not found
+        return;
     }
 
-    cache->resource_index[index_check] = entry_index;
+    struct resource_cache_entry* entry = &cache->entries[cache->resource_index[index_check]];
 
-    cache->entry_count += 1;
-
-    return entry;
-}
+    assert(entry->reference_count > 0);
+    entry->reference_count -= 1;
 
-struct resource_cache_entry* resource_cache_use(struct resource_cache* cache, const char* filename) {
-    // initialize on demand
-    if (!cache->entries) {
-        resource_cache_reset(cache);
+    if (entry->reference_count) {
+        return;
     }
 
-    uint32_t filename_hash = string_hash(filename);
+    if (entry->size > cache->zombie_budget) {
+        cache->stats.evictions += 1;
+        resource_cache_remove(cache, entry, index_check);
+        return;
+    }
 
-    uint32_t mask = cache->entry_capacity - 1;
-    uint32_t index_check = filename_hash & mask;
+    resource_cache_clock += 1;
+    entry->last_used = resource_cache_clock;
+    cache->zombie_size += entry->size;
+    resource_cache_trim(cache, cache->zombie_budget);
+}
 
-    for (;;) {
-        int index = cache->filename_index[index_check];
+static int resource_cache_free_heap() {
+    heap_stats_t heap_stats;
+    sys_get_heap_stats(&heap_stats);
+    return heap_stats.total - heap_stats.used;
+}
 
-        if (index == NO_ENTRY) {
-            return resource_cache_insert(cache, index_check, filename_hash, filename);
-        }
+// evicts the oldest zombie across all caches
+static bool resource_cache_evict_oldest() {
+    struct resource_cache* oldest_cache = NULL;
+    struct resource_cache_entry* oldest = NULL;
 
-        struct resource_cache_entry* entry = &cache->entries[index];
+    for (struct resource_cache* cache = resource_cache_first; cache; cache = cache->next_cache) {
+        struct resource_cache_entry* entry = resource_cache_oldest_zombie(cache);
 
-        if (entry->filename_hash == filename_hash && strcmp(filename, entry->filename) == 0) {
-            entry->reference_count += 1;
-            return entry;
+        if (entry && (!oldest || entry->last_used < oldest->last_used)) {
+            oldest = entry;
+            oldest_cache = cache;
         }
-
-        index_check = (index_check + 1) & mask;
     }
-}
-
-void resource_cache_remove(struct resource_cache* cache, struct resource_cache_entry* entry, int resource_index) {
-    int filename_index = entry->filename_index;
 
-    cache->filename_index[filename_index] = NO_ENTRY;
-    cache->resource_index[resource_index] = NO_ENTRY;
-    free(entry->filename);
-    entry->filename = NULL;
-    entry->reference_count = 0;
-    entry->resource = NULL;
-    entry->filename_index = 0;
-
-    cache->entry_count -= 1;
-}
-
-bool resource_cache_free(struct resource_cache* cache, void* resource) {
-    if (!resource) {
+    if (!oldest) {
         return false;
     }
 
-    assert(cache->entries);
-
-    uint32_t mask = cache->entry_capacity - 1;
-    uint32_t index_check = ((uint32_t)resource * MAGIC_PRIME) & mask;
-
-    for (;;) {
-        int index = cache->resource_index[index_check];
+    resource_cache_evict(oldest_cache, oldest);
+    return true;
+}
 
-        if (index == NO_ENTRY) {
-            // resource not found
-            return false;
+void resource_cache_trim_under_pressure() {
+    while (resource_cache_free_heap() < RESOURCE_CACHE_MIN_FREE_HEAP) {
+        if (!resource_cache_evict_oldest()) {
+            return;
         }
+    }
+}
 
-        struct resource_cache_entry* entry = &cache->entries[index];
-
-        if (entry->resource == resource) {
-            entry->reference_count -= 1;
-
-            if (entry->reference_count == 0) {
-                resource_cache_remove(cache, entry, index_check);
-                return true;
-            }
+bool resource_cache_background_trim(void* data, long long deadline) {
+    if (resource_cache_free_heap() >= RESOURCE_CACHE_IDLE_FREE_HEAP) {
+        return false;
+    }
 
-            return false;
-        }
+    return resource_cache_evict_oldest();
+}
 
-        index_check = (index_check + 1) & mask;
+#ifdef MEMORY_PROFILE
+void resource_cache_report() {
+    for (struct resource_cache* cache = resource_cache_first; cache; cache = cache->next_cache) {
+        fprintf(
+            stderr, 
+            "resource_cache %-10s hits %d misses %d resurrections %d evictions %d zombies %d/%d bytes\n",
+            cache->name,
+            cache->stats.hits,
+            cache->stats.misses,
+            cache->stats.resurrections,
+            cache->stats.evictions,
+            (int)cache->zombie_size,
+            (int)cache->zombie_budget
+        );
     }
-
-    return false;
-}
\ No newline at end of file
+}
+#endif
@@ -4,27 +4,74 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "asset_manifest.h"
+
+typedef void (*resource_destroy_callback)(void* resource);
+
 struct resource_cache_entry {
-    char* filename;
     void* resource;
+    // approximate number of bytes used by resource
+    uint32_t size;
+    // when reference_count is 0 the resource is a zombie that
+    // can be resurrected until it is evicted, oldest first
+    uint32_t last_used;
     short reference_count;
-    short filename_index;
-    uint32_t filename_hash;
+};
+
+struct resource_cache_stats {
+    uint16_t hits;
+    uint16_t misses;
+    uint16_t resurrections;
+    uint16_t evictions;
 };
 
 struct resource_cache {
+    // these are set when the cache is declared
+    const char* name;
+    resource_destroy_callback destroy;
+    uint32_t zombie_budget;
+    enum asset_type asset_type;
+
+    // indexed by asset id - first_id
     struct resource_cache_entry* entries;
-    short next_entry_index;
-    short entry_capacity;
-    short entry_count;
+    asset_id first_id;
+    uint16_t entry_capacity;
+    uint16_t entry_count;
 
-    short* filename_index;
+    // maps a resource pointer back to its entry
     short* resource_index;
+    uint16_t resource_index_mask;
+
+    uint32_t zombie_size;
+    struct resource_cache_stats stats;
+
+    struct resource_cache* next_cache;
 };
 
+#define RESOURCE_CACHE_MIN_FREE_HEAP    (256 * 1024)
+// zombies are trimmed in idle time while the free heap is below
+// this so loading rarely has to stop and evict
+#define RESOURCE_CACHE_IDLE_FREE_HEAP   (384 * 1024)
+
 void resource_cache_reset(struct resource_cache* cache);
-struct resource_cache_entry* resource_cache_next(struct resource_cache* cache, struct resource_cache_entry* entry);
-struct resource_cache_entry* resource_cache_use(struct resource_cache* cache, const char* filename);
-bool resource_cache_free(struct resource_cache* cache, void* resource);
+// if the returned entry has no resource the caller loads it
+// and then passes it to resource_cache_loaded
+struct resource_cache_entry* resource_cache_use(struct resource_cache* cache, asset_id id);
+void resource_cache_loaded(struct resource_cache* cache, struct resource_cache_entry* entry, void* resource, uint32_t size);
+// unreferenced resources are kept as zombies up to the zombie budget
+// and destroyed with cache->destroy when evicted
+void resource_cache_free(struct resource_cache* cache, void* resource);
+
+// evicts zombies until the cache is using at most zombie_size bytes
+void resource_cache_trim(struct resource_cache* cache, uint32_t zombie_size);
+// evicts zombies from every cache, oldest first, until the
+// free heap is at least RESOURCE_CACHE_MIN_FREE_HEAP
+void resource_cache_trim_under_pressure();
+// background job, evicts one zombie per call
+bool resource_cache_background_trim(void* data, long long deadline);
+
+#ifdef MEMORY_PROFILE
+void resource_cache_report();
+#endif
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,68 @@
+#include "resource_cache.h"
+#include "../test/framework_test.h"
+
+#include <stddef.h>
+
+static int test_destroy_count;
+
+static void test_resource_destroy(void* resource) {
+    test_destroy_count += 1;
+}
+
+static struct resource_cache test_cache = {
+    .name = "test",
+    .destroy = test_resource_destroy,
+    .zombie_budget = 64,
+    .asset_type = ASSET_TYPE_OTHER,
+};
+
+static int test_resources[4];
+
+void test_resource_cache_zombies(struct test_context* t) {
+    resource_cache_reset(&test_cache);
+    test_destroy_count = 0;
+
+    // the resources are never loaded so any ids will do
+    asset_id a = test_cache.first_id;
+    asset_id b = test_cache.first_id + 1;
+
+    struct resource_cache_entry* entry = resource_cache_use(&test_cache, a);
+    test_eqp(t, NULL, entry->resource);
+    resource_cache_loaded(&test_cache, entry, &test_resources[0], 32);
+    test_eqi(t, 1, test_cache.stats.misses);
+
+    // unreferenced resources are kept
+    resource_cache_free(&test_cache, &test_resources[0]);
+    test_eqi(t, 0, test_destroy_count);
+    test_eqi(t, 32, test_cache.zombie_size);
+
+    // and resurrected when used again
+    entry = resource_cache_use(&test_cache, a);
+    test_eqp(t, &test_resources[0], entry->resource);
+    test_eqi(t, 1, test_cache.stats.resurrections);
+    test_eqi(t, 0, test_cache.zombie_size);
+
+    entry = resource_cache_use(&test_cache, b);
+    resource_cache_loaded(&test_cache, entry, &test_resources[1], 48);
+
+    // the oldest zombie is evicted once the budget is exceeded
+    resource_cache_free(&test_cache, &test_resources[0]);
+    resource_cache_free(&test_cache, &test_resources[1]);
+    test_eqi(t, 1, test_destroy_count);
+    test_eqi(t, 1, test_cache.stats.evictions);
+    test_eqi(t, 48, test_cache.zombie_size);
+
+    entry = resource_cache_use(&test_cache, a);
+    test_eqp(t, NULL, entry->resource);
+    resource_cache_loaded(&test_cache, entry, &test_resources[2], 16);
+
+    entry = resource_cache_use(&test_cache, b);
+    test_eqp(t, &test_resources[1], entry->resource);
+
+    resource_cache_free(&test_cache, &test_resources[1]);
+    resource_cache_free(&test_cache, &test_resources[2]);
+    resource_cache_trim(&test_cache, 0);
+    test_eqi(t, 3, test_destroy_count);
+    test_eqi(t, 0, test_cache.zombie_size);
+    test_eqi(t, 0, test_cache.entry_count);
+}
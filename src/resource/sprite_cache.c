@@ -2,21 +2,35 @@
 
 #include "resource_cache.h"
 
-struct resource_cache sprite_resource_cache;
+#define SPRITE_CACHE_ZOMBIE_BUDGET  (96 * 1024)
+
+static void sprite_cache_destroy(void* resource) {
+    sprite_free(resource);
+}
+
+struct resource_cache sprite_resource_cache = {
+    .name = "sprite",
+    .destroy = sprite_cache_destroy,
+    .zombie_budget = SPRITE_CACHE_ZOMBIE_BUDGET,
+    .asset_type = ASSET_TYPE_SPRITE,
+};
 
 sprite_t* sprite_cache_load(const char* filename) {
-    struct resource_cache_entry* entry = resource_cache_use(&sprite_resource_cache, filename);
+    return sprite_cache_load_id(asset_manifest_require(filename));
+}
+
+sprite_t* sprite_cache_load_id(asset_id id) {
+    struct resource_cache_entry* entry = resource_cache_use(&sprite_resource_cache, id);
 
     if (entry->resource == NULL) {
-        // fprintf(stderr, "%s\n", filename);
-        entry->resource = sprite_load(filename);
+        sprite_t* sprite = sprite_load(asset_manifest_path(id));
+        uint32_t size = TEX_FORMAT_PIX2BYTES(sprite_get_format(sprite), sprite->width * sprite->height);
+        resource_cache_loaded(&sprite_resource_cache, entry, sprite, sizeof(sprite_t) + size);
     }
 
     return entry->resource;
 }
 
 void sprite_cache_release(sprite_t* sprite) {
-    if (resource_cache_free(&sprite_resource_cache, sprite)) {
-        sprite_free(sprite);
-    }
-}
\ No newline at end of file
+    resource_cache_free(&sprite_resource_cache, sprite);
+}
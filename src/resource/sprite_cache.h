@@ -2,8 +2,10 @@
 #define __RESOURCE_SPRITE_CACHE_H__
 
 #include <libdragon.h>
+#include "asset_manifest.h"
 
 sprite_t* sprite_cache_load(const char* filename);
+sprite_t* sprite_cache_load_id(asset_id id);
 void sprite_cache_release(sprite_t* sprite);
 
 #endif
\ No newline at end of file
@@ -1,28 +1,43 @@
 #include "tmesh_cache.h"
 
 #include "resource_cache.h"
+#include "../util/memory_tag.h"
 
-struct resource_cache tmesh_resource_cache;
+#define TMESH_CACHE_ZOMBIE_BUDGET   (96 * 1024)
+
+static void tmesh_cache_destroy(void* resource) {
+    tmesh_release(resource);
+    tagged_free(resource);
+}
+
+struct resource_cache tmesh_resource_cache = {
+    .name = "tmesh",
+    .destroy = tmesh_cache_destroy,
+    .zombie_budget = TMESH_CACHE_ZOMBIE_BUDGET,
+    .asset_type = ASSET_TYPE_TMESH,
+};
 
 struct tmesh* tmesh_cache_load(const char* filename) {
-    struct resource_cache_entry* entry = resource_cache_use(&tmesh_resource_cache, filename);
+    return tmesh_cache_load_id(asset_manifest_require(filename));
+}
+
+struct tmesh* tmesh_cache_load_id(asset_id id) {
+    struct resource_cache_entry* entry = resource_cache_use(&tmesh_resource_cache, id);
 
     if (!entry->resource) {
-        struct tmesh* result = malloc(sizeof(struct tmesh));
+        struct tmesh* result = tagged_malloc(MEMORY_TAG_MESH, sizeof(struct tmesh));
         
-        FILE* meshFile = asset_fopen(filename, NULL);
+        int size;
+        FILE* meshFile = asset_fopen(asset_manifest_path(id), &size);
         tmesh_load(result, meshFile);
         fclose(meshFile);
 
-        entry->resource = result;
+        resource_cache_loaded(&tmesh_resource_cache, entry, result, sizeof(struct tmesh) + size);
     }
 
     return entry->resource;
 }
 
 void tmesh_cache_release(struct tmesh* mesh) {
-    if (resource_cache_free(&tmesh_resource_cache, mesh)) {
-        tmesh_release(mesh);
-        free(mesh);
-    }
-}
\ No newline at end of file
+    resource_cache_free(&tmesh_resource_cache, mesh);
+}
@@ -2,8 +2,10 @@
 #define __RESOURCE_TMESH_CACHE_H__
 
 #include "../render/tmesh.h"
+#include "asset_manifest.h"
 
 struct tmesh* tmesh_cache_load(const char* filename);
+struct tmesh* tmesh_cache_load_id(asset_id id);
 void tmesh_cache_release(struct tmesh* mesh);
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "camera_controller.h"
 
 #include "../time/time.h"
+#include "../input/input.h"
 
 #define CAMERA_FOLLOW_DISTANCE  3.4f
 #define CAMERA_FOLLOW_HEIGHT    1.6f
@@ -8,7 +9,7 @@
 void camera_controller_update_position(struct camera_controller* controller, struct Transform* target) {
     struct Vector3 offset;
 
-    if (joypad_get_buttons_held(0).z) {
+    if (input_get_buttons_held().z) {
         quatMultVector(&target->rotation, &gForward, &offset);
     } else {
         vector3Sub(&target->position, &controller->camera->transform.position, &offset);
@@ -43,7 +44,7 @@ void camera_controller_init(struct camera_controller* controller, struct Camera*
     controller->camera = camera;
     controller->player = player;
 
-    update_add(controller, (update_callback)camera_controller_update, UPDATE_PRIORITY_CAMERA, UPDATE_LAYER_WORLD);
+    controller->update_id = update_add(controller, (update_callback)camera_controller_update, UPDATE_PRIORITY_CAMERA, UPDATE_LAYER_WORLD);
 
     controller->target = player->transform.position;
     controller->follow_distace = 3.0f;
@@ -56,5 +57,5 @@ void camera_controller_init(struct camera_controller* controller, struct Camera*
 }
 
 void camera_controller_destroy(struct camera_controller* controller) {
-    update_remove(controller);
+    update_remove(controller->update_id);
 }
\ No newline at end of file
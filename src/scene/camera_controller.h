@@ -3,12 +3,14 @@
 
 #include "../render/camera.h"
 #include "../player/player.h"
+#include "../time/time.h"
 
 struct camera_controller {
     struct Camera* camera;
     struct player* player;
     float follow_distace;
     struct Vector3 target;
+    update_id update_id;
 };
 
 void camera_controller_init(struct camera_controller* controller, struct Camera* camera, struct player* player);
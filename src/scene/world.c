@@ -1,6 +1,7 @@
 #include "world.h"
 
 #include "../render/render_batch.h"
+#include "world_prefetch.h"
 
 static char next_world_name[64];
 static char next_entrance_name[16];
@@ -24,6 +25,8 @@ void world_update(void* data) {
             world_queue_next(world->loading_zones[i].world_name);
         }
     }
+
+    world_prefetch_update(world, &player_center);
 }
 
 void world_queue_next(char* world_name) {
@@ -11,6 +11,7 @@
 #include "../menu/pause_menu.h"
 #include "../menu/hud.h"
 #include "camera_controller.h"
+#include "../time/time.h"
 
 typedef void(*entity_init)(void* entity, void* definition);
 typedef void(*entity_destroy)(void* entity);
@@ -40,10 +41,48 @@ struct loading_zone {
     char* world_name;
 };
 
+struct world_location {
+    char* name;
+    struct Vector3 position;
+    struct Vector2 rotation;
+};
+
+// entities without a spawn condition use this index
+#define WORLD_CONDITION_ALWAYS  0xFFFF
+
+struct world_entity_group {
+    char* name;
+    void* definitions;
+    // one index into world_blob.conditions per definition
+    uint16_t* condition_indices;
+    uint16_t entity_count;
+    uint16_t definition_size;
+};
+
+// the contents of a world file are loaded into a single
+// allocation with this at the start, pointers are stored
+// as offsets in the file and are relocated when loaded
+struct world_blob {
+    struct mesh_collider mesh_collider;
+
+    struct world_location* locations;
+    struct world_entity_group* entity_groups;
+    struct loading_zone* loading_zones;
+    // every unique spawn condition as an expression program, each
+    // is only evaluated once no matter how many entities share it
+    char** conditions;
+
+    uint16_t location_count;
+    uint16_t entity_group_count;
+    uint16_t loading_zone_count;
+    uint16_t condition_count;
+};
+
 struct world {
+    struct world_blob* blob;
     struct static_entity* static_entities;
 
-    struct mesh_collider mesh_collider;
+    struct mesh_collider* mesh_collider;
 
     struct player player;
     struct Camera camera;
@@ -53,13 +92,17 @@ struct world {
     struct hud hud;
     
     struct entity_data* entity_data;
+    void* entity_memory;
     struct loading_zone* loading_zones;
 
     uint16_t static_entity_count;
     uint16_t entity_data_count;
     uint16_t loading_zone_count;
 
-    char* string_table;
+    // size of each double buffered frame memory pool
+    uint32_t frame_memory_size;
+
+    update_id update_id;
 };
 
 void world_render(void* data, struct render_batch* batch);
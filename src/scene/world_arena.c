@@ -0,0 +1,51 @@
+#include "world_arena.h"
+
+#include "../util/arena.h"
+#include "../util/memory_tag.h"
+#include <stdio.h>
+
+#define WORLD_ARENA_SIZE    0x40000
+
+static struct arena g_world_arena;
+
+void* world_malloc(int bytes) {
+    if (!g_world_arena.memory) {
+        // the arena is reused by every world and is never tagged_free()'d
+        arena_init_with_buffer(&g_world_arena, tagged_malloc(MEMORY_TAG_WORLD, WORLD_ARENA_SIZE), WORLD_ARENA_SIZE);
+    }
+
+    void* result = arena_malloc(&g_world_arena, bytes);
+
+    if (result) {
+        return result;
+    }
+
+    return tagged_malloc(MEMORY_TAG_WORLD, bytes);
+}
+
+void world_free(void* memory) {
+    if (!memory || arena_contains(&g_world_arena, memory)) {
+        return;
+    }
+
+    tagged_free(memory);
+}
+
+void world_arena_reset() {
+    arena_reset(&g_world_arena);
+}
+
+#ifdef MEMORY_PROFILE
+void world_arena_report(const char* label) {
+    fprintf(
+        stderr,
+        "world arena %s: %d/%d bytes (high water %d) %d allocations %d overflowed\n",
+        label,
+        (int)g_world_arena.current,
+        (int)g_world_arena.capacity,
+        (int)g_world_arena.high_water,
+        g_world_arena.allocation_count,
+        g_world_arena.overflow_count
+    );
+}
+#endif
@@ -0,0 +1,16 @@
+#ifndef __SCENE_WORLD_ARENA_H__
+#define __SCENE_WORLD_ARENA_H__
+
+// memory that lives exactly as long as the current world
+// world_free only releases allocations that overflowed
+// onto the heap, everything else goes away in world_arena_reset
+void* world_malloc(int bytes);
+void world_free(void* memory);
+
+void world_arena_reset();
+
+#ifdef MEMORY_PROFILE
+void world_arena_report(const char* label);
+#endif
+
+#endif
@@ -3,13 +3,17 @@
 #include <malloc.h>
 #include <string.h>
 #include <libdragon.h>
-#include "../resource/mesh_collider.h"
 #include "../resource/tmesh_cache.h"
+#include "../render/frame_alloc.h"
 #include "../render/render_scene.h"
 #include "../time/time.h"
+#include "../time/background.h"
 #include "../cutscene/cutscene_runner.h"
 #include "../cutscene/evaluation_context.h"
 #include "../cutscene/expression_evaluate.h"
+#include "../resource/resource_cache.h"
+#include "world_arena.h"
+#include "../effects/effect_allocator.h"
 
 #include "../enemies/biter.h"
 
@@ -22,6 +26,7 @@
 #include "../objects/treasure_chest.h"
 
 #include "../collision/collision_scene.h"
+#include "../util/memory_tag.h"
 
 static struct entity_definition world_entity_definitions[] = {
     ENTITY_DEFINITION(biter),
@@ -35,6 +40,20 @@ static struct entity_definition world_entity_definitions[] = {
 
 // WRLD
 #define EXPECTED_HEADER 0x57524C44
+#define WORLD_VERSION   4
+
+#define ALIGN_8(size)   (((size) + 7) & ~7)
+
+struct world_file_header {
+    uint32_t header;
+    uint16_t version;
+    uint16_t static_count;
+    uint32_t blob_size;
+    uint32_t relocation_count;
+    // 0 means use FRAME_MEMORY_SIZE
+    uint16_t frame_memory_kb;
+    uint16_t padding;
+};
 
 struct entity_definition* world_find_def(const char* name) {
    for (int i = 0; i < sizeof(world_entity_definitions) / sizeof(*world_entity_definitions); i += 1) {
@@ -48,155 +67,166 @@ struct entity_definition* world_find_def(const char* name) {
    return NULL;
 }
 
-struct type_location {
-    uint8_t type;
-    uint8_t offset;
-};
-
-enum type_location_types {
-    TYPE_LOCATION_STRING,
-};
+static void world_loader_check_conditions(struct world_loader* loader) {
+    struct world_blob* blob = loader->world->blob;
+    int word_count = (blob->condition_count + 31) >> 5;
 
-void world_apply_types(void* definition, char* string_table, struct type_location* type_locations, int type_location_count) {
-    for (int i = 0; i < type_location_count; i += 1) {
-        switch (type_locations[i].type) {
-            case TYPE_LOCATION_STRING: {
-                char** entry_location = (char**)((char*)definition + type_locations[i].offset);
-                *entry_location += (int)string_table;
-                break;
-            }
-        }
+    if (!word_count) {
+        loader->condition_results = NULL;
+        return;
     }
-}
-
-#define EXPECTED_CONDITION_HEADER 0x45585052
 
-bool world_load_check_condition(FILE* file) {
-    struct expression expression;
-    int header;
-    fread(&header, 1, 4, file);
-    assert(header == EXPECTED_CONDITION_HEADER);
-    uint16_t byte_size;
-    fread(&byte_size, 1, 2, file);
-    char expression_program[byte_size];
-    expression.expression_program = expression_program;
-    fread(expression.expression_program, 1, byte_size, file);
+    loader->condition_results = tagged_malloc(MEMORY_TAG_WORLD, sizeof(uint32_t) * word_count);
+    memset(loader->condition_results, 0, sizeof(uint32_t) * word_count);
 
     struct evaluation_context eval_context;
     evaluation_context_init(&eval_context, 0);
 
-    expression_evaluate(&eval_context, &expression);
+    for (int i = 0; i < blob->condition_count; i += 1) {
+        // conditions are only checked once so they are translated onto
+        // the stack instead of allocated
+        struct expression_instruction instructions[expression_translate(blob->conditions[i], NULL)];
+        expression_translate(blob->conditions[i], instructions);
 
-    int result = evaluation_context_pop(&eval_context);
+        struct expression expression;
+        expression.instructions = instructions;
+        expression_evaluate(&eval_context, &expression);
 
-    evaluation_context_destroy(&eval_context);
+        if (evaluation_context_pop(&eval_context)) {
+            loader->condition_results[i >> 5] |= 1u << (i & 0x1F);
+        }
+    }
 
-    return result != 0;
+    evaluation_context_destroy(&eval_context);
 }
 
-void world_load_entity(struct world* world, struct entity_data* entity_data, FILE* file) {
-    uint8_t name_len;
-    fread(&name_len, 1, 1, file);
-    char name[name_len + 1];
-    fread(name, 1, name_len, file);
-    name[name_len] = '\0';
+static bool world_loader_condition_passed(struct world_loader* loader, uint16_t condition) {
+    if (condition == WORLD_CONDITION_ALWAYS) {
+        return true;
+    }
 
-    struct entity_definition* def = world_find_def(name);
+    return (loader->condition_results[condition >> 5] & (1u << (condition & 0x1F))) != 0;
+}
 
-    assert(def);
+void world_destroy_entity(struct entity_data* entity_data) {
+    char* entity = entity_data->entities;
+
+    for (int entity_index = 0; entity_index < entity_data->entity_count; entity_index += 1) {
+        entity_data->definition->destroy(entity);
+        entity += entity_data->definition->entity_size;
+    }
+}
 
-    fread(&entity_data->entity_count, 2, 1, file);
-    uint16_t definition_size;
-    fread(&definition_size, 2, 1, file);
-    assert(definition_size == def->definition_size);
+#ifdef FRAME_PROFILE
+static const char* world_loader_stage_names[WORLD_LOADER_STAGE_COUNT] = {
+    "read",
+    "relocate",
+    "header",
+    "static",
+    "entities",
+    "done",
+};
+#endif
 
-    uint8_t type_location_count;
+void world_loader_begin(struct world_loader* loader, const char* filename) {
+    loader->stage = WORLD_LOADER_STAGE_READ;
+    loader->stop_stage = WORLD_LOADER_STAGE_DONE;
+    strncpy(loader->filename, filename, sizeof(loader->filename) - 1);
+    loader->filename[sizeof(loader->filename) - 1] = '\0';
 
-    fread(&type_location_count, 1, 1, file);
+    loader->file = asset_fopen(filename, NULL);
+    assert(loader->file);
 
-    struct type_location type_locations[type_location_count];
-    fread(type_locations, sizeof(struct type_location), type_location_count, file);
+    struct world_file_header header;
+    fread(&header, sizeof(struct world_file_header), 1, loader->file);
+    assert(header.header == EXPECTED_HEADER);
+    assert(header.version == WORLD_VERSION);
 
-    char* entity = malloc(def->entity_size * entity_data->entity_count);
-    char entity_def_data[definition_size * entity_data->entity_count];
-    char* entity_def = entity_def_data;
+    // make room for the new world from resources the previous world left behind
+    resource_cache_trim_under_pressure();
 
-    entity_data->definition = def;
-    entity_data->entities = entity;
+    loader->world = tagged_malloc(MEMORY_TAG_WORLD, sizeof(struct world));
+    loader->world->blob = tagged_malloc(MEMORY_TAG_WORLD, header.blob_size);
+    loader->world->static_entity_count = header.static_count;
+    loader->world->frame_memory_size = header.frame_memory_kb ? header.frame_memory_kb * 1024 : FRAME_MEMORY_SIZE;
 
-    fread(entity_def_data, definition_size, entity_data->entity_count, file);
+    loader->blob_size = header.blob_size;
+    loader->bytes_read = 0;
+    loader->relocation_count = header.relocation_count;
 
-    int final_count = 0;
+    loader->current_index = 0;
+    loader->current_group = 0;
+    loader->current_entity = 0;
+    loader->condition_results = NULL;
 
-    for (int entity_index = 0; entity_index < entity_data->entity_count; entity_index += 1) {
-        if (world_load_check_condition(file)) {
-            world_apply_types(entity_def, world->string_table, type_locations, type_location_count);
-            def->init(entity, entity_def);
-            entity += def->entity_size;
-            final_count += 1;
-        }
+    loader->frame_count = 0;
 
-        entity_def += def->definition_size;
+    for (int i = 0; i < WORLD_LOADER_STAGE_COUNT; i += 1) {
+        loader->stage_ticks[i] = 0;
     }
-
-    entity_data->entity_count = final_count;
 }
 
-void world_destroy_entity(struct entity_data* entity_data) {
-    char* entity = entity_data->entities;
+static void world_loader_read_chunk(struct world_loader* loader) {
+    int chunk_size = loader->blob_size - loader->bytes_read;
 
-    for (int entity_index = 0; entity_index < entity_data->entity_count; entity_index += 1) {
-        entity_data->definition->destroy(entity);
-        entity += entity_data->definition->entity_size;
+    if (chunk_size > WORLD_LOADER_READ_CHUNK) {
+        chunk_size = WORLD_LOADER_READ_CHUNK;
     }
 
-    free(entity_data->entities);
+    int bytes_read = fread((char*)loader->world->blob + loader->bytes_read, 1, chunk_size, loader->file);
+    assert(bytes_read == chunk_size);
+    loader->bytes_read += bytes_read;
+
+    if (loader->bytes_read == loader->blob_size) {
+        loader->stage = WORLD_LOADER_STAGE_RELOCATE;
+    }
 }
 
-struct world* world_load(const char* filename) {
-    FILE* file = asset_fopen(filename, NULL);
+static void world_loader_relocate(struct world_loader* loader) {
+    uint32_t relocations[WORLD_LOADER_RELOCATION_CHUNK];
+    int count = loader->relocation_count;
+
+    if (count > WORLD_LOADER_RELOCATION_CHUNK) {
+        count = WORLD_LOADER_RELOCATION_CHUNK;
+    }
 
-    int header;
-    fread(&header, 1, 4, file);
-    assert(header == EXPECTED_HEADER);
+    fread(relocations, sizeof(uint32_t), count, loader->file);
 
-    struct world* world = malloc(sizeof(struct world));
+    char* base = (char*)loader->world->blob;
 
-    struct player_definition player_def;
-    player_def.location = gZeroVec;
-    player_def.rotation = gRight2;
+    for (int i = 0; i < count; i += 1) {
+        assert(relocations[i] + sizeof(char*) <= loader->blob_size);
+        char** pointer = (char**)(base + relocations[i]);
+        *pointer = base + (int)*pointer;
+    }
 
-    uint8_t location_count;
-    fread(&location_count, 1, 1, file);
+    loader->relocation_count -= count;
 
-    bool found_entry = false;
-    
-    for (int i = 0; i < location_count; i += 1) {
-        uint8_t name_length;
-        fread(&name_length, 1, 1, file);
-        char name[name_length + 1];
-        fread(name, name_length, 1, file);
-        name[name_length] = '\0';
+    if (!loader->relocation_count) {
+        loader->stage = WORLD_LOADER_STAGE_HEADER;
+    }
+}
 
-        struct Vector3 pos;
-        struct Vector2 rot;
+static void world_loader_read_header(struct world_loader* loader) {
+    struct world* world = loader->world;
+    struct world_blob* blob = world->blob;
 
-        fread(&pos, sizeof(struct Vector3), 1, file);
-        fread(&rot, sizeof(struct Vector2), 1, file);
+    struct player_definition player_def;
+    player_def.location = gZeroVec;
+    player_def.rotation = gRight2;
 
-        if (found_entry) {
-            continue;
-        }
+    for (int i = 0; i < blob->location_count; i += 1) {
+        struct world_location* location = &blob->locations[i];
 
-        if (strcmp(name, "default") == 0) {
-            player_def.location = pos;
-            player_def.rotation = rot;
+        if (strcmp(location->name, "default") == 0) {
+            player_def.location = location->position;
+            player_def.rotation = location->rotation;
         }
 
-        if (strcmp(name, world_get_next_entry()) == 0) {
-            player_def.location = pos;
-            player_def.rotation = rot;
-            found_entry = true;
+        if (strcmp(location->name, world_get_next_entry()) == 0) {
+            player_def.location = location->position;
+            player_def.rotation = location->rotation;
+            break;
         }
     }
 
@@ -208,52 +238,192 @@ struct world* world_load(const char* filename) {
     pause_menu_init(&world->pause_menu);
     hud_init(&world->hud, &world->player);
 
-    uint16_t static_count;
-    fread(&static_count, 2, 1, file);
+    world->mesh_collider = &blob->mesh_collider;
+    collision_scene_use_static_collision(world->mesh_collider);
+
+    world->loading_zones = blob->loading_zones;
+    world->loading_zone_count = blob->loading_zone_count;
 
-    world->static_entities = malloc(sizeof(struct static_entity) * static_count);
-    world->static_entity_count = static_count;
+    world->static_entities = world_malloc(sizeof(struct static_entity) * world->static_entity_count);
 
-    for (int i = 0; i < static_count; ++i) {
+    // entities for every group share a single allocation
+    int entity_memory_size = 0;
+
+    for (int i = 0; i < blob->entity_group_count; i += 1) {
+        struct world_entity_group* group = &blob->entity_groups[i];
+        struct entity_definition* def = world_find_def(group->name);
+        assert(def);
+        assert(group->definition_size == def->definition_size);
+        entity_memory_size += ALIGN_8(def->entity_size * group->entity_count);
+    }
+
+    world->entity_data_count = blob->entity_group_count;
+    world->entity_data = world_malloc(sizeof(struct entity_data) * world->entity_data_count);
+    world->entity_memory = world_malloc(entity_memory_size);
+
+    char* entity_memory = world->entity_memory;
+
+    for (int i = 0; i < blob->entity_group_count; i += 1) {
+        struct world_entity_group* group = &blob->entity_groups[i];
+        struct entity_data* entity_data = &world->entity_data[i];
+        entity_data->definition = world_find_def(group->name);
+        entity_data->entities = entity_memory;
+        entity_data->entity_count = 0;
+        entity_memory += ALIGN_8(entity_data->definition->entity_size * group->entity_count);
+    }
+
+    loader->current_index = 0;
+    loader->stage = WORLD_LOADER_STAGE_STATIC;
+}
+
+static void world_loader_read_static(struct world_loader* loader) {
+    struct world* world = loader->world;
+
+    if (loader->current_index < world->static_entity_count) {
         uint8_t str_len;
-        fread(&str_len, 1, 1, file);
+        fread(&str_len, 1, 1, loader->file);
+        tmesh_load(&world->static_entities[loader->current_index].tmesh, loader->file);
+        loader->current_index += 1;
+        return;
+    }
 
-        struct static_entity* entity = &world->static_entities[i];
-        tmesh_load(&world->static_entities[i].tmesh, file);
+    fclose(loader->file);
+    loader->file = NULL;
+
+    world_loader_check_conditions(loader);
+
+    loader->current_group = 0;
+    loader->current_entity = 0;
+    loader->stage = WORLD_LOADER_STAGE_ENTITIES;
+}
+
+static void world_loader_read_entity(struct world_loader* loader) {
+    struct world* world = loader->world;
+
+    if (loader->current_group == world->entity_data_count) {
+        tagged_free(loader->condition_results);
+        loader->condition_results = NULL;
+
+        render_scene_add(NULL, 0.0f, world_render, world);
+        world->update_id = update_add(world, world_update, UPDATE_PRIORITY_CAMERA, UPDATE_LAYER_WORLD);
+        loader->stage = WORLD_LOADER_STAGE_DONE;
+        return;
     }
 
-    mesh_collider_load(&world->mesh_collider, file);
-    collision_scene_use_static_collision(&world->mesh_collider);
+    struct world_entity_group* group = &world->blob->entity_groups[loader->current_group];
+    struct entity_data* entity_data = &world->entity_data[loader->current_group];
 
-    uint16_t strings_length;
-    fread(&strings_length, 2, 1, file);
+    if (loader->current_entity == group->entity_count) {
+        loader->current_group += 1;
+        loader->current_entity = 0;
+        return;
+    }
+
+    struct entity_definition* def = entity_data->definition;
 
-    world->string_table = malloc(strings_length);
-    fread(world->string_table, strings_length, 1, file);
+    if (world_loader_condition_passed(loader, group->condition_indices[loader->current_entity])) {
+        char* entity = (char*)entity_data->entities + def->entity_size * entity_data->entity_count;
+        def->init(entity, (char*)group->definitions + def->definition_size * loader->current_entity);
+        entity_data->entity_count += 1;
+    }
 
-    fread(&world->entity_data_count, 2, 1, file);
+    loader->current_entity += 1;
+}
 
-    world->entity_data = malloc(sizeof(struct entity_data) * world->entity_data_count);
+#ifdef FRAME_PROFILE
+static void world_loader_log_timings(struct world_loader* loader) {
+    long long total = 0;
 
-    for (int i = 0; i < world->entity_data_count; i += 1) {
-        world_load_entity(world, &world->entity_data[i], file);
+    fprintf(stderr, "world_loader: loaded %s in %d frames\n", loader->filename, loader->frame_count);
+
+    for (int i = 0; i < WORLD_LOADER_STAGE_DONE; i += 1) {
+        fprintf(stderr, "    %-14s %6dus\n", world_loader_stage_names[i], (int)TICKS_TO_US(loader->stage_ticks[i]));
+        total += loader->stage_ticks[i];
     }
 
-    fread(&world->loading_zone_count, 2, 1, file);
+    fprintf(stderr, "    %-14s %6dus\n", "total", (int)TICKS_TO_US(total));
+}
+#endif
+
+void world_loader_cancel(struct world_loader* loader) {
+    assert(loader->stage < WORLD_LOADER_STAGE_HEADER);
 
-    world->loading_zones = malloc(sizeof(struct loading_zone) * world->loading_zone_count);
-    fread(world->loading_zones, sizeof(struct loading_zone), world->loading_zone_count, file);
+    fclose(loader->file);
+    loader->file = NULL;
+    // tagged_malloc(blob) and tagged_malloc(world) are done in world_loader_begin
+    tagged_free(loader->world->blob);
+    tagged_free(loader->world);
+    loader->world = NULL;
+}
 
-    for (int i = 0; i < world->loading_zone_count; i += 1) {
-        world->loading_zones[i].world_name += (int)world->string_table;
+bool world_loader_step(struct world_loader* loader, long long budget) {
+    if (loader->stage >= loader->stop_stage) {
+        return loader->stage == WORLD_LOADER_STAGE_DONE;
     }
 
-    fclose(file);
+    long long start = timer_ticks();
+    long long now = start;
+    loader->frame_count += 1;
 
-    render_scene_add(NULL, 0.0f, world_render, world);
-    update_add(world, world_update, UPDATE_PRIORITY_CAMERA, UPDATE_LAYER_WORLD);
+    // always make some progress even if a single step is over budget
+    do {
+        enum world_loader_stage stage = loader->stage;
 
-    return world;
+        switch (stage) {
+            case WORLD_LOADER_STAGE_READ:
+                world_loader_read_chunk(loader);
+                break;
+            case WORLD_LOADER_STAGE_RELOCATE:
+                world_loader_relocate(loader);
+                break;
+            case WORLD_LOADER_STAGE_HEADER:
+                world_loader_read_header(loader);
+                break;
+            case WORLD_LOADER_STAGE_STATIC:
+                world_loader_read_static(loader);
+                break;
+            case WORLD_LOADER_STAGE_ENTITIES:
+                world_loader_read_entity(loader);
+                break;
+            default:
+                break;
+        }
+
+        long long prev = now;
+        now = timer_ticks();
+        loader->stage_ticks[stage] += now - prev;
+    } while (loader->stage < loader->stop_stage && now - start < budget);
+
+    if (loader->stage == WORLD_LOADER_STAGE_DONE) {
+#ifdef FRAME_PROFILE
+        world_loader_log_timings(loader);
+#endif
+#ifdef MEMORY_PROFILE
+        resource_cache_report();
+        world_arena_report("loaded");
+#endif
+        return true;
+    }
+
+    return false;
+}
+
+float world_loader_progress(struct world_loader* loader) {
+    // reading the blob is counted as half of the work
+    if (loader->stage == WORLD_LOADER_STAGE_READ) {
+        return 0.5f * (float)loader->bytes_read / (float)loader->blob_size;
+    }
+
+    return 0.5f + 0.5f * (float)loader->stage / (float)WORLD_LOADER_STAGE_DONE;
+}
+
+struct world* world_load(const char* filename) {
+    struct world_loader loader;
+    world_loader_begin(&loader, filename);
+
+    while (!world_loader_step(&loader, WORLD_LOADER_NO_BUDGET));
+
+    return loader.world;
 }
 
 void world_release(struct world* world) {
@@ -261,14 +431,17 @@ void world_release(struct world* world) {
         return;
     }
 
+    // entities waiting to be destroyed are still part of this world
+    background_flush_deferred();
+
     for (int i = 0; i < world->static_entity_count; ++i) {
         struct static_entity* entity = &world->static_entities[i];
         tmesh_release(&entity->tmesh);
     }
-    free(world->static_entities);
+    world_free(world->static_entities);
 
     render_scene_remove(world);
-    update_remove(world);
+    update_remove(world->update_id);
 
     pause_menu_destroy(&world->pause_menu);
     hud_destroy(&world->hud);
@@ -277,16 +450,23 @@ void world_release(struct world* world) {
 
     inventory_destroy();
 
-    collision_scene_remove_static_collision(&world->mesh_collider);
-    mesh_collider_release(&world->mesh_collider);
+    collision_scene_remove_static_collision(world->mesh_collider);
 
     for (int i = 0; i < world->entity_data_count; i += 1) {
         world_destroy_entity(&world->entity_data[i]);
     }
-    free(world->entity_data);
+    world_free(world->entity_data);
+    world_free(world->entity_memory);
+
+    // the blob and world struct stay on the heap since a prefetched
+    // world may read its blob before this world is released
+    tagged_free(world->blob);
 
-    free(world->string_table);
-    free(world->loading_zones);
+    tagged_free(world);
 
-    free(world);
+#ifdef MEMORY_PROFILE
+    effect_allocator_report();
+    world_arena_report("released");
+#endif
+    world_arena_reset();
 }
\ No newline at end of file
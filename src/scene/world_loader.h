@@ -1,8 +1,60 @@
 #ifndef __SCENE_WORLD_LOADER_H__
 #define __SCENE_WORLD_LOADER_H__
 
+#include <stdio.h>
 #include "world.h"
 
+#define WORLD_LOADER_READ_CHUNK         (8 * 1024)
+#define WORLD_LOADER_RELOCATION_CHUNK   256
+#define WORLD_LOADER_FRAME_BUDGET       TICKS_FROM_MS(6)
+#define WORLD_LOADER_NO_BUDGET          0x7FFFFFFFFFFFFFFFLL
+
+enum world_loader_stage {
+    WORLD_LOADER_STAGE_READ,
+    WORLD_LOADER_STAGE_RELOCATE,
+    WORLD_LOADER_STAGE_HEADER,
+    WORLD_LOADER_STAGE_STATIC,
+    WORLD_LOADER_STAGE_ENTITIES,
+    WORLD_LOADER_STAGE_DONE,
+
+    WORLD_LOADER_STAGE_COUNT,
+};
+
+// loads a world over multiple frames, each call to
+// world_loader_step does work until the time budget is used up
+struct world_loader {
+    enum world_loader_stage stage;
+    // stages before WORLD_LOADER_STAGE_HEADER have no side effects
+    // so a loader can be stopped there and finished later
+    enum world_loader_stage stop_stage;
+    char filename[64];
+
+    FILE* file;
+    uint32_t blob_size;
+    uint32_t bytes_read;
+    uint32_t relocation_count;
+
+    struct world* world;
+
+    uint16_t current_index;
+    uint16_t current_group;
+    uint16_t current_entity;
+
+    // a bit per world condition that passed, only set while
+    // entities are being loaded
+    uint32_t* condition_results;
+
+    int frame_count;
+    long long stage_ticks[WORLD_LOADER_STAGE_COUNT];
+};
+
+void world_loader_begin(struct world_loader* loader, const char* filename);
+// returns true once loader->world is ready to use
+bool world_loader_step(struct world_loader* loader, long long budget);
+float world_loader_progress(struct world_loader* loader);
+// only valid before the loader has reached WORLD_LOADER_STAGE_HEADER
+void world_loader_cancel(struct world_loader* loader);
+
 struct world* world_load(const char* filename);
 void world_release(struct world* world);
 
@@ -0,0 +1,80 @@
+#include "world_loader.h"
+#include "../test/framework_test.h"
+#include "../util/memory_tag.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <libdragon.h>
+
+#define WORLD_LOAD_BENCHMARK_ITERATIONS 4
+
+// average load time of the same world with the per field loader that the
+// relocatable blob replaced, build with WORLD_LOAD_BASELINE_US=<us> after
+// running this test on a build from before the change to compare the two
+#ifndef WORLD_LOAD_BASELINE_US
+#define WORLD_LOAD_BASELINE_US  0
+#endif
+
+void test_world_load_benchmark(struct test_context* t) {
+    long long total_ticks = 0;
+    struct mallinfo before = mallinfo();
+
+    for (int i = 0; i < WORLD_LOAD_BENCHMARK_ITERATIONS; i += 1) {
+        long long start = timer_ticks();
+        struct world* world = world_load("rom:/worlds/playerhome_basement.world");
+        total_ticks += timer_ticks() - start;
+
+        test_neqp(t, NULL, world);
+        world_release(world);
+    }
+
+    struct mallinfo after = mallinfo();
+
+    int average_us = (int)TICKS_TO_US(total_ticks / WORLD_LOAD_BENCHMARK_ITERATIONS);
+
+    fprintf(
+        stderr, 
+        "world_load average %dus heap delta %d bytes free chunks %d -> %d\n", 
+        average_us,
+        after.uordblks - before.uordblks,
+        before.ordblks,
+        after.ordblks
+    );
+
+#if WORLD_LOAD_BASELINE_US
+    fprintf(
+        stderr,
+        "world_load before %dus after %dus (%d%% of the baseline)\n",
+        WORLD_LOAD_BASELINE_US,
+        average_us,
+        average_us * 100 / WORLD_LOAD_BASELINE_US
+    );
+#else
+    fprintf(stderr, "world_load no baseline recorded, see WORLD_LOAD_BASELINE_US\n");
+#endif
+}
+
+#define WORLD_LEAK_TEST_ITERATIONS  3
+
+void test_world_load_leaks(struct test_context* t) {
+    // the first load fills resource caches and creates the world arena
+    world_release(world_load("rom:/worlds/playerhome_basement.world"));
+
+    struct memory_tag_stats before[MEMORY_TAG_COUNT];
+
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag += 1) {
+        before[tag] = *memory_tag_get_stats(tag);
+    }
+
+    for (int i = 0; i < WORLD_LEAK_TEST_ITERATIONS; i += 1) {
+        struct world* world = world_load("rom:/worlds/playerhome_basement.world");
+        test_neqp(t, NULL, world);
+        world_release(world);
+    }
+
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag += 1) {
+        struct memory_tag_stats* after = memory_tag_get_stats(tag);
+        test_eqi(t, before[tag].current_bytes, after->current_bytes);
+        test_eqi(t, before[tag].live_count, after->live_count);
+    }
+}
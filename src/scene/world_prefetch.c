@@ -0,0 +1,246 @@
+#include "world_prefetch.h"
+
+#include <string.h>
+#include <libdragon.h>
+#include "../resource/material_cache.h"
+
+// WMAN
+#define EXPECTED_MANIFEST_HEADER 0x574D414E
+
+struct world_manifest_header {
+    uint32_t header;
+    uint32_t blob_size;
+    uint16_t static_count;
+    uint8_t dependency_count;
+} __attribute__((packed));
+
+static struct world_loader prefetch_loader;
+static char prefetch_filename[64];
+// a world was picked but its manifest hasn't been opened yet,
+// the file work is left to the background job
+static bool prefetch_pending;
+static bool prefetch_active;
+
+static FILE* prefetch_manifest;
+static uint8_t prefetch_remaining_dependencies;
+
+static struct material* prefetch_dependencies[WORLD_PREFETCH_MAX_DEPENDENCIES];
+static uint8_t prefetch_dependency_count;
+
+static struct world_prefetch_stats prefetch_stats;
+
+static void world_prefetch_target_filename(const char* world_name, char* out, int max_length) {
+    int i = 0;
+
+    while (world_name[i] && world_name[i] != '#' && i < max_length - 1) {
+        out[i] = world_name[i];
+        i += 1;
+    }
+
+    out[i] = '\0';
+}
+
+static float world_prefetch_distance_sqrd(struct Box3D* box, struct Vector3* point) {
+    struct Vector3 closest;
+    vector3Max(point, &box->min, &closest);
+    vector3Min(&closest, &box->max, &closest);
+    return vector3DistSqrd(&closest, point);
+}
+
+static void world_prefetch_close_manifest() {
+    if (prefetch_manifest) {
+        fclose(prefetch_manifest);
+        prefetch_manifest = NULL;
+    }
+
+    prefetch_remaining_dependencies = 0;
+}
+
+void world_prefetch_release_dependencies() {
+    for (int i = 0; i < prefetch_dependency_count; i += 1) {
+        material_cache_release(prefetch_dependencies[i]);
+    }
+
+    prefetch_dependency_count = 0;
+}
+
+void world_prefetch_cancel() {
+    if (prefetch_active) {
+        world_loader_cancel(&prefetch_loader);
+        prefetch_active = false;
+        prefetch_stats.cancelled += 1;
+    }
+
+    prefetch_pending = false;
+    world_prefetch_close_manifest();
+    world_prefetch_release_dependencies();
+    prefetch_filename[0] = '\0';
+}
+
+static void world_prefetch_start(const char* filename) {
+    world_prefetch_cancel();
+
+    // remembered even if the prefetch can't start so it isn't retried every frame
+    strncpy(prefetch_filename, filename, sizeof(prefetch_filename) - 1);
+    prefetch_filename[sizeof(prefetch_filename) - 1] = '\0';
+    prefetch_pending = true;
+}
+
+static void world_prefetch_open() {
+    prefetch_pending = false;
+
+    char manifest_filename[sizeof(prefetch_filename) + 8];
+    strcpy(manifest_filename, prefetch_filename);
+
+    char* extension = strrchr(manifest_filename, '.');
+
+    if (!extension) {
+        return;
+    }
+
+    strcpy(extension, ".manifest");
+
+    FILE* manifest = asset_fopen(manifest_filename, NULL);
+
+    if (!manifest) {
+        return;
+    }
+
+    struct world_manifest_header header;
+    fread(&header, sizeof(struct world_manifest_header), 1, manifest);
+    assert(header.header == EXPECTED_MANIFEST_HEADER);
+
+    if (header.blob_size > WORLD_PREFETCH_MEMORY_BUDGET) {
+        fclose(manifest);
+        prefetch_stats.over_budget += 1;
+        return;
+    }
+
+    prefetch_manifest = manifest;
+    prefetch_remaining_dependencies = header.dependency_count;
+
+    world_loader_begin(&prefetch_loader, prefetch_filename);
+    prefetch_loader.stop_stage = WORLD_LOADER_STAGE_HEADER;
+    prefetch_active = true;
+    prefetch_stats.started += 1;
+}
+
+static void world_prefetch_load_dependency() {
+    uint8_t name_length;
+    fread(&name_length, 1, 1, prefetch_manifest);
+    char name[name_length + 1];
+    fread(name, 1, name_length, prefetch_manifest);
+    name[name_length] = '\0';
+
+    prefetch_remaining_dependencies -= 1;
+
+    if (prefetch_dependency_count < WORLD_PREFETCH_MAX_DEPENDENCIES) {
+        prefetch_dependencies[prefetch_dependency_count] = material_cache_load(name);
+        prefetch_dependency_count += 1;
+    }
+
+    if (!prefetch_remaining_dependencies) {
+        world_prefetch_close_manifest();
+    }
+}
+
+void world_prefetch_update(struct world* world, struct Vector3* player_center) {
+    float closest_distance = WORLD_PREFETCH_DISTANCE * WORLD_PREFETCH_DISTANCE;
+    struct loading_zone* closest = NULL;
+    bool keep_current = false;
+
+    for (int i = 0; i < world->loading_zone_count; i += 1) {
+        struct loading_zone* zone = &world->loading_zones[i];
+        float distance = world_prefetch_distance_sqrd(&zone->bounding_box, player_center);
+
+        if (distance < closest_distance) {
+            closest_distance = distance;
+            closest = zone;
+        }
+
+        // once started the prefetch is kept until the player
+        // is well outside the range of the loading zone
+        if (distance < 4.0f * WORLD_PREFETCH_DISTANCE * WORLD_PREFETCH_DISTANCE) {
+            char filename[sizeof(prefetch_filename)];
+            world_prefetch_target_filename(zone->world_name, filename, sizeof(filename));
+            keep_current = keep_current || strcmp(filename, prefetch_filename) == 0;
+        }
+    }
+
+    if (closest) {
+        char filename[sizeof(prefetch_filename)];
+        world_prefetch_target_filename(closest->world_name, filename, sizeof(filename));
+
+        if (!keep_current) {
+            world_prefetch_start(filename);
+        }
+    } else if (!keep_current && prefetch_filename[0]) {
+        world_prefetch_cancel();
+    }
+
+}
+
+bool world_prefetch_background_step(void* data, long long deadline) {
+    if (prefetch_pending) {
+        world_prefetch_open();
+        return prefetch_active;
+    }
+
+    if (!prefetch_active) {
+        return false;
+    }
+
+    if (prefetch_remaining_dependencies) {
+        world_prefetch_load_dependency();
+        return true;
+    }
+
+    long long budget = deadline - timer_ticks();
+
+    if (budget <= 0) {
+        return true;
+    }
+
+    world_loader_step(&prefetch_loader, budget);
+    return prefetch_loader.stage < prefetch_loader.stop_stage;
+}
+
+bool world_prefetch_take(const char* filename, struct world_loader* loader) {
+    if (!prefetch_active || strcmp(filename, prefetch_filename) != 0) {
+        prefetch_stats.misses += 1;
+        world_prefetch_cancel();
+        fprintf(stderr, "world_prefetch: miss %s\n", filename);
+        return false;
+    }
+
+    if (prefetch_loader.stage >= prefetch_loader.stop_stage) {
+        prefetch_stats.hits += 1;
+    } else {
+        prefetch_stats.partial_hits += 1;
+    }
+
+    fprintf(
+        stderr, 
+        "world_prefetch: hit %s hits %d partial %d misses %d cancelled %d over budget %d\n", 
+        filename, 
+        prefetch_stats.hits, 
+        prefetch_stats.partial_hits, 
+        prefetch_stats.misses, 
+        prefetch_stats.cancelled,
+        prefetch_stats.over_budget
+    );
+
+    // any dependencies not yet loaded are loaded with the static meshes
+    world_prefetch_close_manifest();
+
+    *loader = prefetch_loader;
+    loader->stop_stage = WORLD_LOADER_STAGE_DONE;
+    prefetch_active = false;
+    prefetch_filename[0] = '\0';
+
+    return true;
+}
+
+struct world_prefetch_stats* world_prefetch_get_stats() {
+    return &prefetch_stats;
+}
@@ -0,0 +1,39 @@
+#ifndef __SCENE_WORLD_PREFETCH_H__
+#define __SCENE_WORLD_PREFETCH_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "world.h"
+#include "world_loader.h"
+
+#define WORLD_PREFETCH_DISTANCE         4.0f
+#define WORLD_PREFETCH_MEMORY_BUDGET    (192 * 1024)
+#define WORLD_PREFETCH_MAX_DEPENDENCIES 16
+
+struct world_prefetch_stats {
+    uint16_t started;
+    // the prefetch had finished by the time it was needed
+    uint16_t hits;
+    // the prefetch was still running by the time it was needed
+    uint16_t partial_hits;
+    uint16_t misses;
+    uint16_t cancelled;
+    uint16_t over_budget;
+};
+
+// starts prefetching the world behind the nearest loading
+// zone or cancels a prefetch the player has walked away from
+void world_prefetch_update(struct world* world, struct Vector3* player_center);
+// background job that does the prefetch loading in idle time
+bool world_prefetch_background_step(void* data, long long deadline);
+
+// if filename is the world being prefetched the in progress
+// loader is moved into loader and true is returned
+bool world_prefetch_take(const char* filename, struct world_loader* loader);
+// dependencies are kept loaded until the taken loader is finished
+void world_prefetch_release_dependencies();
+void world_prefetch_cancel();
+
+struct world_prefetch_stats* world_prefetch_get_stats();
+
+#endif
@@ -2,17 +2,16 @@
 #define __SPELL_PROJECTILE_H__
 
 #include "../math/vector3.h"
-#include "../collision/dynamic_object.h"
 
 #include "spell_sources.h"
 #include "spell_event.h"
 #include "elements.h"
+#include "projectile_manager.h"
 
 struct projectile {
-    struct Vector3 pos;
     struct spell_data_source* data_source;
     struct spell_data_source* data_output;
-    struct dynamic_object dynamic_object;
+    projectile_id id;
     uint16_t has_hit: 1;
     uint16_t has_primary_event: 1;
     uint16_t has_secondary_event: 1;
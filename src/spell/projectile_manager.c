@@ -0,0 +1,445 @@
+#include "projectile_manager.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "../collision/collision_scene.h"
+#include "../collision/collision_profile.h"
+#include "../render/render_scene.h"
+#include "../render/defs.h"
+#include "../math/matrix.h"
+#include "../time/time.h"
+#include "../util/hash.h"
+
+#include "assets.h"
+
+#define PROJECTILE_BOUNCE       0.4f
+#define PROJECTILE_FRICTION     0.25f
+// keeps a projectile resting on the ground from starting its next
+// sweep inside the triangle it landed on
+#define PROJECTILE_SKIN         0.01f
+
+enum projectile_flags {
+    PROJECTILE_FLAGS_GRAVITY = (1 << 0),
+    PROJECTILE_FLAGS_HIT = (1 << 1),
+};
+
+// indices [0, count) are live, removing a projectile moves the last
+// one into its place so an id maps to wherever it currently is
+struct projectile_manager {
+    struct Vector3 positions[MAX_PROJECTILES];
+    struct Vector3 velocities[MAX_PROJECTILES];
+    struct projectile_hit hits[MAX_PROJECTILES];
+    entity_id entity_ids[MAX_PROJECTILES];
+    uint16_t collision_layers[MAX_PROJECTILES];
+    uint16_t collision_groups[MAX_PROJECTILES];
+    uint8_t flags[MAX_PROJECTILES];
+    projectile_id ids[MAX_PROJECTILES];
+
+    uint8_t index_of[MAX_PROJECTILES];
+    projectile_id free_ids[MAX_PROJECTILES];
+    uint8_t count;
+    uint8_t free_count;
+
+    struct projectile_manager_stats stats;
+};
+
+static struct projectile_manager g_projectile_manager;
+
+extern struct collision_scene g_scene;
+
+struct projectile_render_data {
+    struct tmesh* mesh;
+    T3DMat4FP* transforms;
+    int count;
+};
+
+static void projectile_manager_render_callback(void* data, struct render_batch* batch) {
+    struct projectile_render_data* render_data = (struct projectile_render_data*)data;
+
+    for (int i = 0; i < render_data->count; i += 1) {
+        t3d_matrix_push(&render_data->transforms[i]);
+        rspq_block_run(render_data->mesh->block);
+        t3d_matrix_pop(1);
+    }
+}
+
+static void projectile_manager_render(void* data, struct render_batch* batch) {
+    struct projectile_manager* manager = (struct projectile_manager*)data;
+
+    if (!manager->count) {
+        return;
+    }
+
+    struct projectile_render_data* render_data = frame_malloc(batch->pool, sizeof(struct projectile_render_data));
+    T3DMat4FP* transforms = UncachedAddr(frame_malloc(batch->pool, sizeof(T3DMat4FP) * manager->count));
+
+    if (!render_data || !transforms) {
+        return;
+    }
+
+    for (int i = 0; i < manager->count; i += 1) {
+        mat4x4 mtx;
+        struct Vector3 scaled_position;
+        vector3Scale(&manager->positions[i], &scaled_position, SCENE_SCALE);
+        matrixFromPosition(mtx, &scaled_position);
+        t3d_mat4_to_fixed_3x4(&transforms[i], (T3DMat4*)mtx);
+    }
+
+    render_data->mesh = spell_assets_get()->projectile_mesh;
+    render_data->transforms = transforms;
+    render_data->count = manager->count;
+
+    // a single element for every projectile so the material is only
+    // set up once and they don't eat into the batch size
+    render_batch_add_callback(batch, render_data->mesh->material, projectile_manager_render_callback, render_data);
+}
+
+void projectile_manager_reset() {
+    struct projectile_manager* manager = &g_projectile_manager;
+
+    manager->count = 0;
+    manager->free_count = MAX_PROJECTILES;
+
+    // hand out the lowest id first
+    for (int i = 0; i < MAX_PROJECTILES; i += 1) {
+        manager->free_ids[i] = MAX_PROJECTILES - 1 - i;
+    }
+
+    memset(&manager->stats, 0, sizeof(manager->stats));
+
+    render_scene_remove(manager);
+    render_scene_add(NULL, 0.0f, projectile_manager_render, manager);
+}
+
+projectile_id projectile_manager_add(struct Vector3* position, struct Vector3* velocity, uint16_t collision_layers, uint16_t collision_group) {
+    struct projectile_manager* manager = &g_projectile_manager;
+
+    if (!manager->free_count) {
+        manager->stats.failed_allocations += 1;
+        return PROJECTILE_INVALID_ID;
+    }
+
+    manager->free_count -= 1;
+    projectile_id id = manager->free_ids[manager->free_count];
+
+    int index = manager->count;
+    manager->count += 1;
+
+    if (manager->count > manager->stats.peak_count) {
+        manager->stats.peak_count = manager->count;
+    }
+
+    manager->positions[index] = *position;
+    manager->velocities[index] = *velocity;
+    manager->entity_ids[index] = entity_id_new();
+    manager->collision_layers[index] = collision_layers;
+    manager->collision_groups[index] = collision_group;
+    manager->flags[index] = 0;
+    manager->ids[index] = id;
+    manager->index_of[id] = index;
+
+    return id;
+}
+
+void projectile_manager_remove(projectile_id id) {
+    struct projectile_manager* manager = &g_projectile_manager;
+
+    if (id == PROJECTILE_INVALID_ID) {
+        return;
+    }
+
+    int index = manager->index_of[id];
+    int last = manager->count - 1;
+
+    assert(index < manager->count && manager->ids[index] == id);
+
+    if (index != last) {
+        manager->positions[index] = manager->positions[last];
+        manager->velocities[index] = manager->velocities[last];
+        manager->hits[index] = manager->hits[last];
+        manager->entity_ids[index] = manager->entity_ids[last];
+        manager->collision_layers[index] = manager->collision_layers[last];
+        manager->collision_groups[index] = manager->collision_groups[last];
+        manager->flags[index] = manager->flags[last];
+        manager->ids[index] = manager->ids[last];
+        manager->index_of[manager->ids[index]] = index;
+    }
+
+    manager->count -= 1;
+    manager->free_ids[manager->free_count] = id;
+    manager->free_count += 1;
+}
+
+static void projectile_manager_sort_targets(struct dynamic_object** targets, int count) {
+    // only a handful of targets, sorted by the left edge of their box
+    for (int i = 1; i < count; i += 1) {
+        struct dynamic_object* target = targets[i];
+        int j = i;
+
+        while (j > 0 && targets[j - 1]->bounding_box.min.x > target->bounding_box.min.x) {
+            targets[j] = targets[j - 1];
+            j -= 1;
+        }
+
+        targets[j] = target;
+    }
+}
+
+// slab test of the swept center against the target box grown by the
+// projectile radius
+static bool projectile_sweep_box(struct Vector3* start, struct Vector3* offset, struct Box3D* box, float* distance, struct Vector3* normal) {
+    float enter = 0.0f;
+    float exit = *distance;
+    int enter_axis = -1;
+
+    for (int axis = 0; axis < 3; axis += 1) {
+        float from = VECTOR3_AS_ARRAY(start)[axis];
+        float move = VECTOR3_AS_ARRAY(offset)[axis];
+        float min = VECTOR3_AS_ARRAY(&box->min)[axis] - PROJECTILE_RADIUS;
+        float max = VECTOR3_AS_ARRAY(&box->max)[axis] + PROJECTILE_RADIUS;
+
+        if (move == 0.0f) {
+            if (from < min || from > max) {
+                return false;
+            }
+
+            continue;
+        }
+
+        float move_inv = 1.0f / move;
+        float near = ((move > 0.0f ? min : max) - from) * move_inv;
+        float far = ((move > 0.0f ? max : min) - from) * move_inv;
+
+        if (near > enter) {
+            enter = near;
+            enter_axis = axis;
+        }
+
+        if (far < exit) {
+            exit = far;
+        }
+
+        if (enter > exit) {
+            return false;
+        }
+    }
+
+    *normal = gZeroVec;
+
+    if (enter_axis == -1) {
+        // started inside the box, push back the way it came
+        vector3Normalize(offset, normal);
+        vector3Negate(normal, normal);
+    } else {
+        VECTOR3_AS_ARRAY(normal)[enter_axis] = VECTOR3_AS_ARRAY(offset)[enter_axis] > 0.0f ? -1.0f : 1.0f;
+    }
+
+    *distance = enter;
+    return true;
+}
+
+static void projectile_manager_bounce(struct Vector3* velocity, struct Vector3* normal) {
+    float normal_speed = vector3Dot(velocity, normal);
+
+    if (normal_speed >= 0.0f) {
+        return;
+    }
+
+    struct Vector3 tangent;
+    vector3AddScaled(velocity, normal, -normal_speed, &tangent);
+    vector3Scale(&tangent, &tangent, 1.0f - PROJECTILE_FRICTION);
+    vector3AddScaled(&tangent, normal, -normal_speed * PROJECTILE_BOUNCE, velocity);
+}
+
+void projectile_manager_step() {
+    struct projectile_manager* manager = &g_projectile_manager;
+
+    if (!manager->count) {
+        return;
+    }
+
+#ifdef COLLISION_PROFILE
+    uint32_t start_ticks = collision_profile_ticks();
+#endif
+
+    struct Vector3 offsets[manager->count];
+    float gravity = fixed_time_step * GRAVITY_CONSTANT;
+
+    // integrate everything first so the sweeps below run back to back
+    for (int i = 0; i < manager->count; i += 1) {
+        manager->flags[i] &= ~PROJECTILE_FLAGS_HIT;
+
+        if (manager->flags[i] & PROJECTILE_FLAGS_GRAVITY) {
+            manager->velocities[i].y += gravity;
+        }
+
+        vector3Scale(&manager->velocities[i], &offsets[i], fixed_time_step);
+    }
+
+    // targets are gathered once for every layer any projectile is on
+    // and filtered per projectile below, the group is only skipped
+    // here if every projectile shares it
+    int collision_layers = 0;
+    int collision_group = manager->collision_groups[0];
+
+    for (int i = 0; i < manager->count; i += 1) {
+        collision_layers |= manager->collision_layers[i];
+
+        if (manager->collision_groups[i] != collision_group) {
+            collision_group = 0;
+        }
+    }
+
+    struct dynamic_object* targets[MAX_PROJECTILE_TARGETS];
+    int target_count = collision_scene_gather(collision_layers, collision_group, targets, MAX_PROJECTILE_TARGETS);
+
+    if (target_count > MAX_PROJECTILE_TARGETS) {
+        manager->stats.dropped_targets += target_count - MAX_PROJECTILE_TARGETS;
+        target_count = MAX_PROJECTILE_TARGETS;
+    }
+
+    projectile_manager_sort_targets(targets, target_count);
+
+    struct mesh_collider* mesh = g_scene.mesh_collider;
+
+    for (int i = 0; i < manager->count; i += 1) {
+        struct Vector3* position = &manager->positions[i];
+        struct Vector3* offset = &offsets[i];
+        struct projectile_hit* hit = &manager->hits[i];
+
+        float distance = 1.0f;
+        bool did_hit = false;
+
+        if (mesh) {
+            struct mesh_sweep_hit mesh_hit;
+
+            if (mesh_collider_sweep_sphere(mesh, position, offset, PROJECTILE_RADIUS, &mesh_hit)) {
+                distance = mesh_hit.distance;
+                hit->point = mesh_hit.point;
+                hit->normal = mesh_hit.normal;
+                hit->other_object = 0;
+                did_hit = true;
+            }
+        }
+
+        float sweep_min_x = position->x + (offset->x < 0.0f ? offset->x : 0.0f) - PROJECTILE_RADIUS;
+        float sweep_max_x = position->x + (offset->x > 0.0f ? offset->x : 0.0f) + PROJECTILE_RADIUS;
+
+        for (int target_index = 0; target_index < target_count; target_index += 1) {
+            struct dynamic_object* target = targets[target_index];
+
+            if (target->bounding_box.min.x > sweep_max_x) {
+                break;
+            }
+
+            if (target->bounding_box.max.x < sweep_min_x) {
+                continue;
+            }
+
+            if (!(target->collision_layers & manager->collision_layers[i])) {
+                continue;
+            }
+
+            if (manager->collision_groups[i] && target->collision_group == manager->collision_groups[i]) {
+                continue;
+            }
+
+            float target_distance = distance;
+            struct Vector3 normal;
+
+            if (!projectile_sweep_box(position, offset, &target->bounding_box, &target_distance, &normal)) {
+                continue;
+            }
+
+            if (did_hit && target_distance >= distance) {
+                continue;
+            }
+
+            distance = target_distance;
+            hit->normal = normal;
+            vector3AddScaled(position, offset, distance, &hit->point);
+            vector3AddScaled(&hit->point, &normal, -PROJECTILE_RADIUS, &hit->point);
+            hit->other_object = target->entity_id;
+            did_hit = true;
+        }
+
+        if (!did_hit) {
+            vector3Add(position, offset, position);
+            continue;
+        }
+
+        // stop at the hit for this step instead of sweeping again
+        vector3AddScaled(position, offset, distance, position);
+        vector3AddScaled(position, &hit->normal, PROJECTILE_SKIN, position);
+        projectile_manager_bounce(&manager->velocities[i], &hit->normal);
+        manager->flags[i] |= PROJECTILE_FLAGS_HIT;
+    }
+
+#ifdef COLLISION_PROFILE
+    collision_profile_add_stage(COLLISION_STAGE_PROJECTILES, start_ticks);
+#endif
+}
+
+struct Vector3* projectile_manager_position(projectile_id id) {
+    return &g_projectile_manager.positions[g_projectile_manager.index_of[id]];
+}
+
+struct Vector3* projectile_manager_velocity(projectile_id id) {
+    return &g_projectile_manager.velocities[g_projectile_manager.index_of[id]];
+}
+
+entity_id projectile_manager_entity(projectile_id id) {
+    return g_projectile_manager.entity_ids[g_projectile_manager.index_of[id]];
+}
+
+void projectile_manager_set_gravity(projectile_id id, bool has_gravity) {
+    uint8_t* flags = &g_projectile_manager.flags[g_projectile_manager.index_of[id]];
+
+    if (has_gravity) {
+        *flags |= PROJECTILE_FLAGS_GRAVITY;
+    } else {
+        *flags &= ~PROJECTILE_FLAGS_GRAVITY;
+    }
+}
+
+struct projectile_hit* projectile_manager_hit(projectile_id id) {
+    int index = g_projectile_manager.index_of[id];
+
+    if (!(g_projectile_manager.flags[index] & PROJECTILE_FLAGS_HIT)) {
+        return NULL;
+    }
+
+    return &g_projectile_manager.hits[index];
+}
+
+projectile_id projectile_manager_find(entity_id entity) {
+    if (!entity) {
+        return PROJECTILE_INVALID_ID;
+    }
+
+    for (int i = 0; i < g_projectile_manager.count; i += 1) {
+        if (g_projectile_manager.entity_ids[i] == entity) {
+            return g_projectile_manager.ids[i];
+        }
+    }
+
+    return PROJECTILE_INVALID_ID;
+}
+
+struct projectile_manager_stats* projectile_manager_get_stats() {
+    return &g_projectile_manager.stats;
+}
+
+uint32_t projectile_manager_state_hash(uint32_t hash) {
+    struct projectile_manager* manager = &g_projectile_manager;
+
+    for (int i = 0; i < manager->count; i += 1) {
+        hash = hash_bytes(hash, &manager->ids[i], sizeof(projectile_id));
+        hash = hash_bytes(hash, &manager->entity_ids[i], sizeof(entity_id));
+        hash = hash_bytes(hash, &manager->positions[i], sizeof(struct Vector3));
+        hash = hash_bytes(hash, &manager->velocities[i], sizeof(struct Vector3));
+    }
+
+    return hash;
+}
@@ -0,0 +1,61 @@
+#ifndef __SPELL_PROJECTILE_MANAGER_H__
+#define __SPELL_PROJECTILE_MANAGER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../math/vector3.h"
+#include "../entity/entity_id.h"
+
+// every projectile in flight is stepped, collided and drawn together
+// instead of each one being its own dynamic_object and render entry
+
+#define MAX_PROJECTILES             64
+#define MAX_PROJECTILE_TARGETS      32
+#define PROJECTILE_RADIUS           0.25f
+#define PROJECTILE_INVALID_ID       0xFF
+
+typedef uint8_t projectile_id;
+
+struct projectile_hit {
+    struct Vector3 point;
+    struct Vector3 normal;
+    // 0 when the static mesh was hit
+    entity_id other_object;
+};
+
+struct projectile_manager_stats {
+    uint32_t failed_allocations;
+    // targets left out because more than MAX_PROJECTILE_TARGETS were in range
+    uint32_t dropped_targets;
+    uint16_t peak_count;
+};
+
+void projectile_manager_reset();
+
+// returns PROJECTILE_INVALID_ID if there is no room
+projectile_id projectile_manager_add(struct Vector3* position, struct Vector3* velocity, uint16_t collision_layers, uint16_t collision_group);
+void projectile_manager_remove(projectile_id id);
+
+// moves every projectile then collides it against the static mesh
+// and anything solid on its collision layers, call after
+// collision_scene_collide
+void projectile_manager_step();
+
+struct Vector3* projectile_manager_position(projectile_id id);
+struct Vector3* projectile_manager_velocity(projectile_id id);
+entity_id projectile_manager_entity(projectile_id id);
+void projectile_manager_set_gravity(projectile_id id, bool has_gravity);
+// what the projectile ran into during the last step or null
+struct projectile_hit* projectile_manager_hit(projectile_id id);
+
+// returns PROJECTILE_INVALID_ID if entity isn't a projectile
+projectile_id projectile_manager_find(entity_id entity);
+
+struct projectile_manager_stats* projectile_manager_get_stats();
+
+// folds the id, position and velocity of every projectile into hash
+// the same way collision_scene_state_hash does for dynamic objects
+uint32_t projectile_manager_state_hash(uint32_t hash);
+
+#endif
@@ -4,6 +4,7 @@
 #include "../time/time.h"
 #include "../render/render_scene.h"
 #include "assets.h"
+#include "projectile_manager.h"
 
 int which_one = 0;
 
@@ -35,6 +36,28 @@ static float burst_mana_amount[] = {
     [ELEMENT_TYPE_LIGHTNING] = 20.0f,
 };
 
+// projectiles aren't in the collision scene so they get looked up
+// in the projectile manager instead
+static bool push_find_target(entity_id target, struct Vector3** position, struct Vector3** velocity) {
+    struct dynamic_object* object = collision_scene_find_object(target);
+
+    if (object) {
+        *position = object->position;
+        *velocity = &object->velocity;
+        return true;
+    }
+
+    projectile_id projectile = projectile_manager_find(target);
+
+    if (projectile == PROJECTILE_INVALID_ID) {
+        return false;
+    }
+
+    *position = projectile_manager_position(projectile);
+    *velocity = projectile_manager_velocity(projectile);
+    return true;
+}
+
 void push_render(struct push* push, struct render_batch* batch) {
     struct dynamic_object* target = collision_scene_find_object(push->data_source->target);
 
@@ -69,11 +92,12 @@ void push_destroy(struct push* push) {
 }
 
 void push_update(struct push* push, struct spell_event_listener* event_listener, struct spell_sources* spell_sources) {
-    struct dynamic_object* target = collision_scene_find_object(push->data_source->target);
+    struct Vector3* target_position;
+    struct Vector3* target_velocity;
 
     bool is_bursty = is_burst_dash[push->push_mode] || push->data_source->flags.cast_state == SPELL_CAST_STATE_INSTANT;
 
-    if (!target) {
+    if (!push_find_target(push->data_source->target, &target_position, &target_velocity)) {
         spell_event_listener_add(event_listener, SPELL_EVENT_DESTROY, 0, 0.0f);
         return;
     }
@@ -102,12 +126,12 @@ void push_update(struct push* push, struct spell_event_listener* event_listener,
 
     struct Vector3 targetVelocity;
     vector3Scale(&push->data_source->direction, &targetVelocity, push_strength[push->push_mode] * power_ratio);
-    vector3MoveTowards(&target->velocity, &targetVelocity, scaled_time_step * 60.0f * power_ratio, &target->velocity);
+    vector3MoveTowards(target_velocity, &targetVelocity, scaled_time_step * 60.0f * power_ratio, target_velocity);
 
     if (push->dash_trail_right) {
-        dash_trail_move(push->dash_trail_right, target->position);
+        dash_trail_move(push->dash_trail_right, target_position);
     }
     if (push->dash_trail_left) {
-        dash_trail_move(push->dash_trail_left, target->position);
+        dash_trail_move(push->dash_trail_left, target_position);
     }
 }
\ No newline at end of file
@@ -17,6 +17,8 @@ void spell_init(struct spell* spell, uint8_t cols, uint8_t rows, int icon) {
         curr->type = 0;
         ++curr;
     }
+
+    spell_compile(spell);
 }
 
 void spell_destroy(struct spell* spell) {
@@ -24,6 +26,10 @@ void spell_destroy(struct spell* spell) {
     spell->symbols = 0;
 }
 
+void spell_compile(struct spell* spell) {
+    spell_program_compile(&spell->program, spell);
+}
+
 struct spell_symbol spell_get_symbol(struct spell* spell, int col, int row) {
     if (col >= spell->cols || row >= spell->rows || col < 0 || row < 0) {
         struct spell_symbol result;
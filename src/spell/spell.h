@@ -5,6 +5,7 @@
 #include <stdbool.h>
 
 #include "../scene/world_definition.h"
+#include "spell_program.h"
 
 #define SPELL_MAX_COLS    10
 #define SPELL_MAX_ROWS    4
@@ -33,10 +34,13 @@ struct spell {
     uint8_t cols;
     uint8_t rows;
     uint8_t symbol_index;
+    // rebuilt by spell_compile whenever the symbols change
+    struct spell_program program;
 };
 
 void spell_init(struct spell* spell, uint8_t cols, uint8_t rows, int icon);
 void spell_destroy(struct spell* spell);
+void spell_compile(struct spell* spell);
 
 struct spell_symbol spell_get_symbol(struct spell* spell, int col, int row);
 
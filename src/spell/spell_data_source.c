@@ -5,27 +5,23 @@
 void spell_data_source_pool_init(struct spell_data_source_pool* pool) {
     for (int i = 0; i < MAX_SPELL_DATA_SOURCES; ++i) {
         pool->data_sources[i].reference_count = 0;
+        pool->data_sources[i].pool = pool;
+        // hand out the lowest index first
+        pool->free_list[i] = MAX_SPELL_DATA_SOURCES - 1 - i;
     }
 
-    pool->next_data_source = 0;
+    pool->free_count = MAX_SPELL_DATA_SOURCES;
+    pool->failed_allocations = 0;
 }
 
 struct spell_data_source* spell_data_source_pool_get(struct spell_data_source_pool* pool) {
-    for (int i = 0; i < MAX_SPELL_DATA_SOURCES; ++i) {
-        struct spell_data_source* current = &pool->data_sources[pool->next_data_source];
-
-        pool->next_data_source += 1;
-
-        if (pool->next_data_source == MAX_SPELL_DATA_SOURCES) {
-            pool->next_data_source = 0;
-        }
-
-        if (current->reference_count == 0) {
-            return current;
-        }
+    if (!pool->free_count) {
+        pool->failed_allocations += 1;
+        return 0;
     }
 
-    return 0;
+    pool->free_count -= 1;
+    return &pool->data_sources[pool->free_list[pool->free_count]];
 }
 
 void spell_data_source_retain(struct spell_data_source* data_source) {
@@ -44,6 +40,13 @@ void spell_data_source_release(struct spell_data_source* data_source) {
     assert(data_source->reference_count > 0);
 
     data_source->reference_count -= 1;
+
+    if (data_source->reference_count == 0) {
+        struct spell_data_source_pool* pool = data_source->pool;
+        assert(pool && pool->free_count < MAX_SPELL_DATA_SOURCES);
+        pool->free_list[pool->free_count] = data_source - pool->data_sources;
+        pool->free_count += 1;
+    }
 }
 
 enum element_type spell_data_source_determine_element(struct spell_data_source* data_source) {
@@ -27,12 +27,17 @@ union spell_source_flags {
     uint16_t all;
 };
 
+struct spell_data_source_pool;
+
 struct spell_data_source {
     struct Vector3 position;
     struct Vector3 direction;
     union spell_source_flags flags;
     entity_id target;
 
+    // the pool the source goes back to once nothing references
+    // it, null for sources owned by the caster
+    struct spell_data_source_pool* pool;
     uint8_t reference_count;
 };
 
@@ -44,10 +49,15 @@ struct spell_event_options {
 
 struct spell_data_source_pool {
     struct spell_data_source data_sources[MAX_SPELL_DATA_SOURCES];
-    uint16_t next_data_source;
+    uint8_t free_list[MAX_SPELL_DATA_SOURCES];
+    uint16_t free_count;
+    uint32_t failed_allocations;
 };
 
 void spell_data_source_pool_init(struct spell_data_source_pool* pool);
+// returns null when the pool is empty, the source goes back to the
+// pool when its reference count drops to zero so it has to be
+// retained by whoever ends up using it
 struct spell_data_source* spell_data_source_pool_get(struct spell_data_source_pool* pool);
 
 void spell_data_source_retain(struct spell_data_source* data_source);
@@ -0,0 +1,36 @@
+#include "spell_data_source.h"
+#include "../test/framework_test.h"
+
+#include <stddef.h>
+
+void test_spell_data_source_pool(struct test_context* t) {
+    static struct spell_data_source_pool pool;
+    struct spell_data_source* sources[MAX_SPELL_DATA_SOURCES];
+
+    spell_data_source_pool_init(&pool);
+
+    for (int i = 0; i < MAX_SPELL_DATA_SOURCES; i += 1) {
+        sources[i] = spell_data_source_pool_get(&pool);
+        test_eqp(t, &pool.data_sources[i], sources[i]);
+        spell_data_source_retain(sources[i]);
+    }
+
+    test_eqp(t, NULL, spell_data_source_pool_get(&pool));
+    test_eqi(t, 1, pool.failed_allocations);
+
+    // a source is only returned once nothing references it
+    spell_data_source_retain(sources[5]);
+    spell_data_source_release(sources[5]);
+    test_eqp(t, NULL, spell_data_source_pool_get(&pool));
+
+    spell_data_source_release(sources[5]);
+    test_eqp(t, sources[5], spell_data_source_pool_get(&pool));
+    spell_data_source_retain(sources[5]);
+    test_eqi(t, 2, pool.failed_allocations);
+
+    for (int i = 0; i < MAX_SPELL_DATA_SOURCES; i += 1) {
+        spell_data_source_release(sources[i]);
+    }
+
+    test_eqi(t, MAX_SPELL_DATA_SOURCES, pool.free_count);
+}
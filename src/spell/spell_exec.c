@@ -4,56 +4,55 @@
 #include <stdbool.h>
 #include <memory.h>
 #include "../util/sort.h"
+#include "../util/memory_tag.h"
 #include "../time/time.h"
 #include "elements.h"
 
-void spell_exec_step(struct spell_exec* exec, int button_index, struct spell* spell, int col, int row, struct spell_data_source* data_source, float burst_mana);
+void spell_exec_step(struct spell_exec* exec, int button_index, struct spell_program* program, int node_index, struct spell_data_source* data_source, float burst_mana);
+
+static enum element_type spell_slot_fire_element(struct spell_program_node* node, struct spell_data_source* input) {
+    if (node->symbol == SPELL_SYMBOL_ICE) {
+        return input->flags.flaming ? ELEMENT_TYPE_LIGHTNING : ELEMENT_TYPE_ICE;
+    }
+
+    return input->flags.icy ? ELEMENT_TYPE_LIGHTNING : ELEMENT_TYPE_FIRE;
+}
 
 void spell_slot_init(
     struct spell_exec_slot* slot, 
     int button_index,
     struct spell_data_source* input,
     float burst_mana,
-    struct spell* for_spell,
-    uint8_t curr_col,
-    uint8_t curr_row
+    struct spell_program* program,
+    uint8_t node_index
 ) {
-    struct spell_symbol symbol = spell_get_symbol(for_spell, curr_col, curr_row);
+    struct spell_program_node* node = &program->nodes[node_index];
 
     struct spell_event_options event_options;
 
-    event_options.has_primary_event = spell_has_primary_event(for_spell, curr_col, curr_row);
-    event_options.has_secondary_event = spell_has_secondary_event(for_spell, curr_col, curr_row);
+    event_options.has_primary_event = node->primary != SPELL_PROGRAM_NONE;
+    event_options.has_secondary_event = node->secondary != SPELL_PROGRAM_NONE;
     event_options.burst_mana = burst_mana;
 
-    switch ((enum inventory_item_type)symbol.type) {
-        case SPELL_SYMBOL_EARTH:
+    switch ((enum spell_exec_slot_type)node->slot_type) {
+        case SPELL_EXEC_SLOT_TYPE_PROJECTILE:
             slot->type = SPELL_EXEC_SLOT_TYPE_PROJECTILE;
             projectile_init(&slot->data.projectile, input, event_options, spell_data_source_determine_element(input));
             break;
-        case SPELL_SYMBOL_FIRE:
-            if (input->flags.cast_state == SPELL_CAST_STATE_INSTANT) {
-                slot->type = SPELL_EXEC_SLOT_TYPE_EXPLOSION;
-                explosion_init(&slot->data.explosion, input, event_options, input->flags.icy ? ELEMENT_TYPE_LIGHTNING : ELEMENT_TYPE_FIRE);
-            } else {
-                slot->type = SPELL_EXEC_SLOT_TYPE_FIRE;
-                fire_init(&slot->data.fire, input, event_options, input->flags.icy ? ELEMENT_TYPE_LIGHTNING : ELEMENT_TYPE_FIRE);
-            }
-            break;
-        case SPELL_SYMBOL_ICE:
+        case SPELL_EXEC_SLOT_TYPE_FIRE:
             if (input->flags.cast_state == SPELL_CAST_STATE_INSTANT) {
                 slot->type = SPELL_EXEC_SLOT_TYPE_EXPLOSION;
-                explosion_init(&slot->data.explosion, input, event_options, input->flags.flaming ? ELEMENT_TYPE_LIGHTNING : ELEMENT_TYPE_ICE);
+                explosion_init(&slot->data.explosion, input, event_options, spell_slot_fire_element(node, input));
             } else {
                 slot->type = SPELL_EXEC_SLOT_TYPE_FIRE;
-                fire_init(&slot->data.fire, input, event_options, input->flags.flaming ? ELEMENT_TYPE_LIGHTNING : ELEMENT_TYPE_ICE);
+                fire_init(&slot->data.fire, input, event_options, spell_slot_fire_element(node, input));
             }
             break;
-        case SPELL_SYMBOL_RECAST:
+        case SPELL_EXEC_SLOT_TYPE_RECAST:
             slot->type = SPELL_EXEC_SLOT_TYPE_RECAST;
             recast_init(&slot->data.recast, input, event_options, input->flags.reversed ? REACT_MODE_STICKY : RECAST_MODE_RECAST);
             break;
-        case SPELL_SYMBOL_AIR:
+        case SPELL_EXEC_SLOT_TYPE_PUSH:
             slot->type = SPELL_EXEC_SLOT_TYPE_PUSH;
             push_init(&slot->data.push, input, event_options, spell_data_source_determine_element(input));
             break;
@@ -64,9 +63,8 @@ void spell_slot_init(
     }
 
     slot->button_index = button_index;
-    slot->for_spell = for_spell;
-    slot->curr_col = curr_col;
-    slot->curr_row = curr_row;
+    slot->program = program;
+    slot->node_index = node_index;
 }
 
 void spell_slot_destroy(struct spell_exec* exec, int slot_index) {
@@ -117,6 +115,8 @@ void spell_slot_destroy(struct spell_exec* exec, int slot_index) {
     }
 
     exec->ids[slot_index] = 0;
+    exec->free_slots[exec->free_slot_count] = slot_index;
+    exec->free_slot_count += 1;
 }
 
 void spell_slot_update(struct spell_exec* exec, int spell_slot_index) {
@@ -148,28 +148,33 @@ void spell_slot_update(struct spell_exec* exec, int spell_slot_index) {
             break;
     }
 
+    // the slot can be reused by the events below once destroyed
+    int button_index = slot->button_index;
+    struct spell_program* program = slot->program;
+    struct spell_program_node* node = &program->nodes[slot->node_index];
+
     // handle destroy event first 
     for (int i = 0; i < event_listener.event_count; ++i) {
         if (event_listener.events[i].type == SPELL_EVENT_DESTROY) {
             spell_slot_destroy(exec, spell_slot_index);
-            exec->ids[spell_slot_index] = 0;
             break;
         }
     }
 
     // then handle the remaining events
+
     for (int i = 0; i < event_listener.event_count; ++i) {
         struct spell_event* event = &event_listener.events[i];
 
         switch (event->type) {
         case SPELL_EVENT_PRIMARY:
-            if (spell_has_primary_event(slot->for_spell, slot->curr_col, slot->curr_row) != ITEM_TYPE_NONE) {
-                spell_exec_step(exec, slot->button_index, slot->for_spell, slot->curr_col + 1, slot->curr_row, event->data_source, event->burst_mana);
+            if (node->primary != SPELL_PROGRAM_NONE) {
+                spell_exec_step(exec, button_index, program, node->primary, event->data_source, event->burst_mana);
             }
             break;
         case SPELL_EVENT_SECONDARY:
-            if (spell_has_secondary_event(slot->for_spell, slot->curr_col, slot->curr_row))  {
-                spell_exec_step(exec, slot->button_index, slot->for_spell, slot->curr_col + 1, slot->curr_row + 1, event->data_source, event->burst_mana);
+            if (node->secondary != SPELL_PROGRAM_NONE)  {
+                spell_exec_step(exec, button_index, program, node->secondary, event->data_source, event->burst_mana);
             }
             break;
         }
@@ -178,35 +183,40 @@ void spell_slot_update(struct spell_exec* exec, int spell_slot_index) {
     spell_event_listener_destroy(&event_listener);
 }
 
-int spell_exec_find_slot(struct spell_exec* exec) {
+static int spell_exec_find_oldest(spell_slot_id* ids, int capacity) {
     int result = 0;
-    int result_id = exec->ids[0];
-
-    for (int i = 0; i < MAX_SPELL_EXECUTORS; ++i) {
-        int id = exec->ids[exec->next_slot];
-        int current = exec->next_slot;
-
-        exec->next_slot += 1;
 
-        if (exec->next_slot == MAX_SPELL_EXECUTORS) {
-            exec->next_slot = 0;
+    for (int i = 1; i < capacity; ++i) {
+        if (ids[i] < ids[result]) {
+            result = i;
         }
+    }
 
-        if (id == 0) {
-            return current;
-        }
+    return result;
+}
 
-        // select the oldest result if none is available
-        if (id < result_id) {
-            result = current;
-            result_id = id;
+// returns -1 if the slot couldn't be allocated
+int spell_exec_find_slot(struct spell_exec* exec) {
+    if (!exec->free_slot_count) {
+        if (!exec->definition.evict_oldest) {
+            exec->stats.slot_failures += 1;
+            return -1;
         }
+
+        // cut the oldest active spell short
+        spell_slot_destroy(exec, spell_exec_find_oldest(exec->ids, exec->definition.slot_capacity));
+        exec->stats.slot_evictions += 1;
     }
 
-    // reuse the oldest active slot
-    spell_slot_destroy(exec, result);
+    exec->free_slot_count -= 1;
 
-    return result;
+    int active_count = exec->definition.slot_capacity - exec->free_slot_count;
+
+    if (active_count > exec->stats.peak_slots) {
+        exec->stats.peak_slots = active_count;
+    }
+
+    return exec->free_slots[exec->free_slot_count];
 }
 
 void spell_source_modifier_apply(struct spell_source_modifier* modifier) {
@@ -231,92 +241,88 @@ void spell_source_modifier_destroy(struct spell_exec* exec, int index) {
     spell_data_source_release(modifier->source);
     spell_data_source_release(modifier->output);
     exec->modifier_ids[index] = 0;
+    exec->free_modifiers[exec->free_modifier_count] = index;
+    exec->free_modifier_count += 1;
 }
 
+// returns -1 if the modifier couldn't be allocated
 int spell_exec_find_modifier(struct spell_exec* exec) {
-    int result = 0;
-    int result_id = exec->modifier_ids[0];
-
-    for (int i = 0; i < MAX_SOURCE_MODIFIERS; ++i) {
-        int id = exec->modifier_ids[exec->next_modifier];
-        int current = exec->next_modifier;
-
-        exec->next_modifier += 1;
-
-        if (exec->next_modifier == MAX_SOURCE_MODIFIERS) {
-            exec->next_modifier = 0;
+    if (!exec->free_modifier_count) {
+        if (!exec->definition.evict_oldest) {
+            exec->stats.modifier_failures += 1;
+            return -1;
         }
 
-        if (id == 0) {
-            return current;
-        }
+        spell_source_modifier_destroy(exec, spell_exec_find_oldest(exec->modifier_ids, exec->definition.modifier_capacity));
+        exec->stats.modifier_evictions += 1;
+    }
 
-        // if there is no consumer of this modifier it can be reused
-        if (exec->modifiers[current].output->reference_count == 1) {
-            spell_source_modifier_destroy(exec, current);
-            return current;
-        }
+    exec->free_modifier_count -= 1;
 
-        if (id < result_id) {
-            result = current;
-            result_id = id;
-        }
-    }
+    int active_count = exec->definition.modifier_capacity - exec->free_modifier_count;
 
-    spell_source_modifier_destroy(exec, result);
+    if (active_count > exec->stats.peak_modifiers) {
+        exec->stats.peak_modifiers = active_count;
+    }
 
-    return result;
+    return exec->free_modifiers[exec->free_modifier_count];
 }
 
-static union spell_source_flags symbol_to_modifier[] = {
-    [SPELL_SYMBOL_FIRE] = { .flaming = 1 },
-    [SPELL_SYMBOL_AIR] = { .controlled = 1 },
-    [SPELL_SYMBOL_ICE] = { .icy = 1 },
-    [SPELL_SYMBOL_LIFE] = { .living = 1 },
-};
-
-void spell_modifier_init(
-    struct spell_exec* exec, int button_index, struct spell* spell, int col, int row, struct spell_data_source* data_source, float burst_mana
+struct spell_data_source* spell_modifier_init(
+    struct spell_exec* exec, struct spell_data_source* data_source, union spell_source_flags flags
 ) {
-    union spell_source_flags flags;
-
-    flags.all = 0;
+    int index = spell_exec_find_modifier(exec);
 
-    while (spell_is_modifier(spell, col, row)) {
-        // TODO check for sibilings
+    if (index == -1) {
+        return NULL;
+    }
 
-        int type = spell_get_symbol(spell, col, row).type;
-        flags.all |= symbol_to_modifier[type].all;
+    struct spell_data_source* output = spell_data_source_pool_get(&exec->spell_sources.data_sources);
 
-        col += 1;
+    if (!output) {
+        exec->free_modifiers[exec->free_modifier_count] = index;
+        exec->free_modifier_count += 1;
+        return NULL;
     }
 
-    int index = spell_exec_find_modifier(exec);
     struct spell_source_modifier* modifier = &exec->modifiers[index];
 
-    struct spell_data_source* output = spell_data_source_pool_get(&exec->spell_sources.data_sources);
-
     spell_slot_id id = exec->next_id;
     exec->next_id += 1;
 
     spell_source_modifier_init(modifier, data_source, output, flags);
     exec->modifier_ids[index] = id;
 
-    spell_exec_step(exec, button_index, spell, col, row, output, burst_mana);
+    return output;
 }
 
-void spell_exec_step(struct spell_exec* exec, int button_index, struct spell* spell, int col, int row, struct spell_data_source* data_source, float burst_mana) {
+void spell_exec_step(struct spell_exec* exec, int button_index, struct spell_program* program, int node_index, struct spell_data_source* data_source, float burst_mana) {
     if (!data_source) {
         return;
     }
 
-    if (spell_is_modifier(spell, col, row)) {
-        spell_modifier_init(exec, button_index, spell, col, row, data_source, burst_mana);
+    // the spell may have been rebuilt while one of its slots was alive
+    if (node_index >= program->node_count) {
         return;
     }
 
+    struct spell_program_node* node = &program->nodes[node_index];
+
+    if (node->modifier_flags.all) {
+        data_source = spell_modifier_init(exec, data_source, node->modifier_flags);
+
+        if (!data_source) {
+            return;
+        }
+    }
+
     int slot_index = spell_exec_find_slot(exec);
 
+    // a modifier without a slot using it is reclaimed next update
+    if (slot_index == -1) {
+        return;
+    }
+
     spell_slot_id id = exec->next_id;
     exec->next_id += 1;
 
@@ -329,9 +335,8 @@ void spell_exec_step(struct spell_exec* exec, int button_index, struct spell* sp
         button_index,
         data_source,
         burst_mana,
-        spell,
-        col,
-        row
+        program,
+        node_index
     );
 
     if (slot->type == SPELL_EXEC_SLOT_TYPE_RECAST) {
@@ -340,23 +345,68 @@ void spell_exec_step(struct spell_exec* exec, int button_index, struct spell* sp
     }
 }
 
-void spell_exec_init(struct spell_exec* exec) {
+void spell_exec_init(struct spell_exec* exec, struct spell_exec_definition* definition) {
+    int slot_capacity = definition->slot_capacity;
+    int modifier_capacity = definition->modifier_capacity;
+
+    assert(slot_capacity > 0 && modifier_capacity > 0);
+
+    exec->definition = *definition;
     exec->next_id = 1;
-    exec->next_slot = 0;
+    memset(&exec->stats, 0, sizeof(exec->stats));
     spell_sources_init(&exec->spell_sources);
-    memset(&exec->ids, 0, sizeof(exec->ids));
-    memset(&exec->modifier_ids, 0, sizeof(exec->modifier_ids));
-    update_add(exec, (update_callback)spell_exec_update, UPDATE_PRIORITY_SPELLS, UPDATE_LAYER_WORLD);
+
+    exec->ids = tagged_malloc(MEMORY_TAG_SPELLS, sizeof(spell_slot_id) * slot_capacity);
+    exec->modifier_ids = tagged_malloc(MEMORY_TAG_SPELLS, sizeof(spell_slot_id) * modifier_capacity);
+    exec->slots = tagged_malloc(MEMORY_TAG_SPELLS, sizeof(struct spell_exec_slot) * slot_capacity);
+    exec->modifiers = tagged_malloc(MEMORY_TAG_SPELLS, sizeof(struct spell_source_modifier) * modifier_capacity);
+    exec->free_slots = tagged_malloc(MEMORY_TAG_SPELLS, slot_capacity);
+    exec->free_modifiers = tagged_malloc(MEMORY_TAG_SPELLS, modifier_capacity);
+    exec->update_order = tagged_malloc(MEMORY_TAG_SPELLS, sizeof(uint16_t) * (slot_capacity + modifier_capacity));
+    exec->update_ids = tagged_malloc(MEMORY_TAG_SPELLS, sizeof(spell_slot_id) * (slot_capacity + modifier_capacity));
+
+    memset(exec->ids, 0, sizeof(spell_slot_id) * slot_capacity);
+    memset(exec->modifier_ids, 0, sizeof(spell_slot_id) * modifier_capacity);
+
+    // the lowest index is handed out first
+    for (int i = 0; i < slot_capacity; ++i) {
+        exec->free_slots[i] = slot_capacity - 1 - i;
+    }
+
+    for (int i = 0; i < modifier_capacity; ++i) {
+        exec->free_modifiers[i] = modifier_capacity - 1 - i;
+    }
+
+    exec->free_slot_count = slot_capacity;
+    exec->free_modifier_count = modifier_capacity;
+
+    exec->update_id = update_add(exec, (update_callback)spell_exec_update, UPDATE_PRIORITY_SPELLS, UPDATE_LAYER_WORLD);
     memset(exec->pending_recast, 0, sizeof(exec->pending_recast));
 }
 
 void spell_exec_destroy(struct spell_exec* exec) {
-    for (int i = 0; i < MAX_SPELL_EXECUTORS; ++i) {
+    for (int i = 0; i < exec->definition.slot_capacity; ++i) {
         if (exec->ids[i]) {
             spell_slot_destroy(exec, i);
         }
     }
-    update_remove(exec);
+
+    for (int i = 0; i < exec->definition.modifier_capacity; ++i) {
+        if (exec->modifier_ids[i]) {
+            spell_source_modifier_destroy(exec, i);
+        }
+    }
+
+    update_remove(exec->update_id);
+
+    tagged_free(exec->ids);
+    tagged_free(exec->modifier_ids);
+    tagged_free(exec->slots);
+    tagged_free(exec->modifiers);
+    tagged_free(exec->free_slots);
+    tagged_free(exec->free_modifiers);
+    tagged_free(exec->update_order);
+    tagged_free(exec->update_ids);
 }
 
 void spell_exec_recast(struct spell_exec* exec, int button_index, struct spell_data_source* data_source) {
@@ -389,11 +439,11 @@ void spell_exec_start(struct spell_exec* exec, int button_index, struct spell* s
         return;
     }
 
-    if (spell_get_symbol(spell, 0, 0).type == SPELL_EXEC_SLOT_TYPE_EMPTY) {
+    if (spell->program.entry == SPELL_PROGRAM_NONE) {
         return;
     }
 
-    spell_exec_step(exec, button_index, spell, 0, 0, data_source, 0.0f);
+    spell_exec_step(exec, button_index, &spell->program, spell->program.entry, data_source, 0.0f);
 }
 
 bool spell_exec_charge(struct spell_exec* exec) {
@@ -417,14 +467,14 @@ int spell_slot_compare(struct spell_exec* exec, uint16_t a, uint16_t b) {
 }
 
 void spell_exec_update(struct spell_exec* exec) {
-    uint16_t indices[MAX_SPELL_EXECUTORS + MAX_SOURCE_MODIFIERS];
-    spell_slot_id start_ids[MAX_SPELL_EXECUTORS];
-    spell_slot_id start_modifier_id[MAX_SOURCE_MODIFIERS];
+    uint16_t* indices = exec->update_order;
+    spell_slot_id* start_ids = exec->update_ids;
+    spell_slot_id* start_modifier_id = exec->update_ids + exec->definition.slot_capacity;
     int count = 0;
 
     mana_pool_update(&exec->spell_sources.mana_pool);
 
-    for (int i = 0; i < MAX_SPELL_EXECUTORS; ++i) {
+    for (int i = 0; i < exec->definition.slot_capacity; ++i) {
         if (exec->ids[i]) {
             indices[count] = i;
             start_ids[i] = exec->ids[i];
@@ -432,7 +482,7 @@ void spell_exec_update(struct spell_exec* exec) {
         }
     }
 
-    for (int i = 0; i < MAX_SOURCE_MODIFIERS; ++i) {
+    for (int i = 0; i < exec->definition.modifier_capacity; ++i) {
         if (exec->modifier_ids[i]) {
             indices[count] = DEFINE_MODIFIER_IDX(i);
             start_modifier_id[i] = exec->modifier_ids[i];
@@ -448,7 +498,14 @@ void spell_exec_update(struct spell_exec* exec) {
         if (IS_MODIFIER_ID(index)) {
             index = EXTRACT_MODIFIER_IDX(index);
             // make sure modifier hasn't been replaced
-            if (start_modifier_id[index] == exec->modifier_ids[index]) {
+            if (start_modifier_id[index] != exec->modifier_ids[index]) {
+                continue;
+            }
+
+            // nothing but the modifier itself is using the output
+            if (exec->modifiers[index].output->reference_count == 1) {
+                spell_source_modifier_destroy(exec, index);
+            } else {
                 spell_source_modifier_apply(&exec->modifiers[index]);
             }
         } else {
@@ -470,4 +527,8 @@ float spell_exec_current_mana(struct spell_exec* exec) {
 
 float spell_exec_prev_mana(struct spell_exec* exec) {
     return mana_pool_get_previous_mana(&exec->spell_sources.mana_pool);
+}
+
+struct spell_exec_stats* spell_exec_get_stats(struct spell_exec* exec) {
+    return &exec->stats;
 }
\ No newline at end of file
@@ -1,8 +1,6 @@
 #ifndef __SPELL_SPELL_EXEC_H__
 #define __SPELL_SPELL_EXEC_H__
 
-#define MAX_SPELL_EXECUTORS     16
-#define MAX_SOURCE_MODIFIERS    32
 #define MAX_BUTTON_INDEX        8    
 
 #include "spell.h"
@@ -16,6 +14,7 @@
 #include "recast.h"
 #include "push.h"
 #include "mana_pool.h"
+#include "../time/time.h"
 
 typedef uint32_t spell_slot_id;
 
@@ -28,21 +27,10 @@ union spell_exec_data {
     struct push push;
 };
 
-enum spell_exec_slot_type {
-    SPELL_EXEC_SLOT_TYPE_EMPTY,
-    SPELL_EXEC_SLOT_TYPE_FIRE,
-    SPELL_EXEC_SLOT_TYPE_FIRE_AROUND,
-    SPELL_EXEC_SLOT_TYPE_PROJECTILE,
-    SPELL_EXEC_SLOT_TYPE_EXPLOSION,
-    SPELL_EXEC_SLOT_TYPE_PUSH,
-    SPELL_EXEC_SLOT_TYPE_RECAST,
-};
-
 struct spell_exec_slot {
     // null when spell isn't active
-    struct spell* for_spell;
-    uint8_t curr_col;
-    uint8_t curr_row;
+    struct spell_program* program;
+    uint8_t node_index;
     uint8_t button_index;
     enum spell_exec_slot_type type;
     union spell_exec_data data;
@@ -54,21 +42,46 @@ struct spell_source_modifier {
     union spell_source_flags flag_mask;
 };
 
+struct spell_exec_definition {
+    uint8_t slot_capacity;
+    uint8_t modifier_capacity;
+    // when full the oldest spell is cut short to make room,
+    // otherwise the new cast fails and the older spells keep going
+    uint8_t evict_oldest;
+};
+
+struct spell_exec_stats {
+    uint32_t slot_evictions;
+    uint32_t slot_failures;
+    uint32_t modifier_evictions;
+    uint32_t modifier_failures;
+    uint16_t peak_slots;
+    uint16_t peak_modifiers;
+};
+
 struct spell_exec {
-    // 0 when the cooresponding slot isn't active
-    spell_slot_id ids[MAX_SPELL_EXECUTORS];
-    spell_slot_id modifier_ids[MAX_SOURCE_MODIFIERS];
-    struct spell_exec_slot slots[MAX_SPELL_EXECUTORS];
-    struct spell_source_modifier modifiers[MAX_SOURCE_MODIFIERS];
+    // ids come from next_id so they double as a generation, 0
+    // when the cooresponding slot isn't active
+    spell_slot_id* ids;
+    spell_slot_id* modifier_ids;
+    struct spell_exec_slot* slots;
+    struct spell_source_modifier* modifiers;
+    uint8_t* free_slots;
+    uint8_t* free_modifiers;
+    // scratch space for spell_exec_update
+    uint16_t* update_order;
+    spell_slot_id* update_ids;
     struct spell_sources spell_sources;
     struct recast* pending_recast[MAX_BUTTON_INDEX];
-    uint8_t next_slot;
-    uint8_t next_modifier;
+    struct spell_exec_definition definition;
+    uint8_t free_slot_count;
+    uint8_t free_modifier_count;
     spell_slot_id next_id;
-    int update_id;
+    struct spell_exec_stats stats;
+    update_id update_id;
 };
 
-void spell_exec_init(struct spell_exec* exec);
+void spell_exec_init(struct spell_exec* exec, struct spell_exec_definition* definition);
 void spell_exec_destroy(struct spell_exec* exec);
 void spell_exec_start(struct spell_exec* exec, int button_index, struct spell* spell, struct spell_data_source* data_source);
 void spell_exec_update(struct spell_exec* exec);
@@ -79,4 +92,6 @@ float spell_exec_max_mana(struct spell_exec* exec);
 float spell_exec_current_mana(struct spell_exec* exec);
 float spell_exec_prev_mana(struct spell_exec* exec);
 
+struct spell_exec_stats* spell_exec_get_stats(struct spell_exec* exec);
+
 #endif
\ No newline at end of file
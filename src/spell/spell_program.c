@@ -0,0 +1,96 @@
+#include "spell_program.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "spell.h"
+
+struct spell_program_compiler {
+    struct spell_program* program;
+    struct spell* spell;
+    // the node that starts at each cell so recasts sharing a
+    // branch only compile it once
+    uint8_t cell_nodes[SPELL_MAX_ROWS][SPELL_MAX_COLS];
+};
+
+static union spell_source_flags symbol_to_modifier[] = {
+    [SPELL_SYMBOL_FIRE] = { .flaming = 1 },
+    [SPELL_SYMBOL_AIR] = { .controlled = 1 },
+    [SPELL_SYMBOL_ICE] = { .icy = 1 },
+    [SPELL_SYMBOL_LIFE] = { .living = 1 },
+};
+
+static uint8_t symbol_to_slot_type[] = {
+    [ITEM_TYPE_NONE] = SPELL_EXEC_SLOT_TYPE_EMPTY,
+    [SPELL_SYMBOL_FIRE] = SPELL_EXEC_SLOT_TYPE_FIRE,
+    [SPELL_SYMBOL_ICE] = SPELL_EXEC_SLOT_TYPE_FIRE,
+    [SPELL_SYMBOL_EARTH] = SPELL_EXEC_SLOT_TYPE_PROJECTILE,
+    [SPELL_SYMBOL_AIR] = SPELL_EXEC_SLOT_TYPE_PUSH,
+    [SPELL_SYMBOL_LIFE] = SPELL_EXEC_SLOT_TYPE_EMPTY,
+    [SPELL_SYMBOL_RECAST] = SPELL_EXEC_SLOT_TYPE_RECAST,
+    [SPELL_SYMBOL_PASS_DOWN] = SPELL_EXEC_SLOT_TYPE_EMPTY,
+};
+
+static int spell_program_compile_cell(struct spell_program_compiler* compiler, int col, int row) {
+    uint8_t existing = compiler->cell_nodes[row][col];
+
+    if (existing != SPELL_PROGRAM_NONE) {
+        return existing;
+    }
+
+    struct spell_program* program = compiler->program;
+    struct spell* spell = compiler->spell;
+
+    assert(program->node_count < SPELL_PROGRAM_MAX_NODES);
+    int index = program->node_count;
+    program->node_count += 1;
+    compiler->cell_nodes[row][col] = index;
+
+    union spell_source_flags modifier_flags;
+    modifier_flags.all = 0;
+
+    // a modifier only feeds the cell to its right, a branch below a
+    // modifier is never taken, the same as the interpreter this replaced
+    while (spell_is_modifier(spell, col, row)) {
+        modifier_flags.all |= symbol_to_modifier[spell_get_symbol(spell, col, row).type].all;
+        col += 1;
+    }
+
+    int symbol = spell_get_symbol(spell, col, row).type;
+
+    // the successors have to be compiled before the node can be
+    // written so find them first
+    int primary = spell_has_primary_event(spell, col, row) ?
+        spell_program_compile_cell(compiler, col + 1, row) :
+        SPELL_PROGRAM_NONE;
+    int secondary = spell_has_secondary_event(spell, col, row) ?
+        spell_program_compile_cell(compiler, col + 1, row + 1) :
+        SPELL_PROGRAM_NONE;
+
+    struct spell_program_node* node = &program->nodes[index];
+    node->modifier_flags = modifier_flags;
+    node->slot_type = symbol_to_slot_type[symbol];
+    node->symbol = symbol;
+    node->primary = primary;
+    node->secondary = secondary;
+
+    return index;
+}
+
+void spell_program_compile(struct spell_program* program, struct spell* spell) {
+    assert(spell->cols <= SPELL_MAX_COLS && spell->rows <= SPELL_MAX_ROWS);
+
+    struct spell_program_compiler compiler;
+    compiler.program = program;
+    compiler.spell = spell;
+    memset(compiler.cell_nodes, SPELL_PROGRAM_NONE, sizeof(compiler.cell_nodes));
+
+    program->node_count = 0;
+
+    if (spell_get_symbol(spell, 0, 0).type == ITEM_TYPE_NONE) {
+        program->entry = SPELL_PROGRAM_NONE;
+        return;
+    }
+
+    program->entry = spell_program_compile_cell(&compiler, 0, 0);
+}
@@ -0,0 +1,47 @@
+#ifndef __SPELL_SPELL_PROGRAM_H__
+#define __SPELL_SPELL_PROGRAM_H__
+
+#include <stdint.h>
+
+#include "spell_data_source.h"
+
+// a spell grid flattened into the nodes spell_exec walks, rebuilt
+// whenever the grid changes so casting never has to look at the grid
+
+#define SPELL_PROGRAM_MAX_NODES     40
+#define SPELL_PROGRAM_NONE          0xFF
+
+struct spell;
+
+enum spell_exec_slot_type {
+    SPELL_EXEC_SLOT_TYPE_EMPTY,
+    SPELL_EXEC_SLOT_TYPE_FIRE,
+    SPELL_EXEC_SLOT_TYPE_FIRE_AROUND,
+    SPELL_EXEC_SLOT_TYPE_PROJECTILE,
+    SPELL_EXEC_SLOT_TYPE_EXPLOSION,
+    SPELL_EXEC_SLOT_TYPE_PUSH,
+    SPELL_EXEC_SLOT_TYPE_RECAST,
+};
+
+struct spell_program_node {
+    // flags of the modifier chain leading into this node, a chain
+    // compiles down to the symbol at the end of it
+    union spell_source_flags modifier_flags;
+    // fire and ice nodes become explosions when cast instantly
+    uint8_t slot_type;
+    uint8_t symbol;
+    // node indices or SPELL_PROGRAM_NONE
+    uint8_t primary;
+    uint8_t secondary;
+};
+
+struct spell_program {
+    struct spell_program_node nodes[SPELL_PROGRAM_MAX_NODES];
+    uint8_t node_count;
+    // SPELL_PROGRAM_NONE for an empty spell
+    uint8_t entry;
+};
+
+void spell_program_compile(struct spell_program* program, struct spell* spell);
+
+#endif
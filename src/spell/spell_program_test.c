@@ -0,0 +1,62 @@
+#include "spell.h"
+#include "../test/framework_test.h"
+
+static void spell_program_test_set(struct spell* spell, int col, int row, int type) {
+    struct spell_symbol symbol;
+    symbol.reserved = 0;
+    symbol.type = type;
+    spell_set_symbol(spell, col, row, symbol);
+}
+
+void test_spell_program_compile(struct test_context* t) {
+    struct spell spell;
+    spell_init(&spell, 4, 2, SPELL_ICON_CUSTOM_0);
+
+    test_eqi(t, SPELL_PROGRAM_NONE, spell.program.entry);
+    test_eqi(t, 0, spell.program.node_count);
+
+    // air modifies the projectile, the recast fans out into fire
+    // and the projectile below it
+    spell_program_test_set(&spell, 0, 0, SPELL_SYMBOL_AIR);
+    spell_program_test_set(&spell, 1, 0, SPELL_SYMBOL_EARTH);
+    spell_program_test_set(&spell, 2, 0, SPELL_SYMBOL_RECAST);
+    spell_program_test_set(&spell, 3, 0, SPELL_SYMBOL_FIRE);
+    spell_program_test_set(&spell, 2, 1, SPELL_SYMBOL_EARTH);
+    spell_compile(&spell);
+
+    test_eqi(t, 4, spell.program.node_count);
+    test_eqi(t, 0, spell.program.entry);
+
+    struct spell_program_node* projectile = &spell.program.nodes[0];
+    test_eqi(t, SPELL_EXEC_SLOT_TYPE_PROJECTILE, projectile->slot_type);
+    test_eqi(t, 1, projectile->modifier_flags.controlled);
+    test_eqi(t, 0, projectile->modifier_flags.flaming);
+    test_eqi(t, 1, projectile->primary);
+    test_eqi(t, 3, projectile->secondary);
+
+    struct spell_program_node* recast = &spell.program.nodes[1];
+    test_eqi(t, SPELL_EXEC_SLOT_TYPE_RECAST, recast->slot_type);
+    test_eqi(t, 0, recast->modifier_flags.all);
+    test_eqi(t, 2, recast->primary);
+    test_eqi(t, SPELL_PROGRAM_NONE, recast->secondary);
+
+    // fire at the end of a row has nothing to modify
+    struct spell_program_node* fire = &spell.program.nodes[2];
+    test_eqi(t, SPELL_EXEC_SLOT_TYPE_FIRE, fire->slot_type);
+    test_eqi(t, 0, fire->modifier_flags.all);
+    test_eqi(t, SPELL_PROGRAM_NONE, fire->primary);
+    test_eqi(t, SPELL_PROGRAM_NONE, fire->secondary);
+
+    struct spell_program_node* lower = &spell.program.nodes[3];
+    test_eqi(t, SPELL_EXEC_SLOT_TYPE_PROJECTILE, lower->slot_type);
+    test_eqi(t, SPELL_PROGRAM_NONE, lower->primary);
+
+    // a sibling in the way blocks the secondary event
+    spell_program_test_set(&spell, 1, 1, SPELL_SYMBOL_EARTH);
+    spell_compile(&spell);
+
+    test_eqi(t, 3, spell.program.node_count);
+    test_eqi(t, SPELL_PROGRAM_NONE, spell.program.nodes[0].secondary);
+
+    spell_destroy(&spell);
+}
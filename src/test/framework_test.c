@@ -1,9 +1,14 @@
 #include "framework_test.h"
 
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+
+#ifndef HOST_BUILD
 #include "../scene/world.h"
 #include "../scene/world_loader.h"
+#endif
 
 #define MAX_NAMED_FAILS 16
 
@@ -51,6 +56,24 @@ void test_neqi_raw(struct test_context* t, int expected, int actual, const char*
     longjmp(t->jump, 1);
 }
 
+void test_eqp_raw(struct test_context* t, const void* expected, const void* actual, const char* location) {
+    if (expected == actual) {
+        return;
+    }
+
+    fprintf(stderr, "ASSERTION FAILED expected %p actual %p at %s\n", expected, actual, location);
+    longjmp(t->jump, 1);
+}
+
+void test_neqp_raw(struct test_context* t, const void* expected, const void* actual, const char* location) {
+    if (expected != actual) {
+        return;
+    }
+
+    fprintf(stderr, "ASSERTION FAILED expected not equal to %p at %s\n", expected, location);
+    longjmp(t->jump, 1);
+}
+
 void test_ltf_raw(struct test_context* t, float left, float right, const char* location) {
     if (left < right) {
         return;
@@ -96,7 +119,7 @@ void test_near_equalf_raw(struct test_context* t, float expected, float actual,
     longjmp(t->jump, 1);
 }
 
-void test_report_failures() {
+int test_report_failures() {
     fprintf(stderr, "%d/%d tests passed\n", total_test_count - failed_test_count, total_test_count);
 
     for (int i = 0; i < failed_test_count && i < MAX_NAMED_FAILS; i += 1) {
@@ -106,8 +129,18 @@ void test_report_failures() {
     if (failed_test_count > MAX_NAMED_FAILS) {
         fprintf(stderr, "    and %d more", failed_test_count - MAX_NAMED_FAILS);
     }
+
+    return failed_test_count;
 }
 
+#ifdef HOST_BUILD
+// the host build doesn't include the world loader, tests
+// that need a world only run on the console
+void test_load_world(const char* name) {
+    fprintf(stderr, "test_load_world %s isn't supported on the host\n", name);
+    abort();
+}
+#else
 static const char* current_world;
 static struct world* current_test_world;
 
@@ -121,6 +154,7 @@ void test_load_world(const char* name) {
     world_release(current_test_world);
     current_test_world = world_load(name);
 }
+#endif
 
 struct test_deferred_call_data {
     test_deferred_call callback;
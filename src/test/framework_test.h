@@ -20,6 +20,8 @@ void test_run_raw(test_callback callback, const char* name);
 
 void test_eqi_raw(struct test_context* t, int expected, int actual, const char* location);
 void test_neqi_raw(struct test_context* t, int expected, int actual, const char* location);
+void test_eqp_raw(struct test_context* t, const void* expected, const void* actual, const char* location);
+void test_neqp_raw(struct test_context* t, const void* expected, const void* actual, const char* location);
 
 void test_ltf_raw(struct test_context* t, float expected, float actual, const char* location);
 void test_ltef_raw(struct test_context* t, float expected, float actual, const char* location);
@@ -29,6 +31,8 @@ void test_near_equalf_raw(struct test_context* t, float expected, float actual,
 
 #define test_eqi(t, expected, actual) test_eqi_raw(t, expected, actual, __FILE__ ":" STRINGIZE(__LINE__))
 #define test_neqi(t, expected, actual) test_neqi_raw(t, expected, actual, __FILE__ ":" STRINGIZE(__LINE__))
+#define test_eqp(t, expected, actual) test_eqp_raw(t, expected, actual, __FILE__ ":" STRINGIZE(__LINE__))
+#define test_neqp(t, expected, actual) test_neqp_raw(t, expected, actual, __FILE__ ":" STRINGIZE(__LINE__))
 
 #define test_ltf(t, left, right) test_ltf_raw(t, left, right, __FILE__ ":" STRINGIZE(__LINE__))
 #define test_ltef(t, left, right) test_ltef_raw(t, left, right, __FILE__ ":" STRINGIZE(__LINE__))
@@ -36,7 +40,8 @@ void test_near_equalf_raw(struct test_context* t, float expected, float actual,
 #define test_gtef(t, left, right) test_gtef_raw(t, left, right, __FILE__ ":" STRINGIZE(__LINE__))
 #define test_near_equalf(t, expected, actual) test_near_equalf_raw(t, expected, actual, __FILE__ ":" STRINGIZE(__LINE__))
 
-void test_report_failures();
+// returns the number of failed tests
+int test_report_failures();
 
 void test_load_world(const char* name);
 
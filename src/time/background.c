@@ -0,0 +1,208 @@
+#include "background.h"
+
+#include <libdragon.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+struct background_job {
+    background_callback callback;
+    void* data;
+    uint8_t priority;
+    // the job ran out of work and waits until the next frame
+    bool idle;
+};
+
+struct background_deferred {
+    background_deferred_callback callback;
+    void* data;
+};
+
+struct background_state {
+    struct background_job jobs[BACKGROUND_MAX_JOBS];
+    // jobs of the same priority take turns starting after the last one run
+    int8_t last_run[BACKGROUND_PRIORITY_COUNT];
+
+    struct background_deferred deferred[BACKGROUND_MAX_DEFERRED];
+    uint8_t deferred_head;
+    uint8_t deferred_count;
+
+    struct background_stats stats;
+};
+
+static struct background_state g_background = {
+    .last_run = {-1, -1, -1},
+};
+
+background_id background_add(void* data, background_callback callback, enum background_priority priority) {
+    assert(priority < BACKGROUND_PRIORITY_COUNT);
+
+    for (int i = 0; i < BACKGROUND_MAX_JOBS; i += 1) {
+        struct background_job* job = &g_background.jobs[i];
+
+        if (job->callback) {
+            continue;
+        }
+
+        job->callback = callback;
+        job->data = data;
+        job->priority = priority;
+        job->idle = false;
+        return i;
+    }
+
+    assert(false);
+    return -1;
+}
+
+void background_remove(background_id id) {
+    if (id < 0 || id >= BACKGROUND_MAX_JOBS) {
+        return;
+    }
+
+    g_background.jobs[id].callback = NULL;
+    g_background.jobs[id].data = NULL;
+}
+
+static struct background_job* background_next_job() {
+    for (int priority = 0; priority < BACKGROUND_PRIORITY_COUNT; priority += 1) {
+        int start = g_background.last_run[priority] + 1;
+
+        for (int offset = 0; offset < BACKGROUND_MAX_JOBS; offset += 1) {
+            int index = (start + offset) % BACKGROUND_MAX_JOBS;
+            struct background_job* job = &g_background.jobs[index];
+
+            if (job->callback && !job->idle && job->priority == priority) {
+                g_background.last_run[priority] = index;
+                return job;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void background_run_deferred(long long deadline) {
+    while (g_background.deferred_head < g_background.deferred_count) {
+        struct background_deferred* deferred = &g_background.deferred[g_background.deferred_head];
+        g_background.deferred_head += 1;
+        deferred->callback(deferred->data);
+
+        if (deadline && timer_ticks() >= deadline) {
+            break;
+        }
+    }
+
+    if (g_background.deferred_head == g_background.deferred_count) {
+        g_background.deferred_head = 0;
+        g_background.deferred_count = 0;
+    }
+}
+
+// returns false once there is nothing left to do this frame
+static bool background_run_slice() {
+    long long start = timer_ticks();
+    long long deadline = start + BACKGROUND_SLICE;
+
+    if (g_background.deferred_count) {
+        background_run_deferred(deadline);
+    } else {
+        struct background_job* job = background_next_job();
+
+        if (!job) {
+            return false;
+        }
+
+        if (!job->callback(job->data, deadline)) {
+            job->idle = true;
+        }
+    }
+
+    long long end = timer_ticks();
+    g_background.stats.job_ticks += end - start;
+    g_background.stats.slices += 1;
+
+    if (end > deadline) {
+        g_background.stats.overruns += 1;
+    }
+
+    return true;
+}
+
+void background_idle(volatile int* frame_happened) {
+    long long start = timer_ticks();
+
+    for (int i = 0; i < BACKGROUND_MAX_JOBS; i += 1) {
+        g_background.jobs[i].idle = false;
+    }
+
+    while (!*frame_happened) {
+        if (!background_run_slice()) {
+            while (!*frame_happened);
+        }
+    }
+
+    g_background.stats.idle_ticks += timer_ticks() - start;
+    g_background.stats.frames += 1;
+
+#ifdef FRAME_PROFILE
+    if (g_background.stats.frames >= BACKGROUND_REPORT_INTERVAL) {
+        background_report();
+    }
+#endif
+}
+
+void background_defer(void* data, background_deferred_callback callback) {
+    for (int i = g_background.deferred_head; i < g_background.deferred_count; i += 1) {
+        struct background_deferred* deferred = &g_background.deferred[i];
+
+        if (deferred->data == data && deferred->callback == callback) {
+            return;
+        }
+    }
+
+    if (g_background.deferred_count == BACKGROUND_MAX_DEFERRED) {
+        // no room to wait for idle time
+        callback(data);
+        g_background.stats.forced_deferred_calls += 1;
+        return;
+    }
+
+    struct background_deferred* deferred = &g_background.deferred[g_background.deferred_count];
+    deferred->callback = callback;
+    deferred->data = data;
+    g_background.deferred_count += 1;
+    g_background.stats.deferred_calls += 1;
+}
+
+void background_flush_deferred() {
+    g_background.stats.forced_deferred_calls += g_background.deferred_count - g_background.deferred_head;
+    background_run_deferred(0);
+}
+
+struct background_stats* background_get_stats() {
+    return &g_background.stats;
+}
+
+void background_report() {
+    struct background_stats* stats = &g_background.stats;
+
+    if (!stats->frames) {
+        return;
+    }
+
+    int reclaimed = stats->idle_ticks ? (int)(stats->job_ticks * 100 / stats->idle_ticks) : 0;
+
+    fprintf(
+        stderr,
+        "background: idle %dus/frame reclaimed %d%% slices %d overruns %d deferred %d forced %d\n",
+        (int)TIMER_MICROS(stats->idle_ticks / stats->frames),
+        reclaimed,
+        (int)stats->slices,
+        (int)stats->overruns,
+        (int)stats->deferred_calls,
+        (int)stats->forced_deferred_calls
+    );
+
+    memset(stats, 0, sizeof(struct background_stats));
+}
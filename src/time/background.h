@@ -0,0 +1,61 @@
+#ifndef __TIME_BACKGROUND_H__
+#define __TIME_BACKGROUND_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// a job does work until the deadline and returns true if it
+// still has more to do, jobs that return false aren't run
+// again until the next frame
+typedef bool (*background_callback)(void* data, long long deadline);
+typedef void (*background_deferred_callback)(void* data);
+
+typedef int background_id;
+
+enum background_priority {
+    BACKGROUND_PRIORITY_HIGH,
+    BACKGROUND_PRIORITY_NORMAL,
+    BACKGROUND_PRIORITY_LOW,
+
+    BACKGROUND_PRIORITY_COUNT,
+};
+
+#define BACKGROUND_MAX_JOBS         16
+#define BACKGROUND_MAX_DEFERRED     32
+// short enough that a job can't push the next frame back much
+#define BACKGROUND_SLICE            TICKS_FROM_US(500)
+#define BACKGROUND_REPORT_INTERVAL  600
+
+struct background_stats {
+    // time spent waiting for the vi interrupt
+    uint64_t idle_ticks;
+    // time out of idle_ticks spent running jobs
+    uint64_t job_ticks;
+    uint32_t frames;
+    uint32_t slices;
+    // slices that ran past their deadline
+    uint32_t overruns;
+    uint32_t deferred_calls;
+    // deferred calls that had to run at the start of a frame
+    uint32_t forced_deferred_calls;
+};
+
+background_id background_add(void* data, background_callback callback, enum background_priority priority);
+void background_remove(background_id id);
+
+// runs background jobs until frame_happened is set, used in place
+// of busy waiting for the vi interrupt
+void background_idle(volatile int* frame_happened);
+
+// callback is run in idle time after the current update, the same
+// data and callback is only queued once
+void background_defer(void* data, background_deferred_callback callback);
+// runs any deferred calls that didn't get idle time, this is done
+// at the start of every frame and before a world is released
+void background_flush_deferred();
+
+struct background_stats* background_get_stats();
+// builds with PROFILE=1 print this every BACKGROUND_REPORT_INTERVAL frames
+void background_report();
+
+#endif
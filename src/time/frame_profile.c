@@ -0,0 +1,227 @@
+#include "frame_profile.h"
+
+#include <libdragon.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef HOST_BUILD
+// libdragon doesn't wrap the rdp command counters
+#define DPC_STATUS          ((volatile uint32_t*)0xA410000C)
+#define DPC_CLOCK           ((volatile uint32_t*)0xA4100010)
+#define DPC_BUSY            ((volatile uint32_t*)0xA4100014)
+#define DPC_PIPE_BUSY       ((volatile uint32_t*)0xA4100018)
+#define DPC_TMEM_BUSY       ((volatile uint32_t*)0xA410001C)
+
+#define DPC_CLEAR_TMEM_CTR  (1 << 6)
+#define DPC_CLEAR_PIPE_CTR  (1 << 7)
+#define DPC_CLEAR_CMD_CTR   (1 << 8)
+#define DPC_CLEAR_CLOCK_CTR (1 << 9)
+
+#define DPC_COUNTER_MASK    0xFFFFFF
+#endif
+
+struct frame_profile_open_zone {
+    long long start;
+    uint8_t zone;
+};
+
+struct frame_profile_state {
+    struct frame_profile_sample history[FRAME_PROFILE_HISTORY];
+    // the frame being recorded
+    uint8_t current;
+    // number of finished frames in history
+    uint8_t frame_count;
+
+    struct frame_profile_open_zone open_zones[FRAME_PROFILE_MAX_DEPTH];
+    uint8_t depth;
+    uint8_t zone_depth[FRAME_ZONE_COUNT];
+
+    long long frame_start;
+};
+
+static struct frame_profile_state g_frame_profile;
+
+const char* frame_profile_zone_names[FRAME_ZONE_COUNT] = {
+    "idle",
+    "world_load",
+    "render",
+    "render_scene",
+    "render_menu",
+    "update",
+    "collision",
+};
+
+void frame_profile_begin(enum frame_profile_zone zone) {
+    assert(g_frame_profile.depth < FRAME_PROFILE_MAX_DEPTH);
+
+    struct frame_profile_open_zone* open_zone = &g_frame_profile.open_zones[g_frame_profile.depth];
+    open_zone->zone = zone;
+    open_zone->start = timer_ticks();
+
+    g_frame_profile.zone_depth[zone] = g_frame_profile.depth;
+    g_frame_profile.depth += 1;
+}
+
+void frame_profile_end(enum frame_profile_zone zone) {
+    long long end = timer_ticks();
+
+    assert(g_frame_profile.depth > 0);
+    g_frame_profile.depth -= 1;
+
+    struct frame_profile_open_zone* open_zone = &g_frame_profile.open_zones[g_frame_profile.depth];
+    // zones have to close in the order they were opened
+    assert(open_zone->zone == zone);
+
+    g_frame_profile.history[g_frame_profile.current].zone_ticks[zone] += (uint32_t)(end - open_zone->start);
+}
+
+void frame_profile_frame_pool(uint32_t used_bytes, uint32_t capacity) {
+    struct frame_profile_sample* sample = &g_frame_profile.history[g_frame_profile.current];
+    sample->frame_pool_bytes = used_bytes;
+    sample->frame_pool_capacity = capacity;
+}
+
+void frame_profile_end_frame() {
+    assert(g_frame_profile.depth == 0);
+
+    long long now = timer_ticks();
+    struct frame_profile_sample* sample = &g_frame_profile.history[g_frame_profile.current];
+
+    if (g_frame_profile.frame_start) {
+        sample->frame_ticks = (uint32_t)(now - g_frame_profile.frame_start);
+    }
+
+    g_frame_profile.frame_start = now;
+
+#ifndef HOST_BUILD
+    // the counters cover whatever the rdp ran since the last frame
+    // which lags behind the cpu by up to a frame
+    sample->rdp_busy = *DPC_BUSY & DPC_COUNTER_MASK;
+    sample->rdp_pipe = *DPC_PIPE_BUSY & DPC_COUNTER_MASK;
+    sample->rdp_tmem = *DPC_TMEM_BUSY & DPC_COUNTER_MASK;
+    *DPC_STATUS = DPC_CLEAR_TMEM_CTR | DPC_CLEAR_PIPE_CTR | DPC_CLEAR_CMD_CTR | DPC_CLEAR_CLOCK_CTR;
+#endif
+
+    heap_stats_t heap_stats;
+    sys_get_heap_stats(&heap_stats);
+    sample->heap_used = heap_stats.used;
+    sample->heap_total = heap_stats.total;
+
+    g_frame_profile.current = (g_frame_profile.current + 1) % FRAME_PROFILE_HISTORY;
+
+    if (g_frame_profile.frame_count < FRAME_PROFILE_HISTORY) {
+        g_frame_profile.frame_count += 1;
+    }
+
+    memset(&g_frame_profile.history[g_frame_profile.current], 0, sizeof(struct frame_profile_sample));
+}
+
+int frame_profile_zone_depth(enum frame_profile_zone zone) {
+    return g_frame_profile.zone_depth[zone];
+}
+
+static struct frame_profile_sample* frame_profile_get_frame(int frames_ago) {
+    int index = (g_frame_profile.current + FRAME_PROFILE_HISTORY - 1 - frames_ago) % FRAME_PROFILE_HISTORY;
+    return &g_frame_profile.history[index];
+}
+
+struct frame_profile_sample* frame_profile_last_frame() {
+    return frame_profile_get_frame(0);
+}
+
+void frame_profile_average(struct frame_profile_sample* result, int frame_count) {
+    memset(result, 0, sizeof(struct frame_profile_sample));
+
+    if (frame_count > g_frame_profile.frame_count) {
+        frame_count = g_frame_profile.frame_count;
+    }
+
+    if (!frame_count) {
+        return;
+    }
+
+    uint64_t frame_ticks = 0;
+    uint64_t zone_ticks[FRAME_ZONE_COUNT] = {0};
+    uint64_t rdp_busy = 0;
+    uint64_t rdp_pipe = 0;
+    uint64_t rdp_tmem = 0;
+
+    for (int i = 0; i < frame_count; i += 1) {
+        struct frame_profile_sample* sample = frame_profile_get_frame(i);
+
+        frame_ticks += sample->frame_ticks;
+
+        for (int zone = 0; zone < FRAME_ZONE_COUNT; zone += 1) {
+            zone_ticks[zone] += sample->zone_ticks[zone];
+        }
+
+        rdp_busy += sample->rdp_busy;
+        rdp_pipe += sample->rdp_pipe;
+        rdp_tmem += sample->rdp_tmem;
+
+        if (sample->frame_pool_bytes > result->frame_pool_bytes) {
+            result->frame_pool_bytes = sample->frame_pool_bytes;
+        }
+    }
+
+    result->frame_ticks = frame_ticks / frame_count;
+
+    for (int zone = 0; zone < FRAME_ZONE_COUNT; zone += 1) {
+        result->zone_ticks[zone] = zone_ticks[zone] / frame_count;
+    }
+
+    result->rdp_busy = rdp_busy / frame_count;
+    result->rdp_pipe = rdp_pipe / frame_count;
+    result->rdp_tmem = rdp_tmem / frame_count;
+
+    // memory is reported as the latest value or the peak, not an average
+    struct frame_profile_sample* last = frame_profile_last_frame();
+    result->frame_pool_capacity = last->frame_pool_capacity;
+    result->heap_used = last->heap_used;
+    result->heap_total = last->heap_total;
+}
+
+void frame_profile_dump() {
+    // the line format is parsed by tools/frame_profile.py
+    fprintf(
+        stderr,
+        "frame_profile begin %d %d %d\n",
+        g_frame_profile.frame_count,
+        TICKS_PER_SECOND,
+        FRAME_PROFILE_RDP_CLOCK
+    );
+
+    fprintf(stderr, "frame_profile columns frame");
+
+    for (int zone = 0; zone < FRAME_ZONE_COUNT; zone += 1) {
+        fprintf(stderr, " %s:%d", frame_profile_zone_names[zone], g_frame_profile.zone_depth[zone]);
+    }
+
+    fprintf(stderr, " rdp_busy rdp_pipe rdp_tmem frame_pool frame_pool_capacity heap heap_total\n");
+
+    for (int i = g_frame_profile.frame_count - 1; i >= 0; i -= 1) {
+        struct frame_profile_sample* sample = frame_profile_get_frame(i);
+
+        fprintf(stderr, "frame_profile f %lu", (unsigned long)sample->frame_ticks);
+
+        for (int zone = 0; zone < FRAME_ZONE_COUNT; zone += 1) {
+            fprintf(stderr, " %lu", (unsigned long)sample->zone_ticks[zone]);
+        }
+
+        fprintf(
+            stderr,
+            " %lu %lu %lu %lu %lu %lu %lu\n",
+            (unsigned long)sample->rdp_busy,
+            (unsigned long)sample->rdp_pipe,
+            (unsigned long)sample->rdp_tmem,
+            (unsigned long)sample->frame_pool_bytes,
+            (unsigned long)sample->frame_pool_capacity,
+            (unsigned long)sample->heap_used,
+            (unsigned long)sample->heap_total
+        );
+    }
+
+    fprintf(stderr, "frame_profile end\n");
+}
@@ -0,0 +1,70 @@
+#ifndef __TIME_FRAME_PROFILE_H__
+#define __TIME_FRAME_PROFILE_H__
+
+#include <stdint.h>
+
+// build with FRAME_PROFILE defined to time where each frame goes,
+// zones can nest and the last FRAME_PROFILE_HISTORY frames are kept
+// so spikes show up instead of being averaged away
+
+enum frame_profile_zone {
+    FRAME_ZONE_IDLE,
+    FRAME_ZONE_WORLD_LOAD,
+    FRAME_ZONE_RENDER,
+    FRAME_ZONE_RENDER_SCENE,
+    FRAME_ZONE_RENDER_MENU,
+    FRAME_ZONE_UPDATE,
+    FRAME_ZONE_COLLISION,
+
+    FRAME_ZONE_COUNT,
+};
+
+#define FRAME_PROFILE_HISTORY       64
+#define FRAME_PROFILE_MAX_DEPTH     8
+// the DPC counters count rdp cycles
+#define FRAME_PROFILE_RDP_CLOCK     62500000
+
+struct frame_profile_sample {
+    // the time between calls to frame_profile_end_frame
+    uint32_t frame_ticks;
+    uint32_t zone_ticks[FRAME_ZONE_COUNT];
+    // rdp clock cycles from the DPC counters
+    uint32_t rdp_busy;
+    uint32_t rdp_pipe;
+    uint32_t rdp_tmem;
+    uint32_t frame_pool_bytes;
+    uint32_t frame_pool_capacity;
+    uint32_t heap_used;
+    uint32_t heap_total;
+};
+
+#ifdef FRAME_PROFILE
+#define FRAME_PROFILE_BEGIN(zone)   frame_profile_begin(zone)
+#define FRAME_PROFILE_END(zone)     frame_profile_end(zone)
+#else
+#define FRAME_PROFILE_BEGIN(zone)
+#define FRAME_PROFILE_END(zone)
+#endif
+
+extern const char* frame_profile_zone_names[FRAME_ZONE_COUNT];
+
+void frame_profile_begin(enum frame_profile_zone zone);
+void frame_profile_end(enum frame_profile_zone zone);
+
+// closes out the current frame, call at the same point in the main
+// loop every frame with no zones open
+void frame_profile_end_frame();
+
+void frame_profile_frame_pool(uint32_t used_bytes, uint32_t capacity);
+
+// how deep the zone was nested the last time it ran
+int frame_profile_zone_depth(enum frame_profile_zone zone);
+// averages the last frame_count frames
+void frame_profile_average(struct frame_profile_sample* result, int frame_count);
+struct frame_profile_sample* frame_profile_last_frame();
+
+// writes the history to the debug log, tools/frame_profile.py
+// turns it into a report
+void frame_profile_dump();
+
+#endif
@@ -1,24 +1,97 @@
 #include "time.h"
 
-#include <malloc.h>
+#include <libdragon.h>
 #include <memory.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <assert.h>
 
 #include "../util/flags.h"
-#include "../util/blist.h"
-#include "../util/callback_list.h"
+#include "../util/memory_tag.h"
+#include "frame_profile.h"
 
-struct update_element {
+struct update_entry {
+    update_callback callback;
     void* data;
+    uint16_t slot;
+    // added during update_dispatch and shouldn't run until the next one
+    uint8_t pending;
+    // the tick within the interval this entry runs on
+    uint8_t phase;
+    // callback is an update_interval_callback
+    uint8_t has_delta;
+#ifdef UPDATE_PROFILE
+    uint32_t ticks;
+#endif
+};
+
+// every callback with the same priority, layer mask and interval
+// shares a bucket so a paused layer skips its buckets entirely
+struct update_bucket {
+    struct update_entry* entries;
+    uint16_t count;
+    uint16_t capacity;
     short priority;
     short mask;
+    uint8_t interval;
+    // counts ticks the bucket was active so paused time doesn't accumulate
+    uint8_t tick;
+    bool has_deletions;
+    uint16_t phase_counts[UPDATE_MAX_INTERVAL];
+};
+
+#ifdef UPDATE_PROFILE
+struct update_tier_stats {
+    uint32_t calls;
+    uint32_t ticks;
+};
+#endif
+
+// handles stay valid while entries move around inside buckets
+struct update_slot {
+    short bucket;
+    uint16_t index;
+    // bumped when the slot is freed so a stale update_id is ignored
+    uint16_t generation;
 };
 
+#define MAX_UPDATE_BUCKETS  32
+#define NO_UPDATE_BUCKET    -1
+
 struct update_state {
-    struct callback_list callbacks;
+    // buckets never move so slots can refer to them by index
+    struct update_bucket buckets[MAX_UPDATE_BUCKETS];
+    // bucket indices sorted by priority
+    uint8_t bucket_order[MAX_UPDATE_BUCKETS];
+    short bucket_count;
+    bool dispatching;
+
+    struct update_slot* slots;
+    uint16_t slot_count;
+    uint16_t slot_capacity;
+    uint16_t next_free_slot;
+
     int enabled_layers;
+
+#ifdef UPDATE_PROFILE
+    struct update_tier_stats tier_stats[UPDATE_MAX_INTERVAL + 1];
+    uint32_t tier_frames;
+#endif
 };
 
 #define MIN_UPDATE_COUNT    64
+#define MIN_BUCKET_SIZE     8
+#define NO_FREE_SLOT        0xFFFF
+
+// an update_id is the slot index with the slot generation above it
+#define UPDATE_ID_SLOT(id)          ((id) & 0xFFFF)
+#define UPDATE_ID_GENERATION(id)    ((id) >> 16)
+#define UPDATE_GENERATION_MASK      0x7FFF
+
+#ifdef UPDATE_PROFILE
+#define UPDATE_PROFILE_INTERVAL 300
+static int g_update_profile_frame;
+#endif
 
 static struct update_state g_update_state;
 float fixed_time_step;
@@ -29,46 +102,215 @@ float game_time;
 float global_time_scale = 1.0f;
 float render_time_step;
 float last_render_time = 0.0f;
+uint32_t update_tick;
+float render_interpolation = 1.0f;
 
-int update_compare_elements(void* a, void* b) {
-    struct update_element* a_el = (struct update_element*)a;
-    struct update_element* b_el = (struct update_element*)b;
-    return a_el->priority - b_el->priority;
-}
+struct update_frame_clock {
+    uint32_t last_ticks;
+    uint32_t accumulator;
+    uint32_t step_ticks;
+    bool started;
+};
+
+static struct update_frame_clock g_update_clock;
+static struct update_frame_stats g_update_frame_stats;
 
 void update_reset() {
-    callback_list_reset(&g_update_state.callbacks, sizeof(struct update_element), MIN_UPDATE_COUNT, update_compare_elements);
+    // tagged_malloc() for bucket entries is done by tagged_realloc
+    for (int i = 0; i < g_update_state.bucket_count; i += 1) {
+        tagged_free(g_update_state.buckets[i].entries);
+    }
+
+    // tagged_malloc() for slots is done by tagged_realloc
+    tagged_free(g_update_state.slots);
+
+    memset(&g_update_state, 0, sizeof(g_update_state));
+    g_update_state.next_free_slot = NO_FREE_SLOT;
     g_update_state.enabled_layers = ~0;
     fixed_time_step = 1.0f / 30.0f;
+    g_update_clock.step_ticks = (uint32_t)(TICKS_PER_SECOND * fixed_time_step);
 }
 
-void update_add(void* data, update_callback callback, int priority, int mask) {
-    struct update_element element;
+static int update_find_bucket(int priority, int mask, int interval) {
+    for (int i = 0; i < g_update_state.bucket_count; i += 1) {
+        struct update_bucket* bucket = &g_update_state.buckets[i];
 
-    element.data = data;
-    element.priority = priority;
-    element.mask = mask;
+        if (bucket->priority == priority && bucket->mask == mask && bucket->interval == interval) {
+            return i;
+        }
+    }
 
-    callback_list_insert_with_id(&g_update_state.callbacks, callback, &element, (callback_id)data);
-}
+    assert(g_update_state.bucket_count < MAX_UPDATE_BUCKETS);
+
+    int result = g_update_state.bucket_count;
+    struct update_bucket* bucket = &g_update_state.buckets[result];
+    memset(bucket, 0, sizeof(struct update_bucket));
+    bucket->priority = priority;
+    bucket->mask = mask;
+    bucket->interval = interval;
+
+    int insert_at = result;
+
+    while (insert_at > 0 && g_update_state.buckets[g_update_state.bucket_order[insert_at - 1]].priority > priority) {
+        g_update_state.bucket_order[insert_at] = g_update_state.bucket_order[insert_at - 1];
+        insert_at -= 1;
+    }
 
-void update_remove(void* data) {
-    callback_list_remove(&g_update_state.callbacks, (callback_id)data);
+    g_update_state.bucket_order[insert_at] = result;
+    g_update_state.bucket_count += 1;
+
+    return result;
 }
 
-void update_set_layers(void* data, int mask) {
-    struct callback_element* current = callback_list_get(&g_update_state.callbacks, 0);
+static int update_alloc_slot() {
+    if (g_update_state.next_free_slot != NO_FREE_SLOT) {
+        int result = g_update_state.next_free_slot;
+        g_update_state.next_free_slot = g_update_state.slots[result].index;
+        return result;
+    }
 
-    for (int i = 0; i < g_update_state.callbacks.count; ++i) {
-        struct update_element* element = callback_element_get_data(current);
+    if (g_update_state.slot_count == g_update_state.slot_capacity) {
+        g_update_state.slot_capacity = g_update_state.slot_capacity ? g_update_state.slot_capacity * 2 : MIN_UPDATE_COUNT;
+        g_update_state.slots = tagged_realloc(MEMORY_TAG_CALLBACKS, g_update_state.slots, sizeof(struct update_slot) * g_update_state.slot_capacity);
+    }
+
+    int result = g_update_state.slot_count;
+    g_update_state.slots[result].generation = 0;
+    g_update_state.slot_count += 1;
+    return result;
+}
 
-        if (element->data == data) {
-            element->mask = mask;
-            return;
+// picks the least used phase so callbacks in a bucket are spread across ticks
+static int update_bucket_next_phase(struct update_bucket* bucket) {
+    int result = 0;
+
+    for (int phase = 1; phase < bucket->interval; phase += 1) {
+        if (bucket->phase_counts[phase] < bucket->phase_counts[result]) {
+            result = phase;
         }
-        
-        current = callback_list_next(&g_update_state.callbacks, current);
     }
+
+    return result;
+}
+
+static void update_bucket_append(int bucket_index, update_callback callback, bool has_delta, void* data, int slot_index) {
+    struct update_bucket* bucket = &g_update_state.buckets[bucket_index];
+
+    if (bucket->count == bucket->capacity) {
+        bucket->capacity = bucket->capacity ? bucket->capacity * 2 : MIN_BUCKET_SIZE;
+        bucket->entries = tagged_realloc(MEMORY_TAG_CALLBACKS, bucket->entries, sizeof(struct update_entry) * bucket->capacity);
+    }
+
+    struct update_entry* entry = &bucket->entries[bucket->count];
+    entry->callback = callback;
+    entry->data = data;
+    entry->has_delta = has_delta;
+    entry->slot = slot_index;
+    entry->pending = g_update_state.dispatching;
+    entry->phase = update_bucket_next_phase(bucket);
+    bucket->phase_counts[entry->phase] += 1;
+#ifdef UPDATE_PROFILE
+    entry->ticks = 0;
+#endif
+
+    struct update_slot* slot = &g_update_state.slots[slot_index];
+    slot->bucket = bucket_index;
+    slot->index = bucket->count;
+
+    bucket->count += 1;
+}
+
+// removes the entry a slot points to, the slot itself is left alone
+static void update_bucket_remove(struct update_slot* slot) {
+    struct update_bucket* bucket = &g_update_state.buckets[slot->bucket];
+    struct update_entry* entry = &bucket->entries[slot->index];
+    bucket->phase_counts[entry->phase] -= 1;
+
+    if (g_update_state.dispatching) {
+        // indices need to stay stable while dispatching
+        // the hole is removed at the end of update_dispatch
+        entry->callback = NULL;
+        bucket->has_deletions = true;
+        return;
+    }
+
+    struct update_entry* last = &bucket->entries[bucket->count - 1];
+
+    if (entry != last) {
+        *entry = *last;
+        g_update_state.slots[entry->slot].index = slot->index;
+    }
+
+    bucket->count -= 1;
+}
+
+static struct update_slot* update_find_slot(update_id id) {
+    if (id < 0 || UPDATE_ID_SLOT(id) >= g_update_state.slot_count) {
+        return NULL;
+    }
+
+    struct update_slot* slot = &g_update_state.slots[UPDATE_ID_SLOT(id)];
+
+    if (slot->bucket == NO_UPDATE_BUCKET || slot->generation != UPDATE_ID_GENERATION(id)) {
+        return NULL;
+    }
+
+    return slot;
+}
+
+static update_id update_add_entry(void* data, update_callback callback, bool has_delta, int priority, int mask, int interval) {
+    assert(interval >= 1 && interval <= UPDATE_MAX_INTERVAL);
+
+    int bucket_index = update_find_bucket(priority, mask, interval);
+    int slot_index = update_alloc_slot();
+    update_bucket_append(bucket_index, callback, has_delta, data, slot_index);
+
+    return (g_update_state.slots[slot_index].generation << 16) | slot_index;
+}
+
+update_id update_add(void* data, update_callback callback, int priority, int mask) {
+    return update_add_entry(data, callback, false, priority, mask, UPDATE_INTERVAL_EVERY_TICK);
+}
+
+update_id update_add_interval(void* data, update_interval_callback callback, int priority, int mask, int interval) {
+    return update_add_entry(data, (update_callback)callback, true, priority, mask, interval);
+}
+
+// a single update_remove() handles callbacks from either add function
+void update_remove(update_id id) {
+    struct update_slot* slot = update_find_slot(id);
+
+    if (!slot) {
+        return;
+    }
+
+    update_bucket_remove(slot);
+
+    slot->bucket = NO_UPDATE_BUCKET;
+    slot->index = g_update_state.next_free_slot;
+    slot->generation = (slot->generation + 1) & UPDATE_GENERATION_MASK;
+    g_update_state.next_free_slot = UPDATE_ID_SLOT(id);
+}
+
+void update_set_layers(update_id id, int mask) {
+    struct update_slot* slot = update_find_slot(id);
+
+    if (!slot) {
+        return;
+    }
+
+    struct update_bucket* bucket = &g_update_state.buckets[slot->bucket];
+
+    if (bucket->mask == mask) {
+        return;
+    }
+
+    struct update_entry entry = bucket->entries[slot->index];
+    int slot_index = slot - g_update_state.slots;
+    update_bucket_remove(slot);
+
+    int bucket_index = update_find_bucket(bucket->priority, mask, bucket->interval);
+    update_bucket_append(bucket_index, entry.callback, entry.has_delta, entry.data, slot_index);
 }
 
 void update_pause_layers(int mask) {
@@ -88,7 +330,169 @@ void update_render_time() {
     last_render_time = game_time;
 }
 
+#ifdef UPDATE_PROFILE
+void update_tier_report() {
+    int frames = g_update_state.tier_frames ? g_update_state.tier_frames : 1;
+
+    fprintf(stderr, "update tiers (average over %d frames):\n", frames);
+
+    for (int interval = 1; interval <= UPDATE_MAX_INTERVAL; interval += 1) {
+        int callback_count = 0;
+
+        for (int i = 0; i < g_update_state.bucket_count; i += 1) {
+            struct update_bucket* bucket = &g_update_state.buckets[i];
+
+            if (bucket->interval == interval) {
+                callback_count += bucket->count;
+            }
+        }
+
+        struct update_tier_stats* tier = &g_update_state.tier_stats[interval];
+
+        if (!callback_count && !tier->calls) {
+            continue;
+        }
+
+        fprintf(
+            stderr,
+            "    every %d ticks: %3d callbacks %3d calls/frame %4dus/frame\n",
+            interval,
+            callback_count,
+            (int)(tier->calls / frames),
+            (int)TICKS_TO_US(tier->ticks / frames)
+        );
+
+        tier->calls = 0;
+        tier->ticks = 0;
+    }
+
+    g_update_state.tier_frames = 0;
+}
+
+static void update_profile_report() {
+    fprintf(stderr, "update profile (average over %d frames):\n", UPDATE_PROFILE_INTERVAL);
+
+    for (int order_index = 0; order_index < g_update_state.bucket_count; order_index += 1) {
+        struct update_bucket* bucket = &g_update_state.buckets[g_update_state.bucket_order[order_index]];
+
+        for (int i = 0; i < bucket->count; i += 1) {
+            struct update_entry* entry = &bucket->entries[i];
+            fprintf(
+                stderr,
+                "    priority %d layers %02x %p(%p) %dus\n",
+                bucket->priority,
+                bucket->mask,
+                entry->callback,
+                entry->data,
+                (int)TICKS_TO_US(entry->ticks / UPDATE_PROFILE_INTERVAL)
+            );
+            entry->ticks = 0;
+        }
+    }
+}
+#endif
+
+static void update_bucket_compact(struct update_bucket* bucket) {
+    int write_index = 0;
+
+    for (int read_index = 0; read_index < bucket->count; read_index += 1) {
+        struct update_entry* entry = &bucket->entries[read_index];
+
+        if (!entry->callback) {
+            continue;
+        }
+
+        if (write_index != read_index) {
+            bucket->entries[write_index] = *entry;
+            g_update_state.slots[entry->slot].index = write_index;
+        }
+
+        write_index += 1;
+    }
+
+    bucket->count = write_index;
+    bucket->has_deletions = false;
+}
+
+int update_frame_steps() {
+    struct update_frame_clock* clock = &g_update_clock;
+    struct update_frame_stats* stats = &g_update_frame_stats;
+    uint32_t now = get_ticks();
+
+    if (!clock->started) {
+        // the first frame runs a single step
+        clock->started = true;
+        clock->accumulator = clock->step_ticks;
+    } else {
+        clock->accumulator += now - clock->last_ticks;
+    }
+
+    clock->last_ticks = now;
+
+    int steps = clock->accumulator / clock->step_ticks;
+
+    if (steps > UPDATE_MAX_STEPS_PER_FRAME) {
+        steps = UPDATE_MAX_STEPS_PER_FRAME;
+        stats->capped_frames += 1;
+        clock->accumulator = clock->accumulator % clock->step_ticks + steps * clock->step_ticks;
+    }
+
+    clock->accumulator -= steps * clock->step_ticks;
+    render_interpolation = (float)clock->accumulator / (float)clock->step_ticks;
+
+    stats->frames += 1;
+    stats->steps += steps;
+    stats->step_histogram[steps] += 1;
+
+#ifdef FRAME_PROFILE
+    if (stats->frames == UPDATE_FRAME_REPORT_INTERVAL) {
+        update_frame_report();
+    }
+#endif
+
+    return steps;
+}
+
+void update_frame_skip() {
+    g_update_clock.last_ticks = get_ticks();
+}
+
+void update_frame_dropped() {
+    g_update_frame_stats.dropped_frames += 1;
+}
+
+struct update_frame_stats* update_get_frame_stats() {
+    return &g_update_frame_stats;
+}
+
+#ifdef FRAME_PROFILE
+void update_frame_report() {
+    struct update_frame_stats* stats = &g_update_frame_stats;
+    int frames = stats->frames ? stats->frames : 1;
+
+    fprintf(
+        stderr,
+        "update frames: %d frames %d.%02d steps/frame dropped %d capped %d steps",
+        (int)stats->frames,
+        (int)(stats->steps / frames),
+        (int)(stats->steps * 100 / frames % 100),
+        (int)stats->dropped_frames,
+        (int)stats->capped_frames
+    );
+
+    for (int i = 0; i <= UPDATE_MAX_STEPS_PER_FRAME; i += 1) {
+        fprintf(stderr, " %d:%d", i, (int)stats->step_histogram[i]);
+    }
+
+    fprintf(stderr, "\n");
+
+    memset(stats, 0, sizeof(struct update_frame_stats));
+}
+#endif
+
 void update_dispatch() {
+    FRAME_PROFILE_BEGIN(FRAME_ZONE_UPDATE);
+    update_tick += 1;
     total_time += fixed_time_step;
     scaled_time_step = fixed_time_step * global_time_scale;
     scaled_time_step_inv = 1.0f / scaled_time_step;
@@ -97,19 +501,87 @@ void update_dispatch() {
         game_time += scaled_time_step;
     }
 
-    callback_list_begin(&g_update_state.callbacks);
+    g_update_state.dispatching = true;
+
+    // callbacks can add buckets so bucket_count is checked each time
+    for (int order_index = 0; order_index < g_update_state.bucket_count; order_index += 1) {
+        int bucket_index = g_update_state.bucket_order[order_index];
+        struct update_bucket* bucket = &g_update_state.buckets[bucket_index];
+
+        if (!(bucket->mask & g_update_state.enabled_layers)) {
+            continue;
+        }
+
+#ifdef UPDATE_PROFILE
+        struct update_tier_stats* tier = &g_update_state.tier_stats[bucket->interval];
+        uint32_t bucket_start = get_ticks();
+#endif
+
+        int phase = bucket->tick;
+        float delta = fixed_time_step * bucket->interval;
+
+        // entries can be reallocated by a callback so they are indexed each time
+        for (int i = 0; i < bucket->count; i += 1) {
+            struct update_entry* entry = &bucket->entries[i];
+
+            if (!entry->callback || entry->pending || entry->phase != phase) {
+                continue;
+            }
+
+#ifdef UPDATE_PROFILE
+            uint32_t start = get_ticks();
+#endif
+            if (entry->has_delta) {
+                ((update_interval_callback)entry->callback)(entry->data, delta);
+            } else {
+                entry->callback(entry->data);
+            }
+#ifdef UPDATE_PROFILE
+            bucket->entries[i].ticks += get_ticks() - start;
+            tier->calls += 1;
+#endif
+        }
+
+        bucket->tick += 1;
+
+        if (bucket->tick == bucket->interval) {
+            bucket->tick = 0;
+        }
+
+#ifdef UPDATE_PROFILE
+        tier->ticks += get_ticks() - bucket_start;
+#endif
+
+        // a bucket created by a callback may have been sorted before this one
+        while (g_update_state.bucket_order[order_index] != bucket_index) {
+            order_index += 1;
+        }
+    }
+
+    g_update_state.dispatching = false;
 
-    struct callback_element* current = callback_list_get(&g_update_state.callbacks, 0);
+#ifdef UPDATE_PROFILE
+    g_update_state.tier_frames += 1;
+    g_update_profile_frame += 1;
 
-    for (int i = 0; i < g_update_state.callbacks.count; ++i) {
-        struct update_element* element = callback_element_get_data(current);
+    if (g_update_profile_frame == UPDATE_PROFILE_INTERVAL) {
+        g_update_profile_frame = 0;
+        update_profile_report();
+        update_tier_report();
+    }
+#endif
 
-        if (element->mask & g_update_state.enabled_layers) {
-            ((update_callback)current->callback)(element->data);
+    for (int bucket_index = 0; bucket_index < g_update_state.bucket_count; bucket_index += 1) {
+        struct update_bucket* bucket = &g_update_state.buckets[bucket_index];
+
+        if (bucket->has_deletions) {
+            update_bucket_compact(bucket);
+        }
+
+        for (int i = 0; i < bucket->count; i += 1) {
+            bucket->entries[i].pending = false;
         }
-        
-        current = callback_list_next(&g_update_state.callbacks, current);
     }
 
-    callback_list_end(&g_update_state.callbacks);
-}
\ No newline at end of file
+    FRAME_PROFILE_END(FRAME_ZONE_UPDATE);
+}
@@ -2,11 +2,17 @@
 #define __TIME_TIME_H__
 
 #include <stdbool.h>
+#include <stdint.h>
 
 typedef void (*update_callback)(void* data);
+// delta is the time since the callback last ran
+typedef void (*update_interval_callback)(void* data, float delta);
 
 typedef int update_id;
 
+// update_remove() ignores this and ids that were already removed
+#define UPDATE_ID_NONE  -1
+
 #define UPDATE_LAYER_WORLD          (1 << 0)
 #define UPDATE_LAYER_PLAYER         (1 << 1)
 #define UPDATE_LAYER_DIALOG         (1 << 2)
@@ -18,12 +24,37 @@ typedef int update_id;
 #define UPDATE_PRIORITY_CAMERA  2
 #define UPDATE_PRIORITY_EFFECTS 3
 
+// callbacks that don't need to run every tick can run every
+// 2, 4 or 8 ticks, their phase is staggered so a tier's work
+// is spread evenly across frames
+#define UPDATE_INTERVAL_EVERY_TICK  1
+#define UPDATE_INTERVAL_HALF        2
+#define UPDATE_INTERVAL_QUARTER     4
+#define UPDATE_INTERVAL_EIGHTH      8
+#define UPDATE_MAX_INTERVAL         8
+
+// if rendering falls far enough behind the simulation gives up on
+// catching up rather than spending every frame updating
+#define UPDATE_MAX_STEPS_PER_FRAME  4
+#define UPDATE_FRAME_REPORT_INTERVAL    600
+
+struct update_frame_stats {
+    uint32_t frames;
+    uint32_t steps;
+    uint32_t step_histogram[UPDATE_MAX_STEPS_PER_FRAME + 1];
+    // frames where no frame buffer was free to render into
+    uint32_t dropped_frames;
+    // frames that hit UPDATE_MAX_STEPS_PER_FRAME and lost time
+    uint32_t capped_frames;
+};
+
 void update_reset();
-void update_add(void* data, update_callback callback, int priority, int mask);
-void update_remove(void* data);
-void update_remove_with_data(void* data, update_callback callback);
+update_id update_add(void* data, update_callback callback, int priority, int mask);
+update_id update_add_interval(void* data, update_interval_callback callback, int priority, int mask, int interval);
+// does nothing if id was already removed
+void update_remove(update_id id);
 
-void update_set_layers(void* data, int mask);
+void update_set_layers(update_id id, int mask);
 
 void update_pause_layers(int mask);
 void update_unpause_layers(int mask);
@@ -31,8 +62,26 @@ bool update_has_layer(int mask);
 
 void update_render_time();
 
+// build with PROFILE=1 to log the time spent in each callback
 void update_dispatch();
 
+// returns how many fixed steps are due since the last call
+// and sets render_interpolation for the next render
+int update_frame_steps();
+// time that passes until the next call isn't simulated, used while loading
+void update_frame_skip();
+void update_frame_dropped();
+struct update_frame_stats* update_get_frame_stats();
+#ifdef FRAME_PROFILE
+void update_frame_report();
+#endif
+
+#ifdef UPDATE_PROFILE
+// prints the callbacks, calls and time per frame of each interval
+// since the last report
+void update_tier_report();
+#endif
+
 extern float fixed_time_step;
 extern float scaled_time_step;
 extern float scaled_time_step_inv;
@@ -40,5 +89,9 @@ extern float total_time;
 extern float game_time;
 extern float global_time_scale;
 extern float render_time_step;
+// incremented by every update_dispatch
+extern uint32_t update_tick;
+// how far between the last two ticks rendering is, from 0 to 1
+extern float render_interpolation;
 
 #endif
\ No newline at end of file
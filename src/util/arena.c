@@ -0,0 +1,59 @@
+#include "arena.h"
+
+#include <malloc.h>
+#include <assert.h>
+
+#define ALIGN_UP(number)    (((number) + 7) & ~7)
+
+void arena_init_with_buffer(struct arena* arena, void* buffer, int capacity) {
+    assert(ALIGN_UP((intptr_t)buffer) == (intptr_t)buffer);
+    arena->memory = buffer;
+    arena->capacity = capacity & ~7;
+    arena->current = 0;
+    arena->high_water = 0;
+    arena->allocation_count = 0;
+    arena->overflow_count = 0;
+}
+
+void arena_init(struct arena* arena, int capacity) {
+    capacity = ALIGN_UP(capacity);
+    void* memory = malloc(capacity);
+    assert(memory);
+    arena_init_with_buffer(arena, memory, capacity);
+}
+
+void arena_destroy(struct arena* arena) {
+    free(arena->memory);
+    arena->memory = NULL;
+    arena->capacity = 0;
+    arena->current = 0;
+}
+
+void* arena_malloc(struct arena* arena, int bytes) {
+    uint32_t size = ALIGN_UP(bytes);
+
+    if (arena->current + size > arena->capacity) {
+        arena->overflow_count += 1;
+        return NULL;
+    }
+
+    void* result = arena->memory + arena->current;
+    arena->current += size;
+    arena->allocation_count += 1;
+
+    if (arena->current > arena->high_water) {
+        arena->high_water = arena->current;
+    }
+
+    return result;
+}
+
+void arena_reset(struct arena* arena) {
+    arena->current = 0;
+    arena->allocation_count = 0;
+    arena->overflow_count = 0;
+}
+
+bool arena_contains(struct arena* arena, void* memory) {
+    return (char*)memory >= arena->memory && (char*)memory < arena->memory + arena->capacity;
+}
@@ -0,0 +1,28 @@
+#ifndef __UTIL_ARENA_H__
+#define __UTIL_ARENA_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// bump allocator, individual allocations are never
+// freed, the whole arena is released with arena_reset
+struct arena {
+    char* memory;
+    uint32_t capacity;
+    uint32_t current;
+    uint32_t high_water;
+    uint16_t allocation_count;
+    uint16_t overflow_count;
+};
+
+void arena_init(struct arena* arena, int capacity);
+void arena_init_with_buffer(struct arena* arena, void* buffer, int capacity);
+void arena_destroy(struct arena* arena);
+
+// returns NULL if the arena is full
+void* arena_malloc(struct arena* arena, int bytes);
+void arena_reset(struct arena* arena);
+
+bool arena_contains(struct arena* arena, void* memory);
+
+#endif
@@ -0,0 +1,38 @@
+#include "arena.h"
+#include "../test/framework_test.h"
+
+#include <stddef.h>
+
+void test_arena_malloc(struct test_context* t) {
+    struct arena arena;
+    arena_init(&arena, 64);
+    test_eqi(t, 64, arena.capacity);
+
+    // allocations are 8 byte aligned and contiguous
+    char* first = arena_malloc(&arena, 3);
+    char* second = arena_malloc(&arena, 8);
+    test_neqp(t, NULL, first);
+    test_eqi(t, 8, second - first);
+    test_eqi(t, 16, arena.current);
+    test_eqi(t, 2, arena.allocation_count);
+    test_eqi(t, true, arena_contains(&arena, second));
+
+    // running out of space fails without moving the bump pointer
+    test_eqp(t, NULL, arena_malloc(&arena, 56));
+    test_eqi(t, 16, arena.current);
+    test_eqi(t, 1, arena.overflow_count);
+
+    void* rest = arena_malloc(&arena, 48);
+    test_neqp(t, NULL, rest);
+    test_eqi(t, 64, arena.high_water);
+
+    // reset releases everything but keeps the high water mark
+    arena_reset(&arena);
+    test_eqi(t, 0, arena.current);
+    test_eqi(t, 0, arena.allocation_count);
+    test_eqi(t, 64, arena.high_water);
+    test_eqp(t, first, arena_malloc(&arena, 8));
+    test_eqi(t, false, arena_contains(&arena, &arena));
+
+    arena_destroy(&arena);
+}
@@ -4,18 +4,20 @@
 #include <memory.h>
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "blist.h"
+#include "memory_tag.h"
 
 void callback_list_reset(struct callback_list* list, int data_size, int min_capcity, data_compare data_compare_callback) {
-    free(list->elements);
-    // malloc() pending_elements is done by realloc
-    free(list->pending_elements);
+    tagged_free(list->elements);
+    // tagged_malloc() pending_elements is done by tagged_realloc
+    tagged_free(list->pending_elements);
     list->elements = NULL;
     memset(list, 0, sizeof(struct callback_list));
     // aligned to 4 bytes
     list->element_size = (sizeof(struct callback_element) + data_size + 3) & ~3;
     list->flags = 0;
-    list->elements = malloc(list->element_size * min_capcity);
+    list->elements = tagged_malloc(MEMORY_TAG_CALLBACKS, list->element_size * min_capcity);
     list->capacity = min_capcity;
     list->data_compare_callback = data_compare_callback;
     list->pending_elements = 0;
@@ -36,7 +38,11 @@ int callback_list_element_compare(void* array, int a_index, int b_index) {
         }
     }
 
-    return (int)a->callback - (int)b->callback;
+    if (a->callback == b->callback) {
+        return 0;
+    }
+
+    return (uintptr_t)a->callback < (uintptr_t)b->callback ? -1 : 1;
 }
 
 void callback_list_insert_pending(struct callback_list* list, void* callback, int id, void* data) {
@@ -47,7 +53,7 @@ void callback_list_insert_pending(struct callback_list* list, void* callback, in
             list->pending_element_capacity *= 2;
         }
 
-        list->pending_elements = realloc(list->pending_elements, list->element_size * list->pending_element_capacity);
+        list->pending_elements = tagged_realloc(MEMORY_TAG_CALLBACKS, list->pending_elements, list->element_size * list->pending_element_capacity);
     }
 
     struct callback_element* next = (struct callback_element*)((char*)list->pending_elements + list->element_size * list->pending_element_count);
@@ -61,7 +67,7 @@ void callback_list_insert_pending(struct callback_list* list, void* callback, in
 void callback_list_do_insert_with_id(struct callback_list* list, void* callback, int id, void* data) {
     if (list->capacity == list->count) {
         list->capacity *= 2;
-        list->elements = realloc(list->elements, list->element_size * list->capacity);
+        list->elements = tagged_realloc(MEMORY_TAG_CALLBACKS, list->elements, list->element_size * list->capacity);
     }
 
     struct callback_element* element = callback_list_get(list, list->count);
@@ -75,7 +81,7 @@ void callback_list_do_insert_with_id(struct callback_list* list, void* callback,
 
     if (new_pos != element) {
         // shift exisiting elements
-        memmove(callback_list_get(list, insert_index + 1), new_pos, (int)element - (int)new_pos);
+        memmove(callback_list_get(list, insert_index + 1), new_pos, (char*)element - (char*)new_pos);
 
         // reassign into new position
         element = callback_list_get(list, insert_index);
@@ -154,7 +160,7 @@ void callback_list_remove(struct callback_list* list, callback_id id) {
     struct callback_element* next_element = callback_list_next(list, found_at);
 
     if (next_element < array_end) {
-        memmove(found_at, next_element, (int)array_end - (int)next_element); 
+        memmove(found_at, next_element, (char*)array_end - (char*)next_element); 
     }
 
     list->count -= 1;
@@ -0,0 +1,12 @@
+#include "hash.h"
+
+uint32_t hash_bytes(uint32_t hash, const void* data, int size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    for (int i = 0; i < size; i += 1) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
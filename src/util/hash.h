@@ -0,0 +1,13 @@
+#ifndef __UTIL_HASH_H__
+#define __UTIL_HASH_H__
+
+#include <stdint.h>
+
+// 32 bit fnv-1a, start with FNV_OFFSET_BASIS and fold
+// in each value to build up the hash of some state
+#define FNV_OFFSET_BASIS    2166136261u
+#define FNV_PRIME           16777619u
+
+uint32_t hash_bytes(uint32_t hash, const void* data, int size);
+
+#endif
@@ -2,100 +2,193 @@
 
 #include <malloc.h>
 #include <memory.h>
+#include <assert.h>
 
-// a 32 bit prime number
-#define MAGIC_PRIME 2748002342
+// 2^32 / golden ratio
+#define HASH_MULTIPLIER 2654435769u
 #define MIN_CAPACITY    32
 
-void hash_map_init(struct hash_map* hash_map, int capacity) {
-    if (capacity < MIN_CAPACITY) {
-        capacity = MIN_CAPACITY;
-    }
+#define HASH_MAP_MAX_PROBE_LENGTH   16
 
-    capacity *= 2;
+// robin hood hashing, entries that are further from their home
+// slot take the place of entries that are closer to theirs which
+// keeps probe lengths short and lets a lookup stop early on a miss
 
+static int hash_map_home(int key, int mask) {
+    uint32_t hash = (uint32_t)key * HASH_MULTIPLIER;
+    return (hash ^ (hash >> 16)) & mask;
+}
+
+static int hash_map_probe_length(struct hash_map* hash_map, int index) {
+    int mask = hash_map->capacity - 1;
+    return (index - hash_map_home(hash_map->entries[index].key, mask)) & mask;
+}
+
+static void hash_map_allocate(struct hash_map* hash_map, int capacity) {
     hash_map->entries = malloc(sizeof(struct hash_map_entry) * capacity);
     hash_map->capacity = capacity;
     hash_map->count = 0;
+    hash_map->max_probe_length = 0;
 
     memset(hash_map->entries, 0, sizeof(struct hash_map_entry) * capacity);
 }
 
+void hash_map_init(struct hash_map* hash_map, int capacity) {
+    if (capacity < MIN_CAPACITY) {
+        capacity = MIN_CAPACITY;
+    }
+
+    hash_map_allocate(hash_map, capacity * 2);
+}
+
 void hash_map_destroy(struct hash_map* hash_map) {
     free(hash_map->entries);
 }
 
-struct hash_map_entry* hash_map_find_entry(struct hash_map_entry* entries, int capacity, int key) {
-    int mask = capacity - 1;
+static int hash_map_find_index(struct hash_map* hash_map, int key) {
+    int mask = hash_map->capacity - 1;
+    int index = hash_map_home(key, mask);
 
-    int index = (key * MAGIC_PRIME) & mask;
+    for (int distance = 0; distance <= hash_map->max_probe_length; distance += 1) {
+        struct hash_map_entry* entry = &hash_map->entries[index];
 
-    for (int i = 0; i < capacity; i += 1) {
-        struct hash_map_entry* entry = &entries[index];
+        if (entry->key == key) {
+            return index;
+        }
 
-        if (entry->key == key || entry->key == 0) {
-            return entry;
+        // an entry closer to home means the key would have been placed here
+        if (entry->key == 0 || hash_map_probe_length(hash_map, index) < distance) {
+            return -1;
         }
 
         index = (index + 1) & mask;
     }
-    
-    return NULL;
+
+    return -1;
 }
 
-void hash_map_resize(struct hash_map* hash_map) {
-    int new_capacity = hash_map->capacity * 2;
-    struct hash_map_entry* new_entries = malloc(sizeof(struct hash_map_entry) * new_capacity);
-    memset(new_entries, 0, sizeof(struct hash_map_entry) * new_capacity);
+static void hash_map_insert(struct hash_map* hash_map, int key, void* value) {
+    int mask = hash_map->capacity - 1;
+    int index = hash_map_home(key, mask);
+    int distance = 0;
 
-    for (int i = 0; i < hash_map->capacity; i += 1) {
-        struct hash_map_entry* prev_entry = &hash_map->entries[i];
+    struct hash_map_entry current = {key, value};
+
+    for (;;) {
+        struct hash_map_entry* entry = &hash_map->entries[index];
+
+        if (entry->key == 0) {
+            *entry = current;
+            break;
+        }
 
-        struct hash_map_entry* new_entry = hash_map_find_entry(new_entries, new_capacity, prev_entry->key);
-        new_entry->key = prev_entry->key;
-        new_entry->value = prev_entry->value;
+        int entry_distance = hash_map_probe_length(hash_map, index);
+
+        if (entry_distance < distance) {
+            struct hash_map_entry tmp = *entry;
+            *entry = current;
+            current = tmp;
+
+            if (distance > hash_map->max_probe_length) {
+                hash_map->max_probe_length = distance;
+            }
+
+            distance = entry_distance;
+        }
+
+        index = (index + 1) & mask;
+        distance += 1;
     }
 
-    free(hash_map->entries);
-    hash_map->entries = new_entries;
-    hash_map->capacity = new_capacity;
+    if (distance > hash_map->max_probe_length) {
+        hash_map->max_probe_length = distance;
+    }
+
+    hash_map->count += 1;
+}
+
+static void hash_map_resize(struct hash_map* hash_map, int new_capacity) {
+    struct hash_map prev = *hash_map;
+    hash_map_allocate(hash_map, new_capacity);
+
+    for (int i = 0; i < prev.capacity; i += 1) {
+        struct hash_map_entry* prev_entry = &prev.entries[i];
+
+        if (prev_entry->key) {
+            hash_map_insert(hash_map, prev_entry->key, prev_entry->value);
+        }
+    }
+
+    // malloc(prev.entries) was done in hash_map_allocate
+    free(prev.entries);
+}
+
+static int hash_map_should_grow(int capacity, int count) {
+    // keep the load factor under 3/4
+    return count * 4 > capacity * 3;
+}
+
+void hash_map_reserve(struct hash_map* hash_map, int count) {
+    int capacity = hash_map->capacity;
+
+    while (hash_map_should_grow(capacity, count)) {
+        capacity *= 2;
+    }
+
+    if (capacity != hash_map->capacity) {
+        hash_map_resize(hash_map, capacity);
+    }
 }
 
 void* hash_map_get(struct hash_map* hash_map, int key) {
-    struct hash_map_entry* result = hash_map_find_entry(hash_map->entries, hash_map->capacity, key);
+    int index = hash_map_find_index(hash_map, key);
 
-    if (result) {
-        return result->value;
+    if (index == -1) {
+        return NULL;
     }
 
-    return NULL;
+    return hash_map->entries[index].value;
 }
 
 void hash_map_set(struct hash_map* hash_map, int key, void* value) {
-    struct hash_map_entry* result = hash_map_find_entry(hash_map->entries, hash_map->capacity, key);
+    assert(key != 0);
+    int index = hash_map_find_index(hash_map, key);
 
-    // check if the hash map should be grown
-    if (result->key != key && (hash_map->count << 1) >= hash_map->capacity) {
-        hash_map_resize(hash_map);
+    if (index != -1) {
+        hash_map->entries[index].value = value;
+        return;
+    }
 
-        result = hash_map_find_entry(hash_map->entries, hash_map->capacity, key);
+    if (hash_map_should_grow(hash_map->capacity, hash_map->count + 1)) {
+        hash_map_resize(hash_map, hash_map->capacity * 2);
     }
 
-    if (result->key == key) {
-        result->value = value;
-    } else {
-        result->key = key;
-        result->value = value;
-        hash_map->count += 1;
+    hash_map_insert(hash_map, key, value);
+
+    if (hash_map->max_probe_length > HASH_MAP_MAX_PROBE_LENGTH) {
+        hash_map_resize(hash_map, hash_map->capacity * 2);
     }
 }
 
 void hash_map_delete(struct hash_map* hash_map, int key) {
-    struct hash_map_entry* entry = hash_map_find_entry(hash_map->entries, hash_map->capacity, key);
+    int index = hash_map_find_index(hash_map, key);
+
+    if (index == -1) {
+        return;
+    }
 
-    if (entry && entry->key == key) {
-        hash_map->count -= 1;
-        entry->key = 0;
-        entry->value = 0;
+    int mask = hash_map->capacity - 1;
+    int next = (index + 1) & mask;
+
+    // shift following entries back toward their home slot
+    // so no tombstone is needed
+    while (hash_map->entries[next].key && hash_map_probe_length(hash_map, next) > 0) {
+        hash_map->entries[index] = hash_map->entries[next];
+        index = next;
+        next = (next + 1) & mask;
     }
-}
\ No newline at end of file
+
+    hash_map->entries[index].key = 0;
+    hash_map->entries[index].value = NULL;
+    hash_map->count -= 1;
+}
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 
+// key 0 marks an empty entry and cannot be stored
 struct hash_map_entry {
     int key;
     void* value;
@@ -12,14 +13,20 @@ struct hash_map {
     struct hash_map_entry* entries;
     uint16_t capacity;
     uint16_t count;
+    // longest distance any entry is from its home slot
+    // the map grows when this passes HASH_MAP_MAX_PROBE_LENGTH
+    uint16_t max_probe_length;
 };
 
 // capacity must be a power of 2
 void hash_map_init(struct hash_map* hash_map, int capacity);
 void hash_map_destroy(struct hash_map* hash_map);
 
+// grows the map so count entries can be stored without resizing
+void hash_map_reserve(struct hash_map* hash_map, int count);
+
 void* hash_map_get(struct hash_map* hash_map, int key);
 void hash_map_set(struct hash_map* hash_map, int key, void* value);
 void hash_map_delete(struct hash_map* hash_map, int key);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,116 @@
+#include "hash_map.h"
+#include "../test/framework_test.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <libdragon.h>
+
+#define HASH_MAP_TEST_KEY_RANGE     512
+#define HASH_MAP_TEST_ITERATIONS    20000
+#define HASH_MAP_BENCHMARK_COUNT    256
+#define HASH_MAP_BENCHMARK_LOOKUPS  20000
+
+static int hash_map_lookups_per_second(long long ticks) {
+    long long us = TICKS_TO_US(ticks);
+    return us ? (int)(HASH_MAP_BENCHMARK_LOOKUPS * 1000000LL / us) : 0;
+}
+
+static uint32_t hash_map_test_random(uint32_t* state) {
+    *state = *state * 1103515245 + 12345;
+    return *state >> 16;
+}
+
+void test_hash_map_randomized(struct test_context* t) {
+    struct hash_map hash_map;
+    hash_map_init(&hash_map, 8);
+
+    // a flat array indexed by key is the reference map
+    static void* reference[HASH_MAP_TEST_KEY_RANGE];
+    int reference_count = 0;
+    uint32_t seed = 3;
+
+    for (int i = 0; i < HASH_MAP_TEST_KEY_RANGE; i += 1) {
+        reference[i] = NULL;
+    }
+
+    for (int i = 0; i < HASH_MAP_TEST_ITERATIONS; i += 1) {
+        int key = 1 + hash_map_test_random(&seed) % (HASH_MAP_TEST_KEY_RANGE - 1);
+        int action = hash_map_test_random(&seed) % 3;
+
+        if (action == 0) {
+            void* value = (void*)(intptr_t)(i + 1);
+
+            if (!reference[key]) {
+                reference_count += 1;
+            }
+
+            reference[key] = value;
+            hash_map_set(&hash_map, key, value);
+        } else if (action == 1) {
+            if (reference[key]) {
+                reference_count -= 1;
+            }
+
+            reference[key] = NULL;
+            hash_map_delete(&hash_map, key);
+        }
+
+        test_eqi(t, (int)(intptr_t)reference[key], (int)(intptr_t)hash_map_get(&hash_map, key));
+        test_eqi(t, reference_count, hash_map.count);
+    }
+
+    for (int key = 1; key < HASH_MAP_TEST_KEY_RANGE; key += 1) {
+        test_eqi(t, (int)(intptr_t)reference[key], (int)(intptr_t)hash_map_get(&hash_map, key));
+    }
+
+    test_eqi(t, true, hash_map.max_probe_length <= 16);
+
+    // reserving room keeps every entry
+    hash_map_reserve(&hash_map, HASH_MAP_TEST_KEY_RANGE * 2);
+    test_eqi(t, true, hash_map.capacity >= HASH_MAP_TEST_KEY_RANGE * 2);
+
+    for (int key = 1; key < HASH_MAP_TEST_KEY_RANGE; key += 1) {
+        test_eqi(t, (int)(intptr_t)reference[key], (int)(intptr_t)hash_map_get(&hash_map, key));
+    }
+
+    hash_map_destroy(&hash_map);
+}
+
+void test_hash_map_benchmark(struct test_context* t) {
+    struct hash_map hash_map;
+    hash_map_init(&hash_map, HASH_MAP_BENCHMARK_COUNT);
+
+    // entity ids are handed out sequentially
+    for (int key = 1; key <= HASH_MAP_BENCHMARK_COUNT; key += 1) {
+        hash_map_set(&hash_map, key, (void*)(intptr_t)key);
+    }
+
+    int found = 0;
+    long long start = timer_ticks();
+
+    for (int i = 0; i < HASH_MAP_BENCHMARK_LOOKUPS; i += 1) {
+        found += hash_map_get(&hash_map, 1 + i % HASH_MAP_BENCHMARK_COUNT) != NULL;
+    }
+
+    long long hit_ticks = timer_ticks() - start;
+    start = timer_ticks();
+
+    for (int i = 0; i < HASH_MAP_BENCHMARK_LOOKUPS; i += 1) {
+        found += hash_map_get(&hash_map, HASH_MAP_BENCHMARK_COUNT + 1 + i) != NULL;
+    }
+
+    long long miss_ticks = timer_ticks() - start;
+
+    test_eqi(t, HASH_MAP_BENCHMARK_LOOKUPS, found);
+
+    fprintf(
+        stderr,
+        "hash_map lookups per second: hit %d miss %d max probe %d\n",
+        hash_map_lookups_per_second(hit_ticks),
+        hash_map_lookups_per_second(miss_ticks),
+        hash_map.max_probe_length
+    );
+
+    hash_map_destroy(&hash_map);
+}
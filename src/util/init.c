@@ -1,6 +1,7 @@
 #include "init.h"
 
 #include "../spell/assets.h"
+#include "../spell/projectile_manager.h"
 #include "../menu/menu_common.h"
 #include "../render/render_scene.h"
 #include "../time/time.h"
@@ -10,6 +11,7 @@
 #include "../menu/menu_rendering.h"
 #include "../objects/collectable.h"
 #include "../menu/dialog_box.h"
+#include "../menu/profile_overlay.h"
 #include "../cutscene/cutscene_runner.h"
 
 void init_engine() {
@@ -18,10 +20,14 @@ void init_engine() {
     render_scene_reset();
     update_reset();
     collision_scene_reset();
+    projectile_manager_reset();
     health_reset();
     interactable_reset();
     menu_reset();
     collectable_assets_load();
     dialog_box_init();
     cutscene_runner_init();
+#ifdef FRAME_PROFILE
+    profile_overlay_init();
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "memory_tag.h"
+
+#include <libdragon.h>
+#include <malloc.h>
+#include <assert.h>
+#include <stdio.h>
+
+#define MEMORY_TAG_MAGIC            0x4D54
+#define MEMORY_TAG_REPORT_INTERVAL  600
+
+#define LARGEST_BLOCK_GRANULARITY   1024
+
+// keeps the allocation 8 byte aligned
+struct memory_tag_header {
+    uint16_t magic;
+    uint16_t tag;
+    uint32_t size;
+};
+
+static struct memory_tag_stats g_memory_tag_stats[MEMORY_TAG_COUNT];
+
+static const char* g_memory_tag_names[MEMORY_TAG_COUNT] = {
+    [MEMORY_TAG_COLLISION] = "collision",
+    [MEMORY_TAG_CALLBACKS] = "callbacks",
+    [MEMORY_TAG_RESOURCES] = "resources",
+    [MEMORY_TAG_WORLD] = "world",
+    [MEMORY_TAG_MESH] = "mesh",
+    [MEMORY_TAG_MATERIAL] = "material",
+    [MEMORY_TAG_ANIMATION] = "animation",
+    [MEMORY_TAG_CUTSCENE] = "cutscene",
+    [MEMORY_TAG_COMPONENTS] = "components",
+    [MEMORY_TAG_SPELLS] = "spells",
+};
+
+static void memory_tag_add(enum memory_tag tag, int bytes) {
+    struct memory_tag_stats* stats = &g_memory_tag_stats[tag];
+    stats->current_bytes += bytes;
+
+    if (stats->current_bytes > stats->peak_bytes) {
+        stats->peak_bytes = stats->current_bytes;
+    }
+}
+
+void* tagged_malloc(enum memory_tag tag, int bytes) {
+    assert(tag < MEMORY_TAG_COUNT);
+    struct memory_tag_header* header = malloc(sizeof(struct memory_tag_header) + bytes);
+
+    if (!header) {
+        return NULL;
+    }
+
+    header->magic = MEMORY_TAG_MAGIC;
+    header->tag = tag;
+    header->size = bytes;
+
+    memory_tag_add(tag, bytes);
+    g_memory_tag_stats[tag].allocation_count += 1;
+    g_memory_tag_stats[tag].live_count += 1;
+
+    return header + 1;
+}
+
+void* tagged_realloc(enum memory_tag tag, void* memory, int bytes) {
+    assert(tag < MEMORY_TAG_COUNT);
+    struct memory_tag_header* header = NULL;
+    int previous_size = 0;
+
+    if (memory) {
+        header = (struct memory_tag_header*)memory - 1;
+        assert(header->magic == MEMORY_TAG_MAGIC);
+        assert(header->tag == tag);
+        previous_size = header->size;
+    }
+
+    header = realloc(header, sizeof(struct memory_tag_header) + bytes);
+
+    if (!header) {
+        return NULL;
+    }
+
+    if (!memory) {
+        g_memory_tag_stats[tag].allocation_count += 1;
+        g_memory_tag_stats[tag].live_count += 1;
+    }
+
+    header->magic = MEMORY_TAG_MAGIC;
+    header->tag = tag;
+    header->size = bytes;
+    memory_tag_add(tag, bytes - previous_size);
+
+    return header + 1;
+}
+
+void tagged_free(void* memory) {
+    if (!memory) {
+        return;
+    }
+
+    struct memory_tag_header* header = (struct memory_tag_header*)memory - 1;
+    assert(header->magic == MEMORY_TAG_MAGIC);
+
+    struct memory_tag_stats* stats = &g_memory_tag_stats[header->tag];
+    stats->current_bytes -= header->size;
+    stats->live_count -= 1;
+
+    header->magic = 0;
+    free(header);
+}
+
+struct memory_tag_stats* memory_tag_get_stats(enum memory_tag tag) {
+    return &g_memory_tag_stats[tag];
+}
+
+int memory_tag_total_bytes() {
+    int result = 0;
+
+    for (int i = 0; i < MEMORY_TAG_COUNT; i += 1) {
+        result += g_memory_tag_stats[i].current_bytes;
+    }
+
+    return result;
+}
+
+int memory_largest_free_block() {
+    heap_stats_t heap_stats;
+    sys_get_heap_stats(&heap_stats);
+
+    int low = 0;
+    int high = (heap_stats.total - heap_stats.used) / LARGEST_BLOCK_GRANULARITY + 1;
+
+    // binary search for the largest size malloc will accept
+    while (low + 1 < high) {
+        int middle = (low + high) / 2;
+        void* probe = malloc(middle * LARGEST_BLOCK_GRANULARITY);
+
+        if (probe) {
+            free(probe);
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low * LARGEST_BLOCK_GRANULARITY;
+}
+
+void memory_tag_report() {
+    heap_stats_t heap_stats;
+    sys_get_heap_stats(&heap_stats);
+
+    int free_bytes = heap_stats.total - heap_stats.used;
+    int largest_block = memory_largest_free_block();
+    int tagged_bytes = memory_tag_total_bytes();
+
+    fprintf(stderr, "memory: %d/%d bytes used\n", heap_stats.used, heap_stats.total);
+
+    for (int i = 0; i < MEMORY_TAG_COUNT; i += 1) {
+        struct memory_tag_stats* stats = &g_memory_tag_stats[i];
+        fprintf(
+            stderr,
+            "    %-10s %7d bytes %7d peak %5d live %6d total\n",
+            g_memory_tag_names[i],
+            stats->current_bytes,
+            stats->peak_bytes,
+            (int)stats->live_count,
+            (int)stats->allocation_count
+        );
+    }
+
+    fprintf(stderr, "    %-10s %7d bytes\n", "untagged", heap_stats.used - tagged_bytes);
+    fprintf(
+        stderr,
+        "    largest free block %d of %d free bytes (%d%% fragmented)\n",
+        largest_block,
+        free_bytes,
+        free_bytes ? 100 - largest_block * 100 / free_bytes : 0
+    );
+}
+
+#ifdef MEMORY_PROFILE
+static int g_memory_tag_report_frame;
+
+void memory_tag_report_update() {
+    g_memory_tag_report_frame += 1;
+
+    if (g_memory_tag_report_frame < MEMORY_TAG_REPORT_INTERVAL) {
+        return;
+    }
+
+    g_memory_tag_report_frame = 0;
+    memory_tag_report();
+}
+#endif
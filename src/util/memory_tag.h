@@ -0,0 +1,46 @@
+#ifndef __UTIL_MEMORY_TAG_H__
+#define __UTIL_MEMORY_TAG_H__
+
+#include <stdint.h>
+
+enum memory_tag {
+    MEMORY_TAG_COLLISION,
+    MEMORY_TAG_CALLBACKS,
+    MEMORY_TAG_RESOURCES,
+    MEMORY_TAG_WORLD,
+    MEMORY_TAG_MESH,
+    MEMORY_TAG_MATERIAL,
+    MEMORY_TAG_ANIMATION,
+    MEMORY_TAG_CUTSCENE,
+    MEMORY_TAG_COMPONENTS,
+    MEMORY_TAG_SPELLS,
+
+    MEMORY_TAG_COUNT,
+};
+
+struct memory_tag_stats {
+    int current_bytes;
+    int peak_bytes;
+    uint32_t allocation_count;
+    uint32_t live_count;
+};
+
+// heap allocations that keep track of which subsystem owns them
+void* tagged_malloc(enum memory_tag tag, int bytes);
+void* tagged_realloc(enum memory_tag tag, void* memory, int bytes);
+void tagged_free(void* memory);
+
+struct memory_tag_stats* memory_tag_get_stats(enum memory_tag tag);
+int memory_tag_total_bytes();
+
+// probes the heap for the largest allocation that would succeed
+int memory_largest_free_block();
+
+void memory_tag_report();
+
+#ifdef MEMORY_PROFILE
+// called once per frame, prints the report every MEMORY_TAG_REPORT_INTERVAL frames
+void memory_tag_report_update();
+#endif
+
+#endif
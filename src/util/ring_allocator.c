@@ -33,7 +33,7 @@ struct free_block
 #define HEADER_FOOTER_SIZE  (sizeof(struct chunk_header) * 2)
 
 void ring_init_block(void* data_start, bool allocated, uint16_t data_size) {
-    assert(ALIGN_UP((int)data_start) == (int)data_start);
+    assert(ALIGN_UP((intptr_t)data_start) == (intptr_t)data_start);
     assert(ALIGN_UP(data_size) == data_size);
     struct chunk_header* header = GET_HEADER_RAW(data_start, -sizeof(struct chunk_header));
     header->allocated = allocated ? ALLOCATED_BLOCK_ID : FREE_BLOCK_ID;
@@ -45,12 +45,12 @@ void ring_init_block(void* data_start, bool allocated, uint16_t data_size) {
 }
 
 void ring_init_with_buffer(struct ring_allocator* allocator, void* buffer, int buffer_bytes) {
-    void* end = (void*)ALIGN_DOWN((int)((char*)buffer + buffer_bytes));
-    void* actual_start = (void*)ALIGN_UP((int)((char*)buffer));
+    void* end = (void*)ALIGN_DOWN((intptr_t)((char*)buffer + buffer_bytes));
+    void* actual_start = (void*)ALIGN_UP((intptr_t)((char*)buffer));
 
     allocator->buffer = actual_start;
 
-    int memory_size = (int)end - (int)actual_start;
+    int memory_size = (char*)end - (char*)actual_start;
     int capacity = memory_size - ALIGN_UP(HEADER_FOOTER_SIZE) * 2;
 
     ring_init_block((char*)allocator->buffer + ALIGN_UP(HEADER_FOOTER_SIZE), false, ALIGN_UP(capacity));
@@ -174,6 +174,11 @@ void* ring_malloc(struct ring_allocator* allocator, int bytes) {
 
     bytes = ALIGN_UP(bytes);
 
+    // freed blocks need room for the free list links
+    if (bytes < sizeof(struct free_block)) {
+        bytes = sizeof(struct free_block);
+    }
+
     struct free_block* next_free = allocator->next_free;
     struct free_block* start_free = next_free;
     
@@ -5,6 +5,12 @@
 
 bool ring_has_allocated_block(struct ring_allocator* allocator);
 
+// small allocations are rounded up to fit the two free list pointers
+// the block holds once it is freed, that is 8 bytes on the console
+#define RING_SMALL_BLOCK_SIZE   (sizeof(void*) * 2 > 8 ? (int)sizeof(void*) * 2 : 8)
+// plus the header and footer
+#define RING_SMALL_BLOCK_COST   (RING_SMALL_BLOCK_SIZE + 8)
+
 void test_ring_malloc(struct test_context* t) {
     struct ring_allocator allocator;
     ring_init(&allocator, 256);
@@ -12,9 +18,9 @@ void test_ring_malloc(struct test_context* t) {
 
     // basic allocation
     void* first = ring_malloc(&allocator, 8);
-    test_neqi(t, (int)NULL, (int)first);
+    test_neqp(t, NULL, first);
     test_eqi(t, true, ring_has_allocated_block(&allocator));
-    test_eqi(t, 256 - 16, ring_get_free_memory(&allocator));
+    test_eqi(t, 256 - RING_SMALL_BLOCK_COST, ring_get_free_memory(&allocator));
     ring_free(&allocator, first);
     test_eqi(t, false, ring_has_allocated_block(&allocator));
     test_eqi(t, 256, ring_get_free_memory(&allocator));
@@ -23,27 +29,27 @@ void test_ring_malloc(struct test_context* t) {
     // remaining memory is not enough
     // to make a block
     first = ring_malloc(&allocator, 248);
-    test_neqi(t, (int)NULL, (int)first);
+    test_neqp(t, NULL, first);
     test_eqi(t, true, ring_has_allocated_block(&allocator));
     test_eqi(t, 0, ring_get_free_memory(&allocator));
-    test_eqi(t, (int)NULL, (int)allocator.next_free);
-    test_eqi(t, (int)NULL, (int)allocator.last_free);
+    test_eqp(t, NULL, allocator.next_free);
+    test_eqp(t, NULL, allocator.last_free);
     ring_free(&allocator, first);
     test_eqi(t, false, ring_has_allocated_block(&allocator));
     test_eqi(t, 256, ring_get_free_memory(&allocator));
-    test_neqi(t, (int)NULL, (int)allocator.next_free);
-    test_neqi(t, (int)NULL, (int)allocator.last_free);
+    test_neqp(t, NULL, allocator.next_free);
+    test_neqp(t, NULL, allocator.last_free);
 
     first = ring_malloc(&allocator, 8);
     void* second = ring_malloc(&allocator, 8);
-    test_eqi(t, 224, ring_get_free_memory(&allocator));
+    test_eqi(t, 256 - RING_SMALL_BLOCK_COST * 2, ring_get_free_memory(&allocator));
     ring_free(&allocator, first);
     ring_free(&allocator, second);
     test_eqi(t, 256, ring_get_free_memory(&allocator));
 
     first = ring_malloc(&allocator, 8);
     second = ring_malloc(&allocator, 8);
-    test_eqi(t, 224, ring_get_free_memory(&allocator));
+    test_eqi(t, 256 - RING_SMALL_BLOCK_COST * 2, ring_get_free_memory(&allocator));
     ring_free(&allocator, second);
     ring_free(&allocator, first);
     test_eqi(t, 256, ring_get_free_memory(&allocator));
@@ -51,11 +57,11 @@ void test_ring_malloc(struct test_context* t) {
     first = ring_malloc(&allocator, 200);
     second = ring_malloc(&allocator, 8);
     void* third = ring_malloc(&allocator, 8);
-    test_neqi(t, (int)NULL, (int)third);
+    test_neqp(t, NULL, third);
     ring_free(&allocator, first);
-    test_eqi(t, (int)NULL, (int)ring_malloc(&allocator, 256));
+    test_eqp(t, NULL, ring_malloc(&allocator, 256));
     first = ring_malloc(&allocator, 200);
-    test_neqi(t, (int)NULL, (int)first);
+    test_neqp(t, NULL, first);
     ring_free(&allocator, first);
     ring_free(&allocator, second);
     ring_free(&allocator, third);
@@ -0,0 +1,72 @@
+#include "slab_allocator.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#define ALIGN_UP(number)    (((number) + 7) & ~7)
+
+struct slab_free_block {
+    struct slab_free_block* next;
+};
+
+void slab_init_with_buffer(struct slab_allocator* allocator, void* buffer, int block_size, int block_count) {
+    assert(ALIGN_UP((intptr_t)buffer) == (intptr_t)buffer);
+    block_size = ALIGN_UP(block_size);
+    assert(block_size >= sizeof(struct slab_free_block));
+
+    allocator->buffer = buffer;
+    allocator->block_size = block_size;
+    allocator->block_count = block_count;
+    allocator->used_count = 0;
+    allocator->peak_count = 0;
+    allocator->failure_count = 0;
+
+    struct slab_free_block* next = NULL;
+
+    // build the list back to front so blocks are handed out in address order
+    for (int i = block_count - 1; i >= 0; i -= 1) {
+        struct slab_free_block* block = (struct slab_free_block*)(allocator->buffer + block_size * i);
+        block->next = next;
+        next = block;
+    }
+
+    allocator->next_free = next;
+}
+
+void* slab_malloc(struct slab_allocator* allocator) {
+    struct slab_free_block* result = allocator->next_free;
+
+    if (!result) {
+        allocator->failure_count += 1;
+        return NULL;
+    }
+
+    allocator->next_free = result->next;
+    allocator->used_count += 1;
+
+    if (allocator->used_count > allocator->peak_count) {
+        allocator->peak_count = allocator->used_count;
+    }
+
+    return result;
+}
+
+void slab_free(struct slab_allocator* allocator, void* target) {
+    if (!target) {
+        return;
+    }
+
+    assert(slab_contains(allocator, target));
+    assert(((char*)target - allocator->buffer) % allocator->block_size == 0);
+    assert(allocator->used_count > 0);
+
+    struct slab_free_block* block = target;
+    block->next = allocator->next_free;
+    allocator->next_free = block;
+    allocator->used_count -= 1;
+}
+
+bool slab_contains(struct slab_allocator* allocator, void* target) {
+    return (char*)target >= allocator->buffer && 
+        (char*)target < allocator->buffer + allocator->block_size * allocator->block_count;
+}
@@ -0,0 +1,26 @@
+#ifndef __UTIL_SLAB_ALLOCATOR_H__
+#define __UTIL_SLAB_ALLOCATOR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// fixed size blocks threaded through an intrusive free list
+struct slab_allocator {
+    char* buffer;
+    void* next_free;
+    uint16_t block_size;
+    uint16_t block_count;
+    uint16_t used_count;
+    uint16_t peak_count;
+    uint16_t failure_count;
+};
+
+void slab_init_with_buffer(struct slab_allocator* allocator, void* buffer, int block_size, int block_count);
+
+// returns NULL when every block is in use
+void* slab_malloc(struct slab_allocator* allocator);
+void slab_free(struct slab_allocator* allocator, void* target);
+
+bool slab_contains(struct slab_allocator* allocator, void* target);
+
+#endif
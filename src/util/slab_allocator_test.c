@@ -0,0 +1,167 @@
+#include "slab_allocator.h"
+#include "ring_allocator.h"
+#include "../test/framework_test.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <libdragon.h>
+
+#define SLAB_TEST_BLOCK_COUNT       16
+#define SLAB_TEST_BLOCK_SIZE        64
+#define SLAB_CHURN_ITERATIONS       4000
+#define SLAB_BENCHMARK_ITERATIONS   10000
+
+static uint64_t slab_test_buffer[SLAB_TEST_BLOCK_COUNT * SLAB_TEST_BLOCK_SIZE / sizeof(uint64_t)];
+
+static uint32_t slab_test_random(uint32_t* state) {
+    *state = *state * 1103515245 + 12345;
+    return *state >> 16;
+}
+
+void test_slab_malloc(struct test_context* t) {
+    struct slab_allocator allocator;
+    slab_init_with_buffer(&allocator, slab_test_buffer, SLAB_TEST_BLOCK_SIZE, SLAB_TEST_BLOCK_COUNT);
+
+    void* blocks[SLAB_TEST_BLOCK_COUNT];
+
+    for (int i = 0; i < SLAB_TEST_BLOCK_COUNT; i += 1) {
+        blocks[i] = slab_malloc(&allocator);
+        test_neqp(t, NULL, blocks[i]);
+        test_eqi(t, true, slab_contains(&allocator, blocks[i]));
+    }
+
+    test_eqp(t, NULL, slab_malloc(&allocator));
+    test_eqi(t, 1, allocator.failure_count);
+    test_eqi(t, SLAB_TEST_BLOCK_COUNT, allocator.peak_count);
+
+    // most recently freed block is reused first
+    slab_free(&allocator, blocks[3]);
+    test_eqp(t, blocks[3], slab_malloc(&allocator));
+
+    for (int i = 0; i < SLAB_TEST_BLOCK_COUNT; i += 1) {
+        slab_free(&allocator, blocks[i]);
+    }
+
+    test_eqi(t, 0, allocator.used_count);
+    test_eqi(t, false, slab_contains(&allocator, &allocator));
+}
+
+void test_slab_fragmentation(struct test_context* t) {
+    struct slab_allocator allocator;
+    slab_init_with_buffer(&allocator, slab_test_buffer, SLAB_TEST_BLOCK_SIZE, SLAB_TEST_BLOCK_COUNT);
+
+    void* blocks[SLAB_TEST_BLOCK_COUNT] = {0};
+    uint32_t seed = 7;
+
+    // random lifetimes, the pool should never fail while below capacity
+    for (int i = 0; i < SLAB_CHURN_ITERATIONS; i += 1) {
+        int index = slab_test_random(&seed) % SLAB_TEST_BLOCK_COUNT;
+
+        if (blocks[index]) {
+            slab_free(&allocator, blocks[index]);
+            blocks[index] = NULL;
+        } else {
+            blocks[index] = slab_malloc(&allocator);
+            test_neqp(t, NULL, blocks[index]);
+        }
+    }
+
+    for (int i = 0; i < SLAB_TEST_BLOCK_COUNT; i += 1) {
+        slab_free(&allocator, blocks[i]);
+        blocks[i] = NULL;
+    }
+
+    test_eqi(t, 0, allocator.failure_count);
+
+    // after the churn every block is still available
+    for (int i = 0; i < SLAB_TEST_BLOCK_COUNT; i += 1) {
+        test_neqp(t, NULL, slab_malloc(&allocator));
+    }
+
+    // the same churn with mixed sizes through the ring allocator
+    // has to coalesce back into a single free block
+    struct ring_allocator ring;
+    ring_init(&ring, sizeof(slab_test_buffer));
+
+    for (int i = 0; i < SLAB_CHURN_ITERATIONS; i += 1) {
+        int index = slab_test_random(&seed) % SLAB_TEST_BLOCK_COUNT;
+
+        if (blocks[index]) {
+            ring_free(&ring, blocks[index]);
+            blocks[index] = NULL;
+        } else {
+            blocks[index] = ring_malloc(&ring, 8 + (slab_test_random(&seed) % 5) * 8);
+        }
+    }
+
+    for (int i = 0; i < SLAB_TEST_BLOCK_COUNT; i += 1) {
+        ring_free(&ring, blocks[i]);
+    }
+
+    test_eqi(t, sizeof(slab_test_buffer), ring_get_free_memory(&ring));
+    ring_destroy(&ring);
+}
+
+void test_slab_benchmark(struct test_context* t) {
+    struct slab_allocator allocator;
+    slab_init_with_buffer(&allocator, slab_test_buffer, SLAB_TEST_BLOCK_SIZE, SLAB_TEST_BLOCK_COUNT);
+
+    struct ring_allocator ring;
+    ring_init(&ring, sizeof(slab_test_buffer));
+
+    void* blocks[SLAB_TEST_BLOCK_COUNT] = {0};
+    uint32_t seed = 11;
+
+    long long start = timer_ticks();
+
+    for (int i = 0; i < SLAB_BENCHMARK_ITERATIONS; i += 1) {
+        int index = slab_test_random(&seed) % SLAB_TEST_BLOCK_COUNT;
+
+        if (blocks[index]) {
+            slab_free(&allocator, blocks[index]);
+            blocks[index] = NULL;
+        } else {
+            blocks[index] = slab_malloc(&allocator);
+        }
+    }
+
+    long long slab_ticks = timer_ticks() - start;
+
+    for (int i = 0; i < SLAB_TEST_BLOCK_COUNT; i += 1) {
+        slab_free(&allocator, blocks[i]);
+        blocks[i] = NULL;
+    }
+
+    seed = 11;
+    start = timer_ticks();
+
+    for (int i = 0; i < SLAB_BENCHMARK_ITERATIONS; i += 1) {
+        int index = slab_test_random(&seed) % SLAB_TEST_BLOCK_COUNT;
+
+        if (blocks[index]) {
+            ring_free(&ring, blocks[index]);
+            blocks[index] = NULL;
+        } else {
+            blocks[index] = ring_malloc(&ring, SLAB_TEST_BLOCK_SIZE - 16);
+        }
+    }
+
+    long long ring_ticks = timer_ticks() - start;
+
+    for (int i = 0; i < SLAB_TEST_BLOCK_COUNT; i += 1) {
+        ring_free(&ring, blocks[i]);
+    }
+
+    ring_destroy(&ring);
+
+    test_eqi(t, 0, allocator.failure_count);
+
+    fprintf(
+        stderr,
+        "%d alloc/free: slab %dus ring %dus\n",
+        SLAB_BENCHMARK_ITERATIONS,
+        (int)TICKS_TO_US(slab_ticks),
+        (int)TICKS_TO_US(ring_ticks)
+    );
+}
@@ -0,0 +1,195 @@
+import sys
+import os
+import re
+import io
+import argparse
+
+# must match enum asset_type in src/resource/asset_manifest.h
+asset_types = [
+    ('ASSET_TYPE_SPRITE', '.sprite'),
+    ('ASSET_TYPE_TMESH', '.tmesh'),
+    ('ASSET_TYPE_MATERIAL', '.mat'),
+    ('ASSET_TYPE_FONT', '.font64'),
+    ('ASSET_TYPE_ANIMATION', '.anim'),
+    ('ASSET_TYPE_OTHER', None),
+]
+
+# keys per bucket, lower values make the displacement search faster
+# at the cost of a larger displacement table
+BUCKET_SIZE = 4
+
+def asset_type_index(path: str) -> int:
+    for index, asset_type in enumerate(asset_types):
+        if asset_type[1] and path.endswith(asset_type[1]):
+            return index
+
+    return len(asset_types) - 1
+
+# must match asset_manifest_hash in src/resource/asset_manifest_lookup.c
+def asset_hash(seed: int, path: str) -> int:
+    hash = (2166136261 ^ seed) & 0xFFFFFFFF
+
+    for byte in path.encode():
+        hash ^= byte
+        hash = (hash * 16777619) & 0xFFFFFFFF
+
+    # the seed only touches the low bits so mix them into the
+    # rest of the hash, without this small tables can't be solved
+    hash ^= hash >> 16
+    hash = (hash * 0x85EBCA6B) & 0xFFFFFFFF
+    hash ^= hash >> 13
+    hash = (hash * 0xC2B2AE35) & 0xFFFFFFFF
+    hash ^= hash >> 16
+
+    return hash
+
+def build_perfect_hash(paths: list[str]) -> tuple[list[int], list[int]]:
+    """hash and displace, every path is put into a bucket using seed 0
+    then each bucket, largest first, searches for a seed that puts all of 
+    its paths into unused slots"""
+    slot_count = len(paths)
+    bucket_count = max(1, (slot_count + BUCKET_SIZE - 1) // BUCKET_SIZE)
+
+    buckets: list[list[int]] = [[] for _ in range(bucket_count)]
+
+    for index, path in enumerate(paths):
+        buckets[asset_hash(0, path) % bucket_count].append(index)
+
+    displacements = [0] * bucket_count
+    slots = [-1] * slot_count
+
+    for bucket_index in sorted(range(bucket_count), key=lambda x: -len(buckets[x])):
+        bucket = buckets[bucket_index]
+
+        if len(bucket) == 0:
+            continue
+
+        seed = 1
+
+        while True:
+            if seed > 0xFFFF:
+                raise Exception('could not build perfect hash for asset manifest')
+
+            bucket_slots = [asset_hash(seed, paths[index]) % slot_count for index in bucket]
+
+            if len(set(bucket_slots)) == len(bucket_slots) and all(slots[slot] == -1 for slot in bucket_slots):
+                break
+
+            seed += 1
+
+        displacements[bucket_index] = seed
+
+        for slot, index in zip(bucket_slots, bucket):
+            slots[slot] = index
+
+    return displacements, slots
+
+def find_assets(filesystem_dir: str) -> list[str]:
+    result = []
+
+    for root, dirs, files in os.walk(filesystem_dir):
+        for file in files:
+            relative = os.path.relpath(os.path.join(root, file), filesystem_dir)
+            result.append('rom:/' + relative.replace(os.sep, '/'))
+
+    # assets of the same type get contiguous ids
+    return sorted(result, key=lambda path: (asset_type_index(path), path))
+
+def write_manifest(file, paths: list[str]):
+    displacements, slots = build_perfect_hash(paths) if len(paths) else ([0], [])
+
+    file.write('#include "asset_manifest.h"\n')
+    file.write('\n')
+    file.write('// generated by tools/asset_manifest.py\n')
+    file.write('\n')
+    file.write(f'const uint16_t asset_manifest_count = {len(paths)};\n')
+    file.write('\n')
+    file.write('const char* const asset_manifest_paths[] = {\n')
+
+    for path in paths:
+        file.write(f'    "{path}",\n')
+
+    file.write('};\n')
+    file.write('\n')
+    file.write('const struct asset_range asset_manifest_ranges[ASSET_TYPE_COUNT] = {\n')
+
+    for type_index, asset_type in enumerate(asset_types):
+        ids = [index for index, path in enumerate(paths) if asset_type_index(path) == type_index]
+        first = ids[0] if len(ids) else 0
+        file.write(f'    [{asset_type[0]}] = {{ .first = {first}, .count = {len(ids)} }},\n')
+
+    file.write('};\n')
+    file.write('\n')
+    file.write(f'const uint16_t asset_manifest_bucket_count = {len(displacements)};\n')
+    file.write('\n')
+    file.write('const uint16_t asset_manifest_displacements[] = {\n')
+
+    for displacement in displacements:
+        file.write(f'    {displacement},\n')
+
+    file.write('};\n')
+    file.write('\n')
+    file.write('const asset_id asset_manifest_slots[] = {\n')
+
+    for slot in slots:
+        file.write(f'    {slot},\n')
+
+    file.write('};\n')
+
+def asset_id_name(path: str) -> str:
+    return 'ASSET_ID_' + re.sub(r'[^A-Z0-9]', '_', path.removeprefix('rom:/').upper())
+
+def write_ids(file, paths: list[str]):
+    file.write('#ifndef __RESOURCE_ASSET_IDS_H__\n')
+    file.write('#define __RESOURCE_ASSET_IDS_H__\n')
+    file.write('\n')
+    file.write('// generated by tools/asset_manifest.py\n')
+    file.write('\n')
+
+    names = set()
+
+    for index, path in enumerate(paths):
+        name = asset_id_name(path)
+
+        if name in names:
+            raise Exception(f'{path} has the same asset id name as another asset')
+
+        names.add(name)
+        file.write(f'#define {name} {index}\n')
+
+    file.write('\n')
+    file.write('#endif\n')
+
+def write_if_changed(filename: str, writer, paths: list[str]):
+    """the ids header is included by most of the game so it is only
+    touched when an asset is added or removed"""
+    output = io.StringIO()
+    writer(output, paths)
+    contents = output.getvalue()
+
+    if os.path.exists(filename):
+        with open(filename, 'r') as file:
+            if file.read() == contents:
+                return
+
+    with open(filename, 'w') as file:
+        file.write(contents)
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        prog='Asset Manifest',
+        description='Assigns an id to every file in the rom filesystem'
+    )
+
+    parser.add_argument('filesystem')
+    parser.add_argument('output')
+    parser.add_argument('ids_output')
+
+    args = parser.parse_args()
+
+    paths = find_assets(args.filesystem)
+
+    with open(args.output, 'w') as file:
+        write_manifest(file, paths)
+
+    write_if_changed(args.ids_output, write_ids, paths)
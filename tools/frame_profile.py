@@ -0,0 +1,119 @@
+import sys
+import argparse
+
+# reads the frame history written by frame_profile_dump in
+# src/time/frame_profile.c out of a debug log and summarizes it
+#
+#   python3 tools/frame_profile.py isviewer.log
+#   python3 tools/frame_profile.py --csv frames.csv isviewer.log
+
+PREFIX = 'frame_profile '
+
+class FrameProfileDump:
+    def __init__(self, ticks_per_second: int, rdp_clock: int):
+        self.ticks_per_second = ticks_per_second
+        self.rdp_clock = rdp_clock
+        self.columns: list[str] = []
+        # how deep each zone is nested, only set for zone columns
+        self.depths: dict[str, int] = {}
+        self.frames: list[list[int]] = []
+
+    def column_ms(self, column: str, value: int) -> float:
+        if column.startswith('rdp_'):
+            return value * 1000 / self.rdp_clock
+
+        return value * 1000 / self.ticks_per_second
+
+def parse_dumps(lines) -> list[FrameProfileDump]:
+    dumps: list[FrameProfileDump] = []
+    current: FrameProfileDump | None = None
+
+    for line in lines:
+        # the log may have other output mixed in on the same line
+        start = line.find(PREFIX)
+
+        if start == -1:
+            continue
+
+        parts = line[start + len(PREFIX):].split()
+
+        if not parts:
+            continue
+
+        if parts[0] == 'begin':
+            current = FrameProfileDump(int(parts[2]), int(parts[3]))
+        elif current is None:
+            continue
+        elif parts[0] == 'columns':
+            for column in parts[1:]:
+                if ':' in column:
+                    name, depth = column.split(':')
+                    current.depths[name] = int(depth)
+                    column = name
+
+                current.columns.append(column)
+        elif parts[0] == 'f':
+            values = [int(value) for value in parts[1:]]
+
+            if len(values) == len(current.columns):
+                current.frames.append(values)
+        elif parts[0] == 'end':
+            dumps.append(current)
+            current = None
+
+    return dumps
+
+def percentile(values: list[int], fraction: float) -> int:
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+def print_report(dump: FrameProfileDump):
+    print(f'{len(dump.frames)} frames')
+    print(f'{"zone":<24} {"avg":>8} {"p95":>8} {"max":>8}')
+
+    for index, column in enumerate(dump.columns):
+        values = [frame[index] for frame in dump.frames]
+
+        if column in ('frame_pool', 'frame_pool_capacity', 'heap', 'heap_total'):
+            print(f'{column:<24} {sum(values) // len(values) // 1024:>7}K {percentile(values, 0.95) // 1024:>7}K {max(values) // 1024:>7}K')
+            continue
+
+        name = '  ' * (dump.depths.get(column, -1) + 1) + column
+        average = dump.column_ms(column, sum(values) / len(values))
+        p95 = dump.column_ms(column, percentile(values, 0.95))
+        worst = dump.column_ms(column, max(values))
+        print(f'{name:<24} {average:>6.2f}ms {p95:>6.2f}ms {worst:>6.2f}ms')
+
+def write_csv(dump: FrameProfileDump, filename: str):
+    with open(filename, 'w') as file:
+        file.write(','.join(dump.columns) + '\n')
+
+        for frame in dump.frames:
+            file.write(','.join(str(value) for value in frame) + '\n')
+
+def main():
+    parser = argparse.ArgumentParser(description='summarize frame profiler dumps from a debug log')
+    parser.add_argument('log', nargs='?', help='log file to read, defaults to stdin')
+    parser.add_argument('--all', action='store_true', help='report every dump instead of just the last one')
+    parser.add_argument('--csv', help='write the frames of the last dump to a csv file')
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, errors='replace') as file:
+            dumps = parse_dumps(file)
+    else:
+        dumps = parse_dumps(sys.stdin)
+
+    dumps = [dump for dump in dumps if dump.frames]
+
+    if not dumps:
+        print('no frame_profile dumps found', file=sys.stderr)
+        sys.exit(1)
+
+    for dump in (dumps if args.all else dumps[-1:]):
+        print_report(dump)
+
+    if args.csv:
+        write_csv(dumps[-1], args.csv)
+
+main()
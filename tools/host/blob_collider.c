@@ -0,0 +1,217 @@
+#include "blob_collider.h"
+
+#include "util/memory_tag.h"
+
+#include <libdragon.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+
+// WRLD
+#define EXPECTED_HEADER     0x57524C44
+#define WORLD_VERSION       4
+#define WORLD_HEADER_SIZE   20
+
+// offsets of struct mesh_collider in the blob
+#define COLLIDER_VERTICES       0
+#define COLLIDER_TRIANGLES      4
+#define COLLIDER_TRIANGLE_COUNT 8
+#define COLLIDER_INDEX_MIN      12
+#define COLLIDER_INDEX_STRIDE   24
+#define COLLIDER_BLOCK_COUNT    36
+#define COLLIDER_BLOCKS         40
+#define COLLIDER_INDEX_INDICES  44
+
+uint16_t blob_read_u16(const uint8_t* blob, uint32_t offset) {
+    return (blob[offset] << 8) | blob[offset + 1];
+}
+
+uint32_t blob_read_u32(const uint8_t* blob, uint32_t offset) {
+    return ((uint32_t)blob[offset] << 24) | (blob[offset + 1] << 16) | (blob[offset + 2] << 8) | blob[offset + 3];
+}
+
+float blob_read_f32(const uint8_t* blob, uint32_t offset) {
+    uint32_t bits = blob_read_u32(blob, offset);
+    float result;
+    memcpy(&result, &bits, sizeof(float));
+    return result;
+}
+
+void blob_read_vector3(const uint8_t* blob, uint32_t offset, struct Vector3* out) {
+    out->x = blob_read_f32(blob, offset);
+    out->y = blob_read_f32(blob, offset + 4);
+    out->z = blob_read_f32(blob, offset + 8);
+}
+
+const uint8_t* blob_world_open(const char* filename, uint8_t** file) {
+    // asset_load aborts on a missing file
+    FILE* exists = asset_fopen(filename, NULL);
+
+    if (!exists) {
+        fprintf(stderr, "blob_collider: could not open %s\n", filename);
+        *file = NULL;
+        return NULL;
+    }
+
+    fclose(exists);
+
+    int file_size;
+    *file = asset_load(filename, &file_size);
+
+    if (file_size < WORLD_HEADER_SIZE || blob_read_u32(*file, 0) != EXPECTED_HEADER) {
+        fprintf(stderr, "blob_collider: %s is not a world file\n", filename);
+        free(*file);
+        *file = NULL;
+        return NULL;
+    }
+
+    if (blob_read_u16(*file, 4) != WORLD_VERSION) {
+        fprintf(stderr, "blob_collider: %s has version %d expected %d\n", filename, blob_read_u16(*file, 4), WORLD_VERSION);
+        free(*file);
+        *file = NULL;
+        return NULL;
+    }
+
+    return *file + WORLD_HEADER_SIZE;
+}
+
+struct mesh_collider* blob_collider_decode(const uint8_t* blob) {
+    struct mesh_collider* collider = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct mesh_collider));
+
+    collider->triangle_count = blob_read_u16(blob, COLLIDER_TRIANGLE_COUNT);
+    uint32_t triangles = blob_read_u32(blob, COLLIDER_TRIANGLES);
+
+    collider->triangles = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct mesh_triangle_indices) * collider->triangle_count);
+    int vertex_count = 0;
+
+    for (int i = 0; i < collider->triangle_count; i += 1) {
+        for (int j = 0; j < 3; j += 1) {
+            uint16_t index = blob_read_u16(blob, triangles + (i * 3 + j) * 2);
+            collider->triangles[i].indices[j] = index;
+
+            if (index >= vertex_count) {
+                vertex_count = index + 1;
+            }
+        }
+    }
+
+    uint32_t vertices = blob_read_u32(blob, COLLIDER_VERTICES);
+    collider->vertices = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct Vector3) * vertex_count);
+
+    for (int i = 0; i < vertex_count; i += 1) {
+        blob_read_vector3(blob, vertices + i * 12, &collider->vertices[i]);
+    }
+
+    struct mesh_index* index = &collider->index;
+    blob_read_vector3(blob, COLLIDER_INDEX_MIN, &index->min);
+    blob_read_vector3(blob, COLLIDER_INDEX_STRIDE, &index->stride_inv);
+    index->block_count.x = blob[COLLIDER_BLOCK_COUNT];
+    index->block_count.y = blob[COLLIDER_BLOCK_COUNT + 1];
+    index->block_count.z = blob[COLLIDER_BLOCK_COUNT + 2];
+
+    int block_count = index->block_count.x * index->block_count.y * index->block_count.z;
+    uint32_t blocks = blob_read_u32(blob, COLLIDER_BLOCKS);
+    index->blocks = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct mesh_index_block) * block_count);
+    int index_count = 0;
+
+    for (int i = 0; i < block_count; i += 1) {
+        index->blocks[i].first_index = blob_read_u16(blob, blocks + i * 4);
+        index->blocks[i].last_index = blob_read_u16(blob, blocks + i * 4 + 2);
+
+        if (index->blocks[i].last_index > index_count) {
+            index_count = index->blocks[i].last_index;
+        }
+    }
+
+    uint32_t index_indices = blob_read_u32(blob, COLLIDER_INDEX_INDICES);
+    index->index_indices = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(uint16_t) * (index_count ? index_count : 1));
+
+    for (int i = 0; i < index_count; i += 1) {
+        index->index_indices[i] = blob_read_u16(blob, index_indices + i * 2);
+    }
+
+    return collider;
+}
+
+struct mesh_collider* blob_collider_load(const char* filename) {
+    uint8_t* file;
+    const uint8_t* blob = blob_world_open(filename, &file);
+
+    if (!blob) {
+        return NULL;
+    }
+
+    struct mesh_collider* collider = blob_collider_decode(blob);
+
+    free(file);
+
+    return collider;
+}
+
+void blob_collider_free(struct mesh_collider* collider) {
+    if (!collider) {
+        return;
+    }
+
+    tagged_free(collider->vertices);
+    tagged_free(collider->triangles);
+    tagged_free(collider->index.blocks);
+    tagged_free(collider->index.index_indices);
+    tagged_free(collider);
+}
+
+struct mesh_collider* blob_collider_floor(float half_size, int subdivisions) {
+    struct mesh_collider* collider = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct mesh_collider));
+
+    int vertex_row = subdivisions + 1;
+    collider->vertices = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct Vector3) * vertex_row * vertex_row);
+    collider->triangle_count = subdivisions * subdivisions * 2;
+    collider->triangles = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct mesh_triangle_indices) * collider->triangle_count);
+
+    for (int z = 0; z < vertex_row; z += 1) {
+        for (int x = 0; x < vertex_row; x += 1) {
+            collider->vertices[z * vertex_row + x] = (struct Vector3){
+                half_size * (2.0f * x / subdivisions - 1.0f),
+                0.0f,
+                half_size * (2.0f * z / subdivisions - 1.0f),
+            };
+        }
+    }
+
+    struct mesh_triangle_indices* triangle = collider->triangles;
+
+    for (int z = 0; z < subdivisions; z += 1) {
+        for (int x = 0; x < subdivisions; x += 1) {
+            uint16_t corner = z * vertex_row + x;
+            // wound so the normal points up
+            *triangle++ = (struct mesh_triangle_indices){{corner, corner + vertex_row, corner + 1}};
+            *triangle++ = (struct mesh_triangle_indices){{corner + 1, corner + vertex_row, corner + vertex_row + 1}};
+        }
+    }
+
+    // a single index block that contains every triangle
+    struct mesh_index* index = &collider->index;
+    index->min = (struct Vector3){-half_size, -half_size, -half_size};
+    index->stride_inv = (struct Vector3){0.5f / half_size, 0.5f / half_size, 0.5f / half_size};
+    index->block_count = (struct Vector3u8){1, 1, 1};
+    index->blocks = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(struct mesh_index_block));
+    index->blocks[0].first_index = 0;
+    index->blocks[0].last_index = collider->triangle_count;
+    index->index_indices = tagged_malloc(MEMORY_TAG_COLLISION, sizeof(uint16_t) * collider->triangle_count);
+
+    for (int i = 0; i < collider->triangle_count; i += 1) {
+        index->index_indices[i] = i;
+    }
+
+    return collider;
+}
+
+void blob_collider_bounds(struct mesh_collider* collider, struct Box3D* bounds) {
+    struct mesh_index* index = &collider->index;
+    bounds->min = index->min;
+    bounds->max = (struct Vector3){
+        index->min.x + index->block_count.x / index->stride_inv.x,
+        index->min.y + index->block_count.y / index->stride_inv.y,
+        index->min.z + index->block_count.z / index->stride_inv.z,
+    };
+}
@@ -0,0 +1,29 @@
+#ifndef __HOST_BLOB_COLLIDER_H__
+#define __HOST_BLOB_COLLIDER_H__
+
+#include <stdint.h>
+#include "collision/mesh_collider.h"
+
+// the world blob is big endian with 32 bit pointers so it
+// can't be used in place on the host, this reads just the
+// mesh collider out of a .world file into native structs
+struct mesh_collider* blob_collider_load(const char* filename);
+void blob_collider_free(struct mesh_collider* collider);
+
+// a flat floor for when no worlds have been exported
+struct mesh_collider* blob_collider_floor(float half_size, int subdivisions);
+
+void blob_collider_bounds(struct mesh_collider* collider, struct Box3D* bounds);
+
+// checks the header of a .world file and returns the start of its blob
+// file is set to the allocation that has to be free()'d when done
+const uint8_t* blob_world_open(const char* filename, uint8_t** file);
+struct mesh_collider* blob_collider_decode(const uint8_t* blob);
+
+// pointers in the blob are offsets from the start of the blob
+uint16_t blob_read_u16(const uint8_t* blob, uint32_t offset);
+uint32_t blob_read_u32(const uint8_t* blob, uint32_t offset);
+float blob_read_f32(const uint8_t* blob, uint32_t offset);
+void blob_read_vector3(const uint8_t* blob, uint32_t offset, struct Vector3* out);
+
+#endif
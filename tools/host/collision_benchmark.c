@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <libdragon.h>
+
+#include "blob_collider.h"
+#include "collision/collision_scene.h"
+#include "collision/collision_profile.h"
+#include "time/time.h"
+
+// steps the collision scene against a world collider with a
+// seeded set of random objects so changes to gjk, epa or the
+// broadphase can be compared run to run
+//
+//   build/host/collision_benchmark [--objects N] [--ticks T] [--seed S] [--json out.json] [world.world ...]
+//
+// with no worlds given every world in $HOST_FILESYSTEM/worlds is
+// run, if there aren't any a flat floor is used instead
+
+#define DEFAULT_OBJECTS     32
+#define DEFAULT_TICKS       600
+#define DEFAULT_SEED        1
+#define MAX_WORLDS          64
+
+#define SHAPE_COUNT         5
+
+struct benchmark_object {
+    struct dynamic_object_type type;
+    struct dynamic_object object;
+    struct Vector3 position;
+    struct Vector2 rotation;
+};
+
+struct benchmark_options {
+    int objects;
+    int ticks;
+    uint32_t seed;
+    const char* json;
+    const char* worlds[MAX_WORLDS];
+    int world_count;
+};
+
+static uint32_t g_rng_state;
+
+static uint32_t benchmark_rand() {
+    // xorshift32
+    uint32_t x = g_rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_rng_state = x;
+    return x;
+}
+
+static float benchmark_randf(float min, float max) {
+    return min + (max - min) * ((benchmark_rand() & 0xFFFFFF) / (float)0xFFFFFF);
+}
+
+static void benchmark_random_type(struct dynamic_object_type* type) {
+    memset(type, 0, sizeof(struct dynamic_object_type));
+    float size = benchmark_randf(0.25f, 1.0f);
+
+    switch (benchmark_rand() % SHAPE_COUNT) {
+        case 0:
+            type->minkowsi_sum = dynamic_object_sphere_minkowski_sum;
+            type->bounding_box = dynamic_object_sphere_bounding_box;
+            type->data.sphere.radius = size;
+            break;
+        case 1:
+            type->minkowsi_sum = dynamic_object_box_minkowski_sum;
+            type->bounding_box = dynamic_object_box_bounding_box;
+            type->data.box.half_size = (struct Vector3){size, benchmark_randf(0.25f, 1.0f), size};
+            break;
+        case 2:
+            type->minkowsi_sum = dynamic_object_capsule_minkowski_sum;
+            type->bounding_box = dynamic_object_capsule_bounding_box;
+            type->data.capsule.radius = size * 0.5f;
+            type->data.capsule.inner_half_height = size;
+            break;
+        case 3:
+            type->minkowsi_sum = dynamic_object_cylinder_minkowski_sum;
+            type->bounding_box = dynamic_object_cylinder_bounding_box;
+            type->data.cylinder.radius = size;
+            type->data.cylinder.half_height = benchmark_randf(0.25f, 1.0f);
+            break;
+        default:
+            type->minkowsi_sum = dynamic_object_cone_minkowski_sum;
+            type->bounding_box = dynamic_object_cone_bounding_box;
+            type->data.cone.size = (struct Vector3){size, size * 2.0f, size};
+            break;
+    }
+
+    type->friction = benchmark_randf(0.0f, 0.5f);
+    type->bounce = benchmark_randf(0.0f, 0.5f);
+}
+
+static void benchmark_place_object(struct benchmark_object* object, struct Box3D* bounds) {
+    object->position = (struct Vector3){
+        benchmark_randf(bounds->min.x, bounds->max.x),
+        benchmark_randf((bounds->min.y + bounds->max.y) * 0.5f, bounds->max.y),
+        benchmark_randf(bounds->min.z, bounds->max.z),
+    };
+    object->object.velocity = (struct Vector3){
+        benchmark_randf(-4.0f, 4.0f),
+        benchmark_randf(-2.0f, 2.0f),
+        benchmark_randf(-4.0f, 4.0f),
+    };
+}
+
+static void benchmark_write_histogram(FILE* file, const char* name, uint32_t* histogram) {
+    fprintf(file, "      \"%s\": [", name);
+
+    for (int i = 0; i <= COLLISION_PROFILE_MAX_ITERATIONS; i += 1) {
+        fprintf(file, "%s%d", i ? ", " : "", (int)histogram[i]);
+    }
+
+    fprintf(file, "],\n");
+}
+
+static void benchmark_write_json(FILE* file, const char* world, struct benchmark_options* options, uint64_t total_ticks) {
+    struct collision_profile* profile = &g_collision_profile;
+
+    fprintf(file, "    {\n");
+    fprintf(file, "      \"world\": \"%s\",\n", world);
+    fprintf(file, "      \"objects\": %d,\n", options->objects);
+    fprintf(file, "      \"ticks\": %d,\n", options->ticks);
+    fprintf(file, "      \"seed\": %u,\n", options->seed);
+    fprintf(file, "      \"total_us\": %llu,\n", (unsigned long long)TICKS_TO_US(total_ticks));
+    fprintf(file, "      \"stages_us\": {");
+
+    for (int i = 0; i < COLLISION_STAGE_COUNT; i += 1) {
+        fprintf(file, "%s\"%s\": %llu", i ? ", " : "", collision_stage_names[i], (unsigned long long)TICKS_TO_US(profile->stage_ticks[i]));
+    }
+
+    fprintf(file, "},\n");
+    fprintf(file, "      \"stage_calls\": {");
+
+    for (int i = 0; i < COLLISION_STAGE_COUNT; i += 1) {
+        fprintf(file, "%s\"%s\": %d", i ? ", " : "", collision_stage_names[i], (int)profile->stage_calls[i]);
+    }
+
+    fprintf(file, "},\n");
+    benchmark_write_histogram(file, "gjk_iterations", profile->gjk_iterations);
+    benchmark_write_histogram(file, "epa_iterations", profile->epa_iterations);
+    fprintf(
+        file,
+        "      \"contacts\": {\"total\": %d, \"max\": %d, \"dropped\": %d}\n",
+        (int)profile->contacts,
+        (int)profile->max_contacts,
+        (int)profile->contacts_dropped
+    );
+    fprintf(file, "    }");
+}
+
+static uint64_t benchmark_run(struct mesh_collider* collider, struct benchmark_options* options) {
+    g_rng_state = options->seed ? options->seed : 1;
+
+    collision_scene_reset();
+    collision_scene_use_static_collision(collider);
+
+    struct Box3D bounds;
+    blob_collider_bounds(collider, &bounds);
+
+    struct benchmark_object* objects = malloc(sizeof(struct benchmark_object) * options->objects);
+
+    for (int i = 0; i < options->objects; i += 1) {
+        struct benchmark_object* object = &objects[i];
+        benchmark_random_type(&object->type);
+        object->rotation = gRight2;
+        dynamic_object_init(i + 1, &object->object, &object->type, COLLISION_LAYER_TANGIBLE, &object->position, &object->rotation);
+        benchmark_place_object(object, &bounds);
+        collision_scene_add(&object->object);
+    }
+
+    collision_profile_reset();
+
+    uint64_t total_ticks = 0;
+
+    for (int tick = 0; tick < options->ticks; tick += 1) {
+        uint64_t start = get_ticks();
+        collision_scene_collide();
+        total_ticks += get_ticks() - start;
+
+        // objects that fall out of the world are put back in so
+        // the scene stays just as busy for the whole run
+        for (int i = 0; i < options->objects; i += 1) {
+            if (objects[i].position.y < bounds.min.y) {
+                benchmark_place_object(&objects[i], &bounds);
+            }
+        }
+    }
+
+    for (int i = 0; i < options->objects; i += 1) {
+        collision_scene_remove(&objects[i].object);
+    }
+
+    collision_scene_remove_static_collision(collider);
+    free(objects);
+
+    return total_ticks;
+}
+
+static void benchmark_find_worlds(struct benchmark_options* options) {
+    const char* filesystem = getenv("HOST_FILESYSTEM");
+    char path[256];
+    snprintf(path, sizeof(path), "%s/worlds", filesystem ? filesystem : "filesystem");
+
+    DIR* dir = opendir(path);
+
+    if (!dir) {
+        return;
+    }
+
+    struct dirent* entry;
+
+    while ((entry = readdir(dir)) && options->world_count < MAX_WORLDS) {
+        const char* extension = strrchr(entry->d_name, '.');
+
+        if (!extension || strcmp(extension, ".world") != 0) {
+            continue;
+        }
+
+        char* world = malloc(strlen(entry->d_name) + 16);
+        sprintf(world, "rom:/worlds/%s", entry->d_name);
+        options->worlds[options->world_count++] = world;
+    }
+
+    closedir(dir);
+}
+
+static void benchmark_usage() {
+    fprintf(stderr, "usage: collision_benchmark [--objects N] [--ticks T] [--seed S] [--json out.json] [world.world ...]\n");
+}
+
+int main(int argc, char** argv) {
+    struct benchmark_options options = {
+        .objects = DEFAULT_OBJECTS,
+        .ticks = DEFAULT_TICKS,
+        .seed = DEFAULT_SEED,
+    };
+
+    for (int i = 1; i < argc; i += 1) {
+        if (strcmp(argv[i], "--objects") == 0 && i + 1 < argc) {
+            options.objects = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            options.ticks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options.json = argv[++i];
+        } else if (argv[i][0] == '-') {
+            benchmark_usage();
+            return 1;
+        } else if (options.world_count < MAX_WORLDS) {
+            options.worlds[options.world_count++] = argv[i];
+        }
+    }
+
+    bool scanned = options.world_count == 0;
+
+    if (scanned) {
+        benchmark_find_worlds(&options);
+    }
+
+    // sets fixed_time_step
+    update_reset();
+
+    FILE* json = NULL;
+
+    if (options.json) {
+        json = fopen(options.json, "w");
+
+        if (!json) {
+            fprintf(stderr, "collision_benchmark: could not open %s\n", options.json);
+            return 1;
+        }
+
+        fprintf(json, "{\n  \"runs\": [\n");
+    }
+
+    int run_count = options.world_count ? options.world_count : 1;
+    // runs written to the json so far, worlds that fail to load are skipped
+    int written_count = 0;
+    int failed_count = 0;
+
+    for (int i = 0; i < run_count; i += 1) {
+        const char* world = options.world_count ? options.worlds[i] : "floor";
+        struct mesh_collider* collider = options.world_count ? blob_collider_load(world) : blob_collider_floor(20.0f, 8);
+
+        if (!collider) {
+            fprintf(stderr, "collision_benchmark: skipping %s, it failed to load\n", world);
+            failed_count += 1;
+            continue;
+        }
+
+        uint64_t total_ticks = benchmark_run(collider, &options);
+
+        fprintf(
+            stderr,
+            "%s: %d objects %d ticks %dus/tick\n",
+            world,
+            options.objects,
+            options.ticks,
+            (int)TICKS_TO_US(total_ticks / (options.ticks ? options.ticks : 1))
+        );
+        collision_profile_report();
+
+        if (json) {
+            if (written_count) {
+                fprintf(json, ",\n");
+            }
+
+            benchmark_write_json(json, world, &options, total_ticks);
+            written_count += 1;
+        }
+
+        blob_collider_free(collider);
+    }
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+
+    if (scanned) {
+        for (int i = 0; i < options.world_count; i += 1) {
+            free((char*)options.worlds[i]);
+        }
+    }
+
+    if (failed_count) {
+        fprintf(stderr, "collision_benchmark: %d of %d worlds failed to load\n", failed_count, run_count);
+        return 1;
+    }
+
+    return 0;
+}
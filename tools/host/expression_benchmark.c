@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libdragon.h>
+
+#include "cutscene/expression_evaluate.h"
+
+// evaluates a few expressions shaped like the ones world conditions
+// and cutscene branches compile to and reports instructions per second
+//
+//   build/host/expression_benchmark [--iterations N]
+//
+// the programs are built in host byte order since they never come
+// from a file here
+
+#define DEFAULT_ITERATIONS  2000000
+#define MAX_PROGRAM_BYTES   64
+
+struct benchmark_program {
+    const char* name;
+    uint8_t bytes[MAX_PROGRAM_BYTES];
+    int length;
+};
+
+static void benchmark_op(struct benchmark_program* program, int type) {
+    program->bytes[program->length++] = type;
+}
+
+static void benchmark_data(struct benchmark_program* program, int type, union expression_data data) {
+    benchmark_op(program, type);
+    memcpy(&program->bytes[program->length], &data, sizeof(data));
+    program->length += sizeof(data);
+}
+
+static void benchmark_literal(struct benchmark_program* program, int value) {
+    benchmark_data(program, EXPRESSION_TYPE_LOAD_LITERAL, (union expression_data){ .literal = value });
+}
+
+static void benchmark_local(struct benchmark_program* program, int data_type, int word_offset) {
+    union expression_data data;
+    data.load_variable.data_type = data_type;
+    data.load_variable.word_offset = word_offset;
+    benchmark_data(program, EXPRESSION_TYPE_LOAD_LOCAL, data);
+}
+
+static void benchmark_build_programs(struct benchmark_program* programs) {
+    // not has_key and not door_open
+    struct benchmark_program* condition = &programs[0];
+    condition->name = "condition";
+    benchmark_local(condition, DATA_TYPE_BOOL, 3);
+    benchmark_op(condition, EXPRESSION_TYPE_NOT);
+    benchmark_local(condition, DATA_TYPE_BOOL, 0);
+    benchmark_op(condition, EXPRESSION_TYPE_NOT);
+    benchmark_op(condition, EXPRESSION_TYPE_AND);
+    benchmark_op(condition, EXPRESSION_TYPE_END);
+
+    // coins >= 10 + visits * 2
+    struct benchmark_program* branch = &programs[1];
+    branch->name = "branch";
+    benchmark_literal(branch, 2);
+    benchmark_local(branch, DATA_TYPE_S16, 4);
+    benchmark_op(branch, EXPRESSION_TYPE_MUL);
+    benchmark_literal(branch, 10);
+    benchmark_op(branch, EXPRESSION_TYPE_ADD);
+    benchmark_local(branch, DATA_TYPE_S32, 1);
+    benchmark_op(branch, EXPRESSION_TYPE_GTE);
+    benchmark_op(branch, EXPRESSION_TYPE_END);
+
+    // timer * 0.5 > 1.0
+    struct benchmark_program* timer = &programs[2];
+    timer->name = "float";
+    benchmark_literal(timer, 0x3f800000);
+    benchmark_literal(timer, 0x3f000000);
+    benchmark_local(timer, DATA_TYPE_F32, 3);
+    benchmark_op(timer, EXPRESSION_TYPE_MULF);
+    benchmark_op(timer, EXPRESSION_TYPE_GTF);
+    benchmark_op(timer, EXPRESSION_TYPE_END);
+}
+
+int main(int argc, char** argv) {
+    int iterations = DEFAULT_ITERATIONS;
+
+    for (int i = 1; i < argc; i += 1) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: expression_benchmark [--iterations N]\n");
+            return 1;
+        }
+    }
+
+    struct benchmark_program programs[3];
+    memset(programs, 0, sizeof(programs));
+    benchmark_build_programs(programs);
+
+    struct evaluation_context context;
+    evaluation_context_init(&context, 16);
+    memset(context.local_varaibles, 0, 16);
+    ((int32_t*)context.local_varaibles)[1] = 14;
+    ((int16_t*)context.local_varaibles)[4] = 2;
+    ((float*)context.local_varaibles)[3] = 3.0f;
+
+    for (int i = 0; i < sizeof(programs) / sizeof(*programs); i += 1) {
+        struct benchmark_program* program = &programs[i];
+
+        uint64_t start = get_ticks();
+        struct expression expression;
+        expression_init(&expression, program->bytes);
+        uint64_t translate_ticks = get_ticks() - start;
+
+        // END is dispatched too so it counts
+        int instruction_count = expression_translate(program->bytes, NULL);
+        int checksum = 0;
+
+        start = get_ticks();
+
+        for (int iteration = 0; iteration < iterations; iteration += 1) {
+            expression_evaluate(&context, &expression);
+            checksum += evaluation_context_pop(&context);
+        }
+
+        uint64_t total_ticks = get_ticks() - start;
+        double seconds = (double)total_ticks / TICKS_PER_SECOND;
+        double ops = (double)instruction_count * iterations;
+
+        fprintf(
+            stderr,
+            "%s: %d instructions translated in %dus, %.1f million ops/s result %d\n",
+            program->name,
+            instruction_count,
+            (int)TICKS_TO_US(translate_ticks),
+            seconds > 0.0 ? ops / seconds / 1000000.0 : 0.0,
+            checksum / (iterations ? iterations : 1)
+        );
+
+        expression_destroy(&expression);
+    }
+
+    evaluation_context_destroy(&context);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <libdragon.h>
+
+#include <malloc.h>
+#include <stdarg.h>
+#include <time.h>
+
+// the console's heap size so memory reports read the same
+#define HOST_HEAP_SIZE      (8 * 1024 * 1024)
+#define HOST_ROM_PREFIX     "rom:/"
+
+uint64_t get_ticks(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * TICKS_PER_SECOND + (uint64_t)now.tv_nsec * TICKS_PER_SECOND / 1000000000;
+}
+
+long long timer_ticks(void) {
+    return (long long)get_ticks();
+}
+
+uint64_t get_ticks_ms(void) {
+    return TICKS_TO_MS(get_ticks());
+}
+
+uint64_t get_ticks_us(void) {
+    return TICKS_TO_US(get_ticks());
+}
+
+void sys_get_heap_stats(heap_stats_t* stats) {
+    struct mallinfo2 info = mallinfo2();
+    stats->total = HOST_HEAP_SIZE;
+    stats->used = (int)info.uordblks;
+}
+
+static void host_asset_path(const char* path, char* out, int max_length) {
+    const char* filesystem = getenv("HOST_FILESYSTEM");
+
+    if (!filesystem) {
+        filesystem = "filesystem";
+    }
+
+    if (strncmp(path, HOST_ROM_PREFIX, strlen(HOST_ROM_PREFIX)) == 0) {
+        snprintf(out, max_length, "%s/%s", filesystem, path + strlen(HOST_ROM_PREFIX));
+    } else {
+        snprintf(out, max_length, "%s", path);
+    }
+}
+
+FILE* asset_fopen(const char* path, int* size) {
+    char host_path[256];
+    host_asset_path(path, host_path, sizeof(host_path));
+
+    FILE* file = fopen(host_path, "rb");
+
+    if (file && size) {
+        fseek(file, 0, SEEK_END);
+        *size = (int)ftell(file);
+        fseek(file, 0, SEEK_SET);
+    }
+
+    return file;
+}
+
+void* asset_load(const char* path, int* size) {
+    int file_size;
+    FILE* file = asset_fopen(path, &file_size);
+
+    if (!file) {
+        fprintf(stderr, "asset_load: could not open %s\n", path);
+        abort();
+    }
+
+    void* result = malloc(file_size);
+    fread(result, 1, file_size, file);
+    fclose(file);
+
+    if (size) {
+        *size = file_size;
+    }
+
+    return result;
+}
+
+void data_cache_hit_writeback(volatile const void* addr, unsigned long length) {
+
+}
+
+void data_cache_hit_invalidate(volatile void* addr, unsigned long length) {
+
+}
+
+void data_cache_hit_writeback_invalidate(volatile void* addr, unsigned long length) {
+
+}
+
+void debugf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+void joypad_poll(void) {
+
+}
+
+joypad_inputs_t joypad_get_inputs(joypad_port_t port) {
+    joypad_inputs_t result;
+    memset(&result, 0, sizeof(result));
+    return result;
+}
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <string.h>
+#include <libdragon.h>
+
+#include "test/framework_test.h"
+#include "collision/collision_scene.h"
+#include "cutscene/expression.h"
+#include "util/memory_tag.h"
+#include "host_world.h"
+
+// the tests from main_test.c that don't need a world
+// loaded or anything from the rsp or rdp
+
+void test_mesh_collider_sweep_sphere(struct test_context* t);
+void test_collide_object_swept_to_triangle(struct test_context* t);
+void test_collide_object_to_mesh_swept(struct test_context* t);
+void test_ring_malloc(struct test_context* t);
+void test_arena_malloc(struct test_context* t);
+void test_slab_malloc(struct test_context* t);
+void test_slab_fragmentation(struct test_context* t);
+void test_slab_benchmark(struct test_context* t);
+void test_hash_map_randomized(struct test_context* t);
+void test_hash_map_benchmark(struct test_context* t);
+void test_component_set(struct test_context* t);
+void test_resource_cache_zombies(struct test_context* t);
+void test_input_record_replay(struct test_context* t);
+void test_spell_data_source_pool(struct test_context* t);
+void test_spell_program_compile(struct test_context* t);
+void test_expression_evaluate(struct test_context* t);
+
+#define HOST_WORLD_FILENAME         "rom:/worlds/playerhome_basement.world"
+#define HOST_WORLD_LEAK_ITERATIONS  3
+
+static void fixture_u16(uint8_t* blob, uint32_t offset, uint16_t value) {
+    blob[offset] = value >> 8;
+    blob[offset + 1] = value;
+}
+
+static void fixture_u32(uint8_t* blob, uint32_t offset, uint32_t value) {
+    fixture_u16(blob, offset, value >> 16);
+    fixture_u16(blob, offset + 2, value);
+}
+
+static void fixture_f32(uint8_t* blob, uint32_t offset, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    fixture_u32(blob, offset, bits);
+}
+
+// a single triangle world with one of everything the blob can
+// hold for when the worlds haven't been exported
+static void fixture_world_blob(uint8_t* blob, int size) {
+    memset(blob, 0, size);
+
+    memcpy(blob + 72, "default\0biter\0room", 19);
+
+    // location
+    fixture_u32(blob, 48, 92);
+    fixture_u32(blob, 92, 72);
+    fixture_f32(blob, 96 + 4, 1.0f);
+    fixture_f32(blob, 112, 1.0f);
+
+    // mesh collider
+    fixture_u32(blob, 0, 116);
+    fixture_f32(blob, 116 + 12, 1.0f);
+    fixture_f32(blob, 116 + 32, 1.0f);
+    fixture_u32(blob, 4, 152);
+    fixture_u16(blob, 152, 0);
+    fixture_u16(blob, 154, 1);
+    fixture_u16(blob, 156, 2);
+    fixture_u16(blob, 8, 1);
+    fixture_f32(blob, 24, 0.5f);
+    fixture_f32(blob, 28, 0.5f);
+    fixture_f32(blob, 32, 0.5f);
+    blob[36] = 1;
+    blob[37] = 1;
+    blob[38] = 1;
+    fixture_u32(blob, 40, 160);
+    fixture_u16(blob, 162, 1);
+    fixture_u32(blob, 44, 164);
+
+    // an entity group with one conditional entity
+    fixture_u32(blob, 52, 168);
+    fixture_u32(blob, 168, 80);
+    fixture_u32(blob, 168 + 4, 184);
+    fixture_u32(blob, 168 + 8, 200);
+    fixture_u16(blob, 168 + 12, 2);
+    fixture_u16(blob, 168 + 14, 8);
+    fixture_u16(blob, 200, 0xFFFF);
+    fixture_u16(blob, 202, 0);
+
+    // loading zone
+    fixture_u32(blob, 56, 204);
+    fixture_f32(blob, 204 + 12, 1.0f);
+    fixture_f32(blob, 204 + 16, 1.0f);
+    fixture_f32(blob, 204 + 20, 1.0f);
+    fixture_u32(blob, 204 + 24, 86);
+
+    // a condition that is always true
+    fixture_u32(blob, 60, 232);
+    fixture_u32(blob, 232, 236);
+    blob[236] = EXPRESSION_TYPE_LOAD_LITERAL;
+    blob[240] = 1;
+    blob[241] = EXPRESSION_TYPE_END;
+
+    fixture_u16(blob, 64, 1);
+    fixture_u16(blob, 66, 1);
+    fixture_u16(blob, 68, 1);
+    fixture_u16(blob, 70, 1);
+}
+
+static struct host_world* host_test_world_load(uint8_t* fixture) {
+    return fixture ? host_world_decode(fixture) : host_world_load(HOST_WORLD_FILENAME);
+}
+
+// the host version of test_world_load_leaks in scene/world_loader_test.c
+// a leak makes host_test exit with an error so the build fails
+void test_host_world_leaks(struct test_context* t) {
+    uint8_t fixture_memory[248];
+    uint8_t* fixture = NULL;
+    FILE* file = asset_fopen(HOST_WORLD_FILENAME, NULL);
+
+    if (file) {
+        fclose(file);
+    } else {
+        fprintf(stderr, "%s hasn't been exported, using a fixture world\n", HOST_WORLD_FILENAME);
+        fixture_world_blob(fixture_memory, sizeof(fixture_memory));
+        fixture = fixture_memory;
+    }
+
+    // the first load creates the world arena
+    host_world_release(host_test_world_load(fixture));
+
+    struct memory_tag_stats before[MEMORY_TAG_COUNT];
+
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag += 1) {
+        before[tag] = *memory_tag_get_stats(tag);
+    }
+
+    for (int i = 0; i < HOST_WORLD_LEAK_ITERATIONS; i += 1) {
+        struct host_world* world = host_test_world_load(fixture);
+        test_neqp(t, NULL, world);
+        host_world_release(world);
+    }
+
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag += 1) {
+        struct memory_tag_stats* after = memory_tag_get_stats(tag);
+        test_eqi(t, before[tag].current_bytes, after->current_bytes);
+        test_eqi(t, before[tag].live_count, after->live_count);
+    }
+}
+
+int main() {
+    collision_scene_reset();
+
+    test_run(test_mesh_collider_sweep_sphere);
+
+    test_run(test_collide_object_swept_to_triangle);
+    test_run(test_collide_object_to_mesh_swept);
+
+    test_run(test_ring_malloc);
+    test_run(test_arena_malloc);
+    test_run(test_slab_malloc);
+    test_run(test_slab_fragmentation);
+    test_run(test_slab_benchmark);
+
+    test_run(test_hash_map_randomized);
+    test_run(test_hash_map_benchmark);
+
+    test_run(test_component_set);
+
+    test_run(test_resource_cache_zombies);
+
+    test_run(test_input_record_replay);
+
+    test_run(test_spell_data_source_pool);
+    test_run(test_spell_program_compile);
+    test_run(test_expression_evaluate);
+
+    test_run(test_host_world_leaks);
+
+    return test_report_failures();
+}
@@ -0,0 +1,164 @@
+#include "host_world.h"
+
+#include <libdragon.h>
+#include <malloc.h>
+#include <string.h>
+
+#include "blob_collider.h"
+#include "collision/collision_scene.h"
+#include "cutscene/expression.h"
+#include "scene/world_arena.h"
+#include "util/memory_tag.h"
+
+// offsets of struct world_blob, these match tools/mesh_export/world.py
+#define WORLD_BLOB_LOCATIONS        48
+#define WORLD_BLOB_ENTITY_GROUPS    52
+#define WORLD_BLOB_LOADING_ZONES    56
+#define WORLD_BLOB_CONDITIONS       60
+#define WORLD_BLOB_COUNTS           64
+
+#define WORLD_LOCATION_SIZE         24
+#define WORLD_ENTITY_GROUP_SIZE     16
+#define LOADING_ZONE_SIZE           28
+
+#define WORLD_CONDITION_ALWAYS      0xFFFF
+
+static char* host_world_read_string(const uint8_t* blob, uint32_t offset) {
+    const char* source = (const char*)blob + blob_read_u32(blob, offset);
+    int length = strlen(source) + 1;
+    char* result = world_malloc(length);
+    memcpy(result, source, length);
+    return result;
+}
+
+static void host_world_read_locations(struct host_world* world, const uint8_t* blob) {
+    uint32_t locations = blob_read_u32(blob, WORLD_BLOB_LOCATIONS);
+    world->locations = world_malloc(sizeof(struct host_world_location) * world->location_count);
+
+    for (int i = 0; i < world->location_count; i += 1) {
+        uint32_t at = locations + i * WORLD_LOCATION_SIZE;
+        struct host_world_location* location = &world->locations[i];
+        location->name = host_world_read_string(blob, at);
+        blob_read_vector3(blob, at + 4, &location->position);
+        location->rotation.x = blob_read_f32(blob, at + 16);
+        location->rotation.y = blob_read_f32(blob, at + 20);
+    }
+}
+
+static void host_world_read_entity_groups(struct host_world* world, const uint8_t* blob) {
+    uint32_t groups = blob_read_u32(blob, WORLD_BLOB_ENTITY_GROUPS);
+    world->entity_groups = world_malloc(sizeof(struct host_entity_group) * world->entity_group_count);
+
+    for (int i = 0; i < world->entity_group_count; i += 1) {
+        uint32_t at = groups + i * WORLD_ENTITY_GROUP_SIZE;
+        struct host_entity_group* group = &world->entity_groups[i];
+        group->name = host_world_read_string(blob, at);
+        group->entity_count = blob_read_u16(blob, at + 12);
+        group->definition_size = blob_read_u16(blob, at + 14);
+
+        int definitions_size = group->definition_size * group->entity_count;
+        group->definitions = world_malloc(definitions_size);
+        memcpy(group->definitions, blob + blob_read_u32(blob, at + 4), definitions_size);
+
+        uint32_t condition_indices = blob_read_u32(blob, at + 8);
+        group->conditional_count = 0;
+
+        for (int entity = 0; entity < group->entity_count; entity += 1) {
+            uint16_t condition = blob_read_u16(blob, condition_indices + entity * 2);
+            assert(condition == WORLD_CONDITION_ALWAYS || condition < world->condition_count);
+
+            if (condition != WORLD_CONDITION_ALWAYS) {
+                group->conditional_count += 1;
+            }
+        }
+    }
+}
+
+static void host_world_read_loading_zones(struct host_world* world, const uint8_t* blob) {
+    uint32_t loading_zones = blob_read_u32(blob, WORLD_BLOB_LOADING_ZONES);
+    world->loading_zones = world_malloc(sizeof(struct host_loading_zone) * world->loading_zone_count);
+
+    for (int i = 0; i < world->loading_zone_count; i += 1) {
+        uint32_t at = loading_zones + i * LOADING_ZONE_SIZE;
+        struct host_loading_zone* loading_zone = &world->loading_zones[i];
+        blob_read_vector3(blob, at, &loading_zone->bounding_box.min);
+        blob_read_vector3(blob, at + 12, &loading_zone->bounding_box.max);
+        loading_zone->world_name = host_world_read_string(blob, at + 24);
+    }
+}
+
+static void host_world_check_conditions(struct host_world* world, const uint8_t* blob) {
+    uint32_t conditions = blob_read_u32(blob, WORLD_BLOB_CONDITIONS);
+
+    for (int i = 0; i < world->condition_count; i += 1) {
+        // literals and variable offsets in the program are big endian so
+        // the conditions are only translated here, never evaluated
+        const uint8_t* program = blob + blob_read_u32(blob, conditions + i * 4);
+        struct expression_instruction instructions[expression_translate(program, NULL)];
+        expression_translate(program, instructions);
+    }
+}
+
+struct host_world* host_world_decode(const uint8_t* blob) {
+    struct host_world* world = tagged_malloc(MEMORY_TAG_WORLD, sizeof(struct host_world));
+
+    world->location_count = blob_read_u16(blob, WORLD_BLOB_COUNTS);
+    world->entity_group_count = blob_read_u16(blob, WORLD_BLOB_COUNTS + 2);
+    world->loading_zone_count = blob_read_u16(blob, WORLD_BLOB_COUNTS + 4);
+    world->condition_count = blob_read_u16(blob, WORLD_BLOB_COUNTS + 6);
+
+    world->mesh_collider = blob_collider_decode(blob);
+    collision_scene_use_static_collision(world->mesh_collider);
+
+    host_world_read_locations(world, blob);
+    host_world_check_conditions(world, blob);
+    host_world_read_entity_groups(world, blob);
+    host_world_read_loading_zones(world, blob);
+
+    return world;
+}
+
+struct host_world* host_world_load(const char* filename) {
+    uint8_t* file;
+    const uint8_t* blob = blob_world_open(filename, &file);
+
+    if (!blob) {
+        return NULL;
+    }
+
+    struct host_world* world = host_world_decode(blob);
+
+    free(file);
+
+    return world;
+}
+
+void host_world_release(struct host_world* world) {
+    if (!world) {
+        return;
+    }
+
+    collision_scene_remove_static_collision(world->mesh_collider);
+    // blob_collider_decode is called in host_world_decode
+    blob_collider_free(world->mesh_collider);
+
+    for (int i = 0; i < world->location_count; i += 1) {
+        world_free(world->locations[i].name);
+    }
+    world_free(world->locations);
+
+    for (int i = 0; i < world->entity_group_count; i += 1) {
+        world_free(world->entity_groups[i].name);
+        world_free(world->entity_groups[i].definitions);
+    }
+    world_free(world->entity_groups);
+
+    for (int i = 0; i < world->loading_zone_count; i += 1) {
+        world_free(world->loading_zones[i].world_name);
+    }
+    world_free(world->loading_zones);
+
+    tagged_free(world);
+
+    world_arena_reset();
+}
@@ -0,0 +1,52 @@
+#ifndef __HOST_HOST_WORLD_H__
+#define __HOST_HOST_WORLD_H__
+
+#include <stdint.h>
+#include "collision/mesh_collider.h"
+#include "math/vector2.h"
+
+// scene/world_loader.c needs the renderer, player and every entity
+// type so it can't be built here, this follows the same allocations
+// for the parts of a world that don't need any of those so a load and
+// release cycle can be checked for leaks on the host
+
+struct host_world_location {
+    char* name;
+    struct Vector3 position;
+    struct Vector2 rotation;
+};
+
+struct host_entity_group {
+    char* name;
+    // copied as is, the definitions are still big endian
+    void* definitions;
+    uint16_t entity_count;
+    uint16_t definition_size;
+    // entities that only spawn if a condition passes
+    uint16_t conditional_count;
+};
+
+struct host_loading_zone {
+    struct Box3D bounding_box;
+    char* world_name;
+};
+
+struct host_world {
+    struct mesh_collider* mesh_collider;
+
+    struct host_world_location* locations;
+    struct host_entity_group* entity_groups;
+    struct host_loading_zone* loading_zones;
+
+    uint16_t location_count;
+    uint16_t entity_group_count;
+    uint16_t loading_zone_count;
+    uint16_t condition_count;
+};
+
+struct host_world* host_world_load(const char* filename);
+// blob is the contents of a .world file after the header
+struct host_world* host_world_decode(const uint8_t* blob);
+void host_world_release(struct host_world* world);
+
+#endif
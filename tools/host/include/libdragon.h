@@ -0,0 +1,99 @@
+#ifndef __HOST_LIBDRAGON_H__
+#define __HOST_LIBDRAGON_H__
+
+// the parts of libdragon the engine core uses, implemented
+// on top of libc in host_shim.c
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#define TICKS_PER_SECOND        (93750000 / 2)
+#define TICKS_FROM_MS(val)      ((val) * (TICKS_PER_SECOND / 1000))
+#define TICKS_FROM_US(val)      ((val) * (8 * TICKS_PER_SECOND / 8000000))
+#define TICKS_TO_MS(val)        ((val) / (TICKS_PER_SECOND / 1000))
+#define TICKS_TO_US(val)        (((val) * 8) / (8 * TICKS_PER_SECOND / 1000000))
+#define TIMER_MICROS(tk)        ((int)TICKS_TO_US(tk))
+#define TICKS_READ()            ((uint32_t)get_ticks())
+#define TICKS_DISTANCE(from, to) ((int32_t)((uint32_t)(to) - (uint32_t)(from)))
+
+long long timer_ticks(void);
+uint64_t get_ticks(void);
+uint64_t get_ticks_ms(void);
+uint64_t get_ticks_us(void);
+
+typedef struct {
+    int total;
+    int used;
+} heap_stats_t;
+
+void sys_get_heap_stats(heap_stats_t* stats);
+
+// rom:/ paths are read from HOST_FILESYSTEM, filesystem/ by default
+FILE* asset_fopen(const char* path, int* size);
+void* asset_load(const char* path, int* size);
+
+void data_cache_hit_writeback(volatile const void* addr, unsigned long length);
+void data_cache_hit_invalidate(volatile void* addr, unsigned long length);
+void data_cache_hit_writeback_invalidate(volatile void* addr, unsigned long length);
+
+#define UncachedAddr(addr)      ((void*)(addr))
+#define PhysicalAddr(addr)      ((uint32_t)(uintptr_t)(addr))
+#define MEMORY_BARRIER()        __asm__ volatile ("" : : : "memory")
+
+void debugf(const char* format, ...);
+
+typedef union {
+    uint16_t raw;
+    struct __attribute__((packed)) {
+        unsigned a : 1;
+        unsigned b : 1;
+        unsigned z : 1;
+        unsigned start : 1;
+        unsigned d_up : 1;
+        unsigned d_down : 1;
+        unsigned d_left : 1;
+        unsigned d_right : 1;
+        unsigned y : 1;
+        unsigned x : 1;
+        unsigned l : 1;
+        unsigned r : 1;
+        unsigned c_up : 1;
+        unsigned c_down : 1;
+        unsigned c_left : 1;
+        unsigned c_right : 1;
+    };
+} joypad_buttons_t;
+
+typedef struct {
+    joypad_buttons_t btn;
+    int8_t stick_x;
+    int8_t stick_y;
+    int8_t cstick_x;
+    int8_t cstick_y;
+    uint8_t analog_l;
+    uint8_t analog_r;
+} joypad_inputs_t;
+
+typedef enum {
+    JOYPAD_AXIS_STICK_X,
+    JOYPAD_AXIS_STICK_Y,
+    JOYPAD_AXIS_CSTICK_X,
+    JOYPAD_AXIS_CSTICK_Y,
+    JOYPAD_AXIS_ANALOG_L,
+    JOYPAD_AXIS_ANALOG_R,
+} joypad_axis_t;
+
+typedef int joypad_port_t;
+
+#define JOYPAD_PORT_1   0
+
+// there is no controller on the host, inputs only come from replays
+void joypad_poll(void);
+joypad_inputs_t joypad_get_inputs(joypad_port_t port);
+
+#endif
@@ -0,0 +1 @@
+#include "libdragon.h"
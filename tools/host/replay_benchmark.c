@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libdragon.h>
+
+#include "input/input.h"
+#include "input/input_recording.h"
+#include "input/input_replay.h"
+#include "collision/collision_scene.h"
+#include "time/time.h"
+#include "blob_collider.h"
+#include "host_world.h"
+
+// plays a recording through the collision core without rendering
+// and checks every run ends on the same state hash
+//
+//   build/host/replay_benchmark [--runs N] [--world world.world] recording.replay
+//
+// the world's collider is loaded and a grid of objects is dropped
+// into it, the stick pushes the first object around so the recorded
+// input changes the hashed state. the player, spells and entities
+// aren't part of the host build so this is only a determinism check
+// of the collision core, full sessions replay on the console with
+// make REPLAY=name HEADLESS=1
+
+#define DEFAULT_RUNS        2
+#define DEFAULT_WORLD       "rom:/worlds/playerhome_basement.world"
+
+#define REPLAY_OBJECT_ROW   4
+#define REPLAY_OBJECT_COUNT (REPLAY_OBJECT_ROW * REPLAY_OBJECT_ROW)
+// stick units to meters per second for the object the input drives
+#define REPLAY_STICK_SPEED  (4.0f / 80.0f)
+
+struct replay_object {
+    struct dynamic_object_type type;
+    struct dynamic_object object;
+    struct Vector3 position;
+    struct Vector2 rotation;
+};
+
+static void replay_spawn_objects(struct replay_object* objects, struct mesh_collider* collider) {
+    struct Box3D bounds;
+    blob_collider_bounds(collider, &bounds);
+
+    for (int i = 0; i < REPLAY_OBJECT_COUNT; i += 1) {
+        struct replay_object* object = &objects[i];
+        memset(&object->type, 0, sizeof(struct dynamic_object_type));
+
+        // alternate spheres and boxes so both gjk paths are hit
+        if (i & 1) {
+            object->type.minkowsi_sum = dynamic_object_box_minkowski_sum;
+            object->type.bounding_box = dynamic_object_box_bounding_box;
+            object->type.data.box.half_size = (struct Vector3){0.5f, 0.5f, 0.5f};
+        } else {
+            object->type.minkowsi_sum = dynamic_object_sphere_minkowski_sum;
+            object->type.bounding_box = dynamic_object_sphere_bounding_box;
+            object->type.data.sphere.radius = 0.5f;
+        }
+
+        object->type.friction = 0.2f;
+        object->type.bounce = 0.2f;
+
+        float x = ((i % REPLAY_OBJECT_ROW) + 0.5f) / REPLAY_OBJECT_ROW;
+        float z = ((i / REPLAY_OBJECT_ROW) + 0.5f) / REPLAY_OBJECT_ROW;
+
+        object->position = (struct Vector3){
+            bounds.min.x + (bounds.max.x - bounds.min.x) * x,
+            bounds.max.y,
+            bounds.min.z + (bounds.max.z - bounds.min.z) * z,
+        };
+        object->rotation = gRight2;
+
+        dynamic_object_init(i + 1, &object->object, &object->type, COLLISION_LAYER_TANGIBLE, &object->position, &object->rotation);
+        collision_scene_add(&object->object);
+    }
+}
+
+static uint32_t replay_benchmark_run(const char* filename, const char* world_filename) {
+    struct input_recording* recording = input_recording_load(filename);
+
+    if (!recording) {
+        exit(1);
+    }
+
+    update_reset();
+    update_tick = 0;
+    collision_scene_reset();
+
+    struct host_world* world = host_world_load(world_filename);
+    struct mesh_collider* floor = NULL;
+
+    if (!world) {
+        fprintf(stderr, "replay_benchmark: using a flat floor instead of %s\n", world_filename);
+        floor = blob_collider_floor(20.0f, 8);
+        collision_scene_use_static_collision(floor);
+    }
+
+    struct replay_object objects[REPLAY_OBJECT_COUNT];
+    replay_spawn_objects(objects, world ? world->mesh_collider : floor);
+
+    input_replay_reset();
+    input_replay_start(recording);
+
+    while (input_get_mode() == INPUT_MODE_REPLAY) {
+        uint64_t start = get_ticks();
+        input_poll();
+
+        joypad_inputs_t inputs = input_get_inputs();
+        objects[0].object.velocity.x = inputs.stick_x * REPLAY_STICK_SPEED;
+        objects[0].object.velocity.z = -inputs.stick_y * REPLAY_STICK_SPEED;
+
+        collision_scene_collide();
+        update_dispatch();
+        input_replay_frame(get_ticks() - start);
+    }
+
+    input_replay_report();
+    input_recording_free(recording);
+
+    for (int i = 0; i < REPLAY_OBJECT_COUNT; i += 1) {
+        collision_scene_remove(&objects[i].object);
+    }
+
+    if (world) {
+        host_world_release(world);
+    } else {
+        collision_scene_remove_static_collision(floor);
+        blob_collider_free(floor);
+    }
+
+    return input_replay_get_stats()->state_hash;
+}
+
+int main(int argc, char** argv) {
+    int runs = DEFAULT_RUNS;
+    const char* filename = NULL;
+    const char* world_filename = DEFAULT_WORLD;
+
+    for (int i = 1; i < argc; i += 1) {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--world") == 0 && i + 1 < argc) {
+            world_filename = argv[++i];
+        } else {
+            filename = argv[i];
+        }
+    }
+
+    if (!filename) {
+        fprintf(stderr, "usage: replay_benchmark [--runs N] [--world world.world] recording.replay\n");
+        return 1;
+    }
+
+    uint32_t first_hash = 0;
+
+    for (int run = 0; run < runs; run += 1) {
+        uint32_t hash = replay_benchmark_run(filename, world_filename);
+
+        if (run == 0) {
+            first_hash = hash;
+        } else if (hash != first_hash) {
+            fprintf(stderr, "replay_benchmark: run %d ended with %08x expected %08x\n", run, (unsigned)hash, (unsigned)first_hash);
+            return 1;
+        }
+    }
+
+    return 0;
+}
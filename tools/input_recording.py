@@ -0,0 +1,111 @@
+import sys
+import struct
+import argparse
+
+# pulls a recording written by input_recording_dump in
+# src/input/input_recording.c out of a debug log
+#
+#   python3 tools/input_recording.py isviewer.log assets/replays/boss.replay
+#   python3 tools/input_recording.py --info assets/replays/boss.replay
+
+PREFIX = 'input_recording '
+
+# must match src/input/input_recording.h
+HEADER = b'INPT'
+VERSION = 1
+HEADER_SIZE = 12
+FRAME_SIZE = 8
+TICKS_PER_SECOND = 30
+
+BUTTON_NAMES = [
+    'a', 'b', 'z', 'start', 'd_up', 'd_down', 'd_left', 'd_right',
+    'y', 'x', 'l', 'r', 'c_up', 'c_down', 'c_left', 'c_right',
+]
+
+def extract_recordings(lines) -> list[bytes]:
+    recordings: list[bytes] = []
+    current: bytearray | None = None
+    expected_size = 0
+
+    for line in lines:
+        start = line.find(PREFIX)
+
+        if start == -1:
+            continue
+
+        parts = line[start + len(PREFIX):].split()
+
+        if not parts:
+            continue
+
+        if parts[0] == 'begin':
+            current = bytearray()
+            expected_size = int(parts[1])
+        elif current is None:
+            continue
+        elif parts[0] == 'd' and len(parts) > 1:
+            current.extend(bytes.fromhex(parts[1]))
+        elif parts[0] == 'end':
+            if len(current) == expected_size:
+                recordings.append(bytes(current))
+            else:
+                print(f'skipping a recording with {len(current)} bytes, expected {expected_size}', file=sys.stderr)
+
+            current = None
+
+    return recordings
+
+def print_info(data: bytes):
+    if data[0:4] != HEADER:
+        raise Exception('not an input recording')
+
+    version, _, tick_count = struct.unpack('>HHI', data[4:HEADER_SIZE])
+
+    if version != VERSION:
+        raise Exception(f'expected version {VERSION} got {version}')
+
+    presses = [0] * len(BUTTON_NAMES)
+    previous = 0
+
+    for tick in range(tick_count):
+        buttons, _, _, _ = struct.unpack('>HbbI', data[HEADER_SIZE + tick * FRAME_SIZE:HEADER_SIZE + (tick + 1) * FRAME_SIZE])
+
+        for bit in range(len(BUTTON_NAMES)):
+            if buttons & ~previous & (1 << bit):
+                presses[bit] += 1
+
+        previous = buttons
+
+    print(f'{tick_count} ticks ({tick_count / TICKS_PER_SECOND:.1f} seconds)')
+
+    for name, count in zip(BUTTON_NAMES, presses):
+        if count:
+            print(f'    {name:<8} pressed {count} times')
+
+def main():
+    parser = argparse.ArgumentParser(description='extract input recordings from a debug log')
+    parser.add_argument('input', help='debug log to read or a .replay file with --info')
+    parser.add_argument('output', nargs='?', help='where to write the last recording in the log')
+    parser.add_argument('--info', action='store_true', help='print a summary of a .replay file')
+    args = parser.parse_args()
+
+    if args.info:
+        with open(args.input, 'rb') as file:
+            print_info(file.read())
+        return
+
+    with open(args.input, errors='replace') as file:
+        recordings = extract_recordings(file)
+
+    if not recordings:
+        print('no input recordings found', file=sys.stderr)
+        sys.exit(1)
+
+    if not args.output:
+        print_info(recordings[-1])
+        return
+
+    with open(args.output, 'wb') as file:
+        file.write(recordings[-1])
+
+main()
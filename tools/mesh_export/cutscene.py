@@ -4,6 +4,7 @@ import cutscene.tokenizer
 import cutscene.parser
 import cutscene.variable_layout
 import cutscene.step_generator
+import cutscene.optimizer
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(
@@ -12,6 +13,8 @@ if __name__ == "__main__":
     )
 
     parser.add_argument('-g', '--globals')
+    parser.add_argument('-O0', '--no-optimize', action='store_true', help='write the steps as they are generated')
+    parser.add_argument('-r', '--report', action='store_true', help='print the size of the script before and after optimizing')
 
     parser.add_argument('input')
     parser.add_argument('output')
@@ -43,5 +46,14 @@ if __name__ == "__main__":
         print('\n\n'.join(errors))
         sys.exit(1)
 
+    steps = cutscene.step_generator.build_cutscene(result.statements, context)
+    before = cutscene.optimizer.CutsceneStats(steps)
+
+    if not args.no_optimize:
+        cutscene.optimizer.optimize(steps)
+
+    if args.report:
+        print(f'{args.input}: {before} -> {cutscene.optimizer.CutsceneStats(steps)}')
+
     with open(args.output, 'wb') as file:
-        cutscene.step_generator.generate_steps(file, result.statements, context)
\ No newline at end of file
+        cutscene.step_generator.write_cutscene(file, steps, context)
\ No newline at end of file
@@ -0,0 +1,433 @@
+import struct
+import io
+
+from . import expresion_generator
+from . import step_generator
+
+# expression passes
+
+_int_unary = {
+    expresion_generator.EXPRESSION_TYPE_NOT: lambda a: 0 if a else 1,
+    expresion_generator.EXPRESSION_TYPE_NEGATE: lambda a: -a,
+}
+
+_float_unary = {
+    expresion_generator.EXPRESSION_TYPE_NEGATEF: lambda a: -a,
+}
+
+# a is the top of the stack, which is the left operand
+_int_binary = {
+    expresion_generator.EXPRESSION_TYPE_AND: lambda a, b: 1 if a and b else 0,
+    expresion_generator.EXPRESSION_TYPE_OR: lambda a, b: 1 if a or b else 0,
+    expresion_generator.EXPRESSION_TYPE_EQ: lambda a, b: 1 if a == b else 0,
+    expresion_generator.EXPRESSION_TYPE_NEQ: lambda a, b: 1 if a != b else 0,
+    expresion_generator.EXPRESSION_TYPE_GT: lambda a, b: 1 if a > b else 0,
+    expresion_generator.EXPRESSION_TYPE_GTE: lambda a, b: 1 if a >= b else 0,
+    expresion_generator.EXPRESSION_TYPE_ADD: lambda a, b: a + b,
+    expresion_generator.EXPRESSION_TYPE_SUB: lambda a, b: a - b,
+    expresion_generator.EXPRESSION_TYPE_MUL: lambda a, b: a * b,
+}
+
+_float_compare = {
+    expresion_generator.EXPRESSION_TYPE_GTF: lambda a, b: 1 if a > b else 0,
+    expresion_generator.EXPRESSION_TYPE_GTEF: lambda a, b: 1 if a >= b else 0,
+}
+
+_float_binary = {
+    expresion_generator.EXPRESSION_TYPE_ADDF: lambda a, b: a + b,
+    expresion_generator.EXPRESSION_TYPE_SUBF: lambda a, b: a - b,
+    expresion_generator.EXPRESSION_TYPE_MULF: lambda a, b: a * b,
+}
+
+# instructions that cancel out when they appear twice in a row
+_self_inverse = {
+    expresion_generator.EXPRESSION_TYPE_NEGATE,
+    expresion_generator.EXPRESSION_TYPE_NEGATEF,
+}
+
+def _to_s32(value: int) -> int:
+    return ((value + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+
+def _to_f32(value: float) -> float:
+    return struct.unpack('>f', struct.pack('>f', value))[0]
+
+def _int_literal(step) -> int | None:
+    if isinstance(step, expresion_generator.ExpresionScriptIntLiteral):
+        return step.value
+    return None
+
+def _float_literal(step) -> float | None:
+    if isinstance(step, expresion_generator.ExpresionScriptFloatLiteral):
+        return step.original_value
+    return None
+
+def _is_literal(step) -> bool:
+    return _int_literal(step) is not None or _float_literal(step) is not None
+
+def _command(step) -> int | None:
+    if isinstance(step, expresion_generator.ExpressionCommand):
+        return step.command
+    return None
+
+def _fold_unary(literal, command: int):
+    int_value = _int_literal(literal)
+    float_value = _float_literal(literal)
+
+    if int_value is not None:
+        if command in _int_unary:
+            return expresion_generator.ExpresionScriptIntLiteral(_to_s32(_int_unary[command](int_value)))
+        if command == expresion_generator.EXPRESSION_TYPE_ITOF:
+            return expresion_generator.ExpresionScriptFloatLiteral(_to_f32(float(int_value)))
+
+    if float_value is not None:
+        if command in _float_unary:
+            return expresion_generator.ExpresionScriptFloatLiteral(_float_unary[command](float_value))
+        if command == expresion_generator.EXPRESSION_TYPE_FTOI:
+            return expresion_generator.ExpresionScriptIntLiteral(_to_s32(int(float_value)))
+
+    return None
+
+def _fold_binary(b, a, command: int):
+    if _int_literal(a) is not None and _int_literal(b) is not None:
+        a_value = _int_literal(a)
+        b_value = _int_literal(b)
+
+        if command in _int_binary:
+            return expresion_generator.ExpresionScriptIntLiteral(_to_s32(_int_binary[command](a_value, b_value)))
+
+        if command == expresion_generator.EXPRESSION_TYPE_DIV and b_value != 0:
+            # c division rounds towards zero
+            quotient = abs(a_value) // abs(b_value)
+            return expresion_generator.ExpresionScriptIntLiteral(_to_s32(quotient if (a_value < 0) == (b_value < 0) else -quotient))
+
+    if _float_literal(a) is not None and _float_literal(b) is not None:
+        a_value = _float_literal(a)
+        b_value = _float_literal(b)
+
+        if command in _float_compare:
+            return expresion_generator.ExpresionScriptIntLiteral(_float_compare[command](a_value, b_value))
+
+        if command in _float_binary:
+            return expresion_generator.ExpresionScriptFloatLiteral(_to_f32(_float_binary[command](a_value, b_value)))
+
+        if command == expresion_generator.EXPRESSION_TYPE_DIVF and b_value != 0.0:
+            return expresion_generator.ExpresionScriptFloatLiteral(_to_f32(a_value / b_value))
+
+    return None
+
+def _simplify_with_literal(literal: int, command: int, literal_is_left: bool):
+    """
+    what a binary operation between a load and an int literal becomes
+    'load' if it is just the load, an int if it is a constant or None
+    loads have no side effects so dropping one is safe
+    """
+    if command == expresion_generator.EXPRESSION_TYPE_ADD and literal == 0:
+        return 'load'
+    if command == expresion_generator.EXPRESSION_TYPE_SUB and literal == 0 and not literal_is_left:
+        return 'load'
+    if command == expresion_generator.EXPRESSION_TYPE_MUL and literal == 1:
+        return 'load'
+    if command == expresion_generator.EXPRESSION_TYPE_DIV and literal == 1 and not literal_is_left:
+        return 'load'
+    if command == expresion_generator.EXPRESSION_TYPE_MUL and literal == 0:
+        return 0
+    if command == expresion_generator.EXPRESSION_TYPE_AND and literal == 0:
+        return 0
+    if command == expresion_generator.EXPRESSION_TYPE_OR and literal != 0:
+        return 1
+    return None
+
+def _peephole(steps: list) -> bool:
+    for idx in range(len(steps)):
+        command = _command(steps[idx])
+
+        if command is None:
+            continue
+
+        if idx >= 1 and _is_literal(steps[idx - 1]):
+            folded = _fold_unary(steps[idx - 1], command)
+
+            if folded:
+                steps[idx - 1:idx + 1] = [folded]
+                return True
+
+        if idx >= 2 and _is_literal(steps[idx - 2]) and _is_literal(steps[idx - 1]):
+            folded = _fold_binary(steps[idx - 2], steps[idx - 1], command)
+
+            if folded:
+                steps[idx - 2:idx + 1] = [folded]
+                return True
+
+        if idx >= 1 and command in _self_inverse and _command(steps[idx - 1]) == command:
+            del steps[idx - 1:idx + 1]
+            return True
+
+        # not not not x is not x
+        if idx >= 2 and command == expresion_generator.EXPRESSION_TYPE_NOT and \
+                _command(steps[idx - 1]) == command and _command(steps[idx - 2]) == command:
+            del steps[idx - 1:idx + 1]
+            return True
+
+        if idx >= 2:
+            b = steps[idx - 2]
+            a = steps[idx - 1]
+            simplified = None
+            load = None
+
+            if isinstance(a, expresion_generator.ExpresionScriptLoad) and _int_literal(b) is not None:
+                simplified = _simplify_with_literal(_int_literal(b), command, False)
+                load = a
+            elif isinstance(b, expresion_generator.ExpresionScriptLoad) and _int_literal(a) is not None:
+                simplified = _simplify_with_literal(_int_literal(a), command, True)
+                load = b
+
+            if simplified == 'load':
+                steps[idx - 2:idx + 1] = [load]
+                return True
+            elif simplified is not None:
+                steps[idx - 2:idx + 1] = [expresion_generator.ExpresionScriptIntLiteral(simplified)]
+                return True
+
+    return False
+
+def optimize_expression(script: expresion_generator.ExpressionScript):
+    while _peephole(script.steps):
+        pass
+
+def _literal_result(script: expresion_generator.ExpressionScript) -> int | None:
+    if len(script.steps) != 2:
+        return None
+    return _int_literal(script.steps[0])
+
+# compare steps jump unless the variable compares to the literal
+
+_compare_commands = {
+    expresion_generator.EXPRESSION_TYPE_EQ: step_generator.CUTSCENE_COMPARE_EQ,
+    expresion_generator.EXPRESSION_TYPE_NEQ: step_generator.CUTSCENE_COMPARE_NEQ,
+    expresion_generator.EXPRESSION_TYPE_GT: step_generator.CUTSCENE_COMPARE_GT,
+    expresion_generator.EXPRESSION_TYPE_GTE: step_generator.CUTSCENE_COMPARE_GTE,
+}
+
+# literal > load is load < literal
+_swapped_compare = {
+    step_generator.CUTSCENE_COMPARE_EQ: step_generator.CUTSCENE_COMPARE_EQ,
+    step_generator.CUTSCENE_COMPARE_NEQ: step_generator.CUTSCENE_COMPARE_NEQ,
+    step_generator.CUTSCENE_COMPARE_GT: step_generator.CUTSCENE_COMPARE_LT,
+    step_generator.CUTSCENE_COMPARE_GTE: step_generator.CUTSCENE_COMPARE_LTE,
+}
+
+_inverted_compare = {
+    step_generator.CUTSCENE_COMPARE_EQ: step_generator.CUTSCENE_COMPARE_NEQ,
+    step_generator.CUTSCENE_COMPARE_NEQ: step_generator.CUTSCENE_COMPARE_EQ,
+    step_generator.CUTSCENE_COMPARE_GT: step_generator.CUTSCENE_COMPARE_LTE,
+    step_generator.CUTSCENE_COMPARE_GTE: step_generator.CUTSCENE_COMPARE_LT,
+    step_generator.CUTSCENE_COMPARE_LT: step_generator.CUTSCENE_COMPARE_GTE,
+    step_generator.CUTSCENE_COMPARE_LTE: step_generator.CUTSCENE_COMPARE_GT,
+}
+
+def _is_int_load(step) -> bool:
+    return isinstance(step, expresion_generator.ExpresionScriptLoad) and \
+        step.data_type in expresion_generator.type_mapping and \
+        expresion_generator.type_mapping[step.data_type] == 'int'
+
+def _match_compare(script: expresion_generator.ExpressionScript):
+    steps = script.steps[:-1]
+    inverted = False
+
+    while len(steps) > 1 and _command(steps[-1]) == expresion_generator.EXPRESSION_TYPE_NOT:
+        steps = steps[:-1]
+        inverted = not inverted
+
+    result = None
+
+    if len(steps) == 1 and _is_int_load(steps[0]):
+        result = (steps[0], step_generator.CUTSCENE_COMPARE_NEQ, 0)
+    elif len(steps) == 3 and _command(steps[2]) in _compare_commands:
+        compare = _compare_commands[_command(steps[2])]
+
+        if _int_literal(steps[0]) is not None and _is_int_load(steps[1]):
+            result = (steps[1], compare, _int_literal(steps[0]))
+        elif _is_int_load(steps[0]) and _int_literal(steps[1]) is not None:
+            result = (steps[0], _swapped_compare[compare], _int_literal(steps[1]))
+
+    if not result:
+        return None
+
+    load, compare, literal = result
+
+    if inverted:
+        compare = _inverted_compare[compare]
+
+    return step_generator.JumpCompareCutsceneStep(load, compare, literal)
+
+# cutscene passes
+
+def _is_jump(step) -> bool:
+    return isinstance(step, step_generator.JumpCutsceneStep)
+
+def _is_conditional(step) -> bool:
+    return _is_jump(step) and step.command != step_generator.CUTSCENE_STEP_TYPE_JUMP
+
+def _resolve_targets(steps: list):
+    for idx, step in enumerate(steps):
+        if _is_jump(step):
+            target = idx + 1 + step.offset
+            step.target = steps[target] if target < len(steps) else None
+
+def _apply_offsets(steps: list):
+    index_of = {id(step): idx for idx, step in enumerate(steps)}
+
+    for idx, step in enumerate(steps):
+        if _is_jump(step):
+            target = index_of[id(step.target)] if step.target else len(steps)
+            step.offset = target - (idx + 1)
+
+def _is_targeted(steps: list, step) -> bool:
+    return any(_is_jump(other) and other.target is step for other in steps)
+
+def _replace(steps: list, start: int, end: int, replacement: list):
+    # anything jumping into the replaced steps lands at the start of
+    # the replacement or on the step after if there isn't one
+    removed = {id(step) for step in steps[start:end]}
+    new_target = replacement[0] if replacement else (steps[end] if end < len(steps) else None)
+
+    for step in steps:
+        if _is_jump(step) and step.target is not None and id(step.target) in removed:
+            step.target = new_target
+
+    for step in replacement:
+        if _is_jump(step) and step.target is not None and id(step.target) in removed:
+            step.target = new_target
+
+    steps[start:end] = replacement
+
+def _next_step(steps: list, idx: int):
+    return steps[idx + 1] if idx + 1 < len(steps) else None
+
+def _fold_constant_branches(steps: list) -> bool:
+    for idx in range(len(steps) - 1):
+        step = steps[idx]
+        jump = steps[idx + 1]
+
+        if not isinstance(step, step_generator.ExpressionCutsceneStep) or \
+                not _is_jump(jump) or \
+                jump.command != step_generator.CUTSCENE_STEP_TYPE_JUMP_IF_NOT or \
+                _is_targeted(steps, jump):
+            continue
+
+        value = _literal_result(step.script)
+
+        if value is None:
+            continue
+
+        if value:
+            _replace(steps, idx, idx + 2, [])
+        else:
+            always = step_generator.JumpCutsceneStep(step_generator.CUTSCENE_STEP_TYPE_JUMP)
+            always.target = jump.target
+            _replace(steps, idx, idx + 2, [always])
+
+        return True
+
+    return False
+
+def _remove_unreachable(steps: list) -> bool:
+    if not steps:
+        return False
+
+    index_of = {id(step): idx for idx, step in enumerate(steps)}
+    reachable = set()
+    pending = [0]
+
+    while pending:
+        idx = pending.pop()
+
+        if idx >= len(steps) or idx in reachable:
+            continue
+
+        reachable.add(idx)
+        step = steps[idx]
+
+        if _is_jump(step):
+            pending.append(index_of[id(step.target)] if step.target else len(steps))
+
+        if not _is_jump(step) or _is_conditional(step):
+            pending.append(idx + 1)
+
+    if len(reachable) == len(steps):
+        return False
+
+    for idx in reversed(range(len(steps))):
+        if not idx in reachable:
+            _replace(steps, idx, idx + 1, [])
+
+    return True
+
+def _remove_empty_jumps(steps: list) -> bool:
+    for idx, step in enumerate(steps):
+        if not _is_jump(step) or step.target is not _next_step(steps, idx):
+            continue
+
+        # an unconditional jump to the next step does nothing and the
+        # fused conditions have no side effects
+        if step.command == step_generator.CUTSCENE_STEP_TYPE_JUMP_IF_NOT:
+            continue
+
+        _replace(steps, idx, idx + 1, [])
+        return True
+
+    return False
+
+def _fuse_conditions(steps: list):
+    idx = 0
+
+    while idx < len(steps) - 1:
+        step = steps[idx]
+        jump = steps[idx + 1]
+
+        if isinstance(step, step_generator.ExpressionCutsceneStep) and \
+                _is_jump(jump) and \
+                jump.command == step_generator.CUTSCENE_STEP_TYPE_JUMP_IF_NOT and \
+                not _is_targeted(steps, jump):
+            fused = _match_compare(step.script) or step_generator.JumpExpressionCutsceneStep(step.script)
+            fused.target = jump.target
+            _replace(steps, idx, idx + 2, [fused])
+
+        idx += 1
+
+class CutsceneStats():
+    def __init__(self, cutscene: step_generator.Cutscene):
+        self.step_count: int = len(cutscene.steps)
+        self.instruction_count: int = 0
+
+        for step in cutscene.steps:
+            if hasattr(step, 'script'):
+                self.instruction_count += len(step.script.steps)
+            elif isinstance(step, step_generator.JumpCompareCutsceneStep):
+                # the load and compare it replaced
+                self.instruction_count += 1
+
+        data = io.BytesIO()
+        step_generator.write_steps(data, cutscene)
+        self.byte_size: int = len(data.getvalue())
+
+    def __str__(self):
+        return f'{self.step_count} steps {self.byte_size} bytes {self.instruction_count} instructions'
+
+def optimize(cutscene: step_generator.Cutscene):
+    steps = cutscene.steps
+    _resolve_targets(steps)
+
+    for step in steps:
+        if isinstance(step, step_generator.ExpressionCutsceneStep):
+            optimize_expression(step.script)
+
+    while _fold_constant_branches(steps) or _remove_unreachable(steps) or _remove_empty_jumps(steps):
+        pass
+
+    _fuse_conditions(steps)
+
+    while _remove_empty_jumps(steps):
+        pass
+
+    _apply_offsets(steps)
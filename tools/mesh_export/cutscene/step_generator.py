@@ -15,6 +15,17 @@ CUTSCENE_STEP_TYPE_JUMP_IF_NOT = 4
 CUTSCENE_STEP_TYPE_JUMP = 5
 CUTSCENE_STEP_TYPE_SET_LOCAL = 6
 CUTSCENE_STEP_TYPE_SET_GLOBAL = 7
+# 8 is CUTSCENE_STEP_TYPE_DELAY which is only built at runtime
+# the steps below are only produced by optimizer.py
+CUTSCENE_STEP_TYPE_JUMP_IF_NOT_COMPARE = 9
+CUTSCENE_STEP_TYPE_JUMP_IF_NOT_EXPRESSION = 10
+
+CUTSCENE_COMPARE_EQ = 0
+CUTSCENE_COMPARE_NEQ = 1
+CUTSCENE_COMPARE_GT = 2
+CUTSCENE_COMPARE_GTE = 3
+CUTSCENE_COMPARE_LT = 4
+CUTSCENE_COMPARE_LTE = 5
 
 class ParameterType():
     def __init__(self, name: str, is_static: bool):
@@ -45,12 +56,61 @@ class CutsceneStep():
         self.command: int = command
         self.data: bytes = data
 
+    def serialize(self, file):
+        file.write(struct.pack('>B', self.command))
+        file.write(self.data)
+
+class ExpressionCutsceneStep():
+    def __init__(self, script: expresion_generator.ExpressionScript):
+        self.command: int = CUTSCENE_STEP_TYPE_EXPRESSION
+        self.script: expresion_generator.ExpressionScript = script
+
+    def serialize(self, file):
+        file.write(struct.pack('>B', self.command))
+        self.script.serialize(file)
+
 class JumpCutsceneStep():
     def __init__(self, command: int, label: str | None = None, token = None):
         self.command: int = command
         self.offset: int = 0
         self.label: str | None = label
         self.token = token
+        # the step jumped to while optimizing, None is the end
+        self.target = None
+
+    def serialize(self, file):
+        file.write(struct.pack('>B', self.command))
+        file.write(struct.pack('>h', self.offset))
+
+# jumps unless a variable compares to a literal
+class JumpCompareCutsceneStep(JumpCutsceneStep):
+    def __init__(self, load: expresion_generator.ExpresionScriptLoad, compare: int, literal: int):
+        super().__init__(CUTSCENE_STEP_TYPE_JUMP_IF_NOT_COMPARE)
+        self.load: expresion_generator.ExpresionScriptLoad = load
+        self.compare: int = compare
+        self.literal: int = literal
+
+    def serialize(self, file):
+        file.write(struct.pack('>B', self.command))
+        file.write(expresion_generator.generate_variable_address(self.load.data_type, self.load.bit_offset))
+        file.write(struct.pack(
+            '>BBih', 
+            1 if self.load.command == expresion_generator.EXPRESSION_TYPE_LOAD_GLOBAL else 0, 
+            self.compare, 
+            self.literal, 
+            self.offset
+        ))
+
+# evaluates a condition and jumps if it is false in one step
+class JumpExpressionCutsceneStep(JumpCutsceneStep):
+    def __init__(self, script: expresion_generator.ExpressionScript):
+        super().__init__(CUTSCENE_STEP_TYPE_JUMP_IF_NOT_EXPRESSION)
+        self.script: expresion_generator.ExpressionScript = script
+
+    def serialize(self, file):
+        file.write(struct.pack('>B', self.command))
+        self.script.serialize(file)
+        file.write(struct.pack('>h', self.offset))
 
 class Cutscene():
     def __init__(self):
@@ -136,7 +196,7 @@ def _generate_function_step(cutscene: Cutscene, step: parser.CutsceneStep, args:
             pre_expression = expression
                 
     if pre_expression:
-        cutscene.steps.append(CutsceneStep(CUTSCENE_STEP_TYPE_EXPRESSION, pre_expression.to_bytes()))
+        cutscene.steps.append(ExpressionCutsceneStep(pre_expression))
 
 
     data = io.BytesIO()
@@ -261,7 +321,7 @@ def _generate_step(cutscene: Cutscene, step, context: variable_layout.VariableCo
         expression = expresion_generator.generate_script(step.condition, context)
         if not expression:
             raise Exception(f"Could not generate expression {step.condition}")
-        cutscene.steps.append(CutsceneStep(CUTSCENE_STEP_TYPE_EXPRESSION, expression.to_bytes()))
+        cutscene.steps.append(ExpressionCutsceneStep(expression))
 
         if_step = JumpCutsceneStep(CUTSCENE_STEP_TYPE_JUMP_IF_NOT)
         cutscene.steps.append(if_step)
@@ -295,7 +355,7 @@ def _generate_step(cutscene: Cutscene, step, context: variable_layout.VariableCo
         expression = expresion_generator.generate_script(step.value, context)
         if not expression:
             raise Exception(f"Could not generate expression {step.value}")
-        cutscene.steps.append(CutsceneStep(CUTSCENE_STEP_TYPE_EXPRESSION, expression.to_bytes()))
+        cutscene.steps.append(ExpressionCutsceneStep(expression))
 
         step_type = CUTSCENE_STEP_TYPE_SET_LOCAL if context.is_local(step.name.value) else CUTSCENE_STEP_TYPE_SET_GLOBAL
         var_type = context.get_variable_type(step.name.value)
@@ -306,7 +366,7 @@ def _generate_step(cutscene: Cutscene, step, context: variable_layout.VariableCo
             expresion_generator.generate_variable_address(var_type, bit_offset)
         ))
 
-def generate_steps(file, statements: list, context: variable_layout.VariableContext):
+def build_cutscene(statements: list, context: variable_layout.VariableContext) -> Cutscene:
     cutscene = Cutscene()
 
     for statement in statements:
@@ -320,15 +380,20 @@ def generate_steps(file, statements: list, context: variable_layout.VariableCont
         print('\n\n'.join(errors))
         sys.exit(1)
 
+    return cutscene
+
+def write_steps(file, cutscene: Cutscene):
+    for step in cutscene.steps:
+        step.serialize(file)
+
+def write_cutscene(file, cutscene: Cutscene, context: variable_layout.VariableContext):
     file.write('CTSN'.encode())
 
     file.write(struct.pack('>H', len(cutscene.steps)))
 
     context.locals.write_default_values(file)
 
-    for step in cutscene.steps:
-        file.write(struct.pack('>B', step.command))
-        if isinstance(step, CutsceneStep):
-            file.write(step.data)
-        elif isinstance(step, JumpCutsceneStep):
-            file.write(struct.pack('>h', step.offset))
+    write_steps(file, cutscene)
+
+def generate_steps(file, statements: list, context: variable_layout.VariableContext):
+    write_cutscene(file, build_cutscene(statements, context), context)
@@ -151,29 +151,30 @@ class MeshIndex():
 
         return f"min = {self.min_point}\nstride_inv = {self.stride_inv}\nblock_count = {self.block_count}\nblocks = {len(self.blocks)}\n{indices}"
     
-    def serialize(self, file):
-        file.write(struct.pack(">fff", self.min_point.x, self.min_point.y, self.min_point.z))
-        file.write(struct.pack(">fff", self.stride_inv.x, self.stride_inv.y, self.stride_inv.z))
-        file.write(struct.pack(">BBB", int(self.block_count.x), int(self.block_count.y), int(self.block_count.z)))
-
-        index_count = 0
+    def write_blob(self, blob, at: int):
+        """at is the location of a struct mesh_index"""
+        blob.pack_into(at, "fff", self.min_point.x, self.min_point.y, self.min_point.z)
+        blob.pack_into(at + 12, "fff", self.stride_inv.x, self.stride_inv.y, self.stride_inv.z)
+        blob.pack_into(at + 24, "BBB", int(self.block_count.x), int(self.block_count.y), int(self.block_count.z))
+
+        blob.align(4)
+        blocks = blob.tell()
+        current_index = 0
 
         for block in self.blocks:
-            index_count += len(block.indices)
-
-        file.write(struct.pack(">H", index_count))
+            blob.write(struct.pack(">HH", current_index, current_index + len(block.indices)))
+            current_index += len(block.indices)
 
-        for block in self.blocks:
-            for index in block.indices:
-                file.write(struct.pack(">H", index))
+        blob.set_pointer(at + 28, blocks)
 
-        current_index = 0
+        blob.align(2)
+        indices = blob.tell()
 
         for block in self.blocks:
-            file.write(struct.pack(">HH", current_index, current_index + len(block.indices)))
-            current_index += len(block.indices)
-
+            for index in block.indices:
+                blob.write(struct.pack(">H", index))
 
+        blob.set_pointer(at + 32, indices)
 
     def _block_coordinates(self, input: mathutils.Vector) -> mathutils.Vector:
         return (input - self.min_point) * self.stride_inv
@@ -248,27 +249,34 @@ class MeshCollider():
 
         bm.free()
 
-    def write_out(self, file):
-        file.write('CMSH'.encode())
-        file.write(len(self.vertices).to_bytes(2, 'big'))
+    def write_blob(self, blob, at: int):
+        """at is the location of a struct mesh_collider"""
+        blob.align(4)
+        vertices = blob.tell()
 
         for vert in self.vertices:
-            file.write(struct.pack(
+            blob.write(struct.pack(
                 ">fff",
                 vert.x,
                 vert.y,
                 vert.z
             ))
 
-        file.write(len(self.triangles).to_bytes(2, 'big'))
+        blob.set_pointer(at, vertices)
+
+        blob.align(2)
+        triangles = blob.tell()
 
         for triangle in self.triangles:
-            file.write(struct.pack(
+            blob.write(struct.pack(
                 ">HHH",
                 triangle.indices[0],
                 triangle.indices[1],
                 triangle.indices[2],
             ))
 
+        blob.set_pointer(at + 4, triangles)
+        blob.pack_into(at + 8, "H", len(self.triangles))
+
         index = MeshIndex(self.vertices, self.triangles)
-        index.serialize(file)
\ No newline at end of file
+        index.write_blob(blob, at + 12)
@@ -0,0 +1,46 @@
+import struct
+
+class BlobWriter():
+    """Builds a block of memory that is loaded with a single read. Pointers
+    are stored as offsets from the start of the blob and each pointer location
+    is recorded so the loader can relocate them in one pass"""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.relocations: list[int] = []
+
+    def tell(self) -> int:
+        return len(self.data)
+
+    def align(self, alignment: int):
+        padding = (alignment - len(self.data) % alignment) % alignment
+        self.data.extend(bytes(padding))
+
+    def write(self, data: bytes) -> int:
+        result = len(self.data)
+        self.data.extend(data)
+        return result
+
+    def reserve(self, size: int, alignment: int = 4) -> int:
+        self.align(alignment)
+        return self.write(bytes(size))
+
+    def pack_into(self, offset: int, format: str, *values):
+        struct.pack_into('>' + format, self.data, offset, *values)
+
+    def set_pointer(self, offset: int, target: int):
+        self.pack_into(offset, 'I', target)
+        self.relocations.append(offset)
+
+    def relocate_offset(self, offset: int, base: int):
+        """offset is the location of a pointer relative to base"""
+        current = struct.unpack_from('>I', self.data, offset)[0]
+        self.set_pointer(offset, current + base)
+
+    def write_out(self, file):
+        self.align(8)
+        file.write(self.data)
+
+    def write_relocations(self, file):
+        for relocation in self.relocations:
+            file.write(struct.pack('>I', relocation))
@@ -37,6 +37,9 @@ class SerializeContext():
         file.write(struct.pack('>H', len(all_bytes)))
         file.write(all_bytes)
 
+    def string_bytes(self) -> bytes:
+        return b''.join(self._string_data)
+
 
 fixed_sizes = {
     'float': 4,
@@ -4,6 +4,7 @@ import os
 import mathutils
 import math
 import struct
+import io
 
 sys.path.append(os.path.dirname(__file__))
 
@@ -14,7 +15,9 @@ import entities.mesh_optimizer
 import entities.material_extract
 import parse.struct_parse
 import parse.struct_serialize
+import parse.blob_writer
 import cutscene.expresion_generator
+import cutscene.optimizer
 import cutscene.parser
 import cutscene.variable_layout
 
@@ -89,17 +92,17 @@ def process_linked_object(world: World, obj: bpy.types.Object, mesh: bpy.types.M
     
     world.objects.append(ObjectEntry(obj, type, definitions[def_type_name]))
 
-def write_static(world: World, base_transform: mathutils.Matrix, file):
-    settings = entities.export_settings.ExportSettings()
+def gather_static(world: World, base_transform: mathutils.Matrix):
     mesh_list = entities.mesh.mesh_list(base_transform)
 
     for entry in world.static:
         mesh_list.append(entry.obj)
 
     meshes = mesh_list.determine_mesh_data()
-    meshes = list(map(lambda x: (x[0], entities.mesh_optimizer.remove_duplicates(x[1])), meshes))
+    return list(map(lambda x: (x[0], entities.mesh_optimizer.remove_duplicates(x[1])), meshes))
 
-    file.write(len(meshes).to_bytes(2, 'big'))
+def write_static(meshes, file):
+    settings = entities.export_settings.ExportSettings()
 
     for mesh in meshes:
         # this signals the mesh should be embedded
@@ -109,7 +112,146 @@ def write_static(world: World, base_transform: mathutils.Matrix, file):
         settings.default_material = entities.material_extract.load_material_with_name(mesh[0], mesh[1].mat)
 
         entities.tiny3d_mesh_writer.write_mesh([mesh], None, [], settings, file)
-    
+
+WORLD_VERSION = 4
+
+# these must match the layout of the structs in src/scene/world.h
+WORLD_BLOB_SIZE = 72
+WORLD_BLOB_LOCATIONS = 48
+WORLD_BLOB_ENTITY_GROUPS = 52
+WORLD_BLOB_LOADING_ZONES = 56
+WORLD_BLOB_CONDITIONS = 60
+WORLD_BLOB_COUNTS = 64
+
+WORLD_CONDITION_ALWAYS = 0xFFFF
+
+WORLD_LOCATION_SIZE = 24
+WORLD_ENTITY_GROUP_SIZE = 16
+LOADING_ZONE_SIZE = 28
+
+def write_blob_locations(world: World, blob: parse.blob_writer.BlobWriter, string_base: int, context: parse.struct_serialize.SerializeContext):
+    locations = blob.reserve(WORLD_LOCATION_SIZE * len(world.locations))
+
+    for index, location in enumerate(world.locations):
+        at = locations + index * WORLD_LOCATION_SIZE
+        blob.set_pointer(at, string_base + context.get_string_offset(location.name))
+
+        transform = io.BytesIO()
+        parse.struct_serialize.write_vector3_position(transform, location.obj)
+        parse.struct_serialize.write_vector2_rotation(transform, location.obj)
+        blob.data[at + 4:at + WORLD_LOCATION_SIZE] = transform.getvalue()
+
+    blob.set_pointer(WORLD_BLOB_LOCATIONS, locations)
+
+class ConditionTable():
+    """entities with the same spawn condition share a single program
+    so the loader only has to evaluate each one once"""
+
+    def __init__(self, variable_context):
+        self.variable_context = variable_context
+        self.programs: list[bytes] = []
+        self.program_index: dict[bytes, int] = {}
+
+    def get_index(self, condition_text: str, name: str) -> int:
+        condition = cutscene.parser.parse_expression(condition_text, name)
+        script = cutscene.expresion_generator.generate_script(condition, self.variable_context, 'int')
+        cutscene.optimizer.optimize_expression(script)
+
+        if len(script.steps) == 2 and isinstance(script.steps[0], cutscene.expresion_generator.ExpresionScriptIntLiteral) and script.steps[0].value != 0:
+            return WORLD_CONDITION_ALWAYS
+
+        # skip the EXPR header and size
+        program = script.to_bytes()[6:]
+
+        if not program in self.program_index:
+            self.program_index[program] = len(self.programs)
+            self.programs.append(program)
+
+        return self.program_index[program]
+
+    def write_blob(self, blob: parse.blob_writer.BlobWriter):
+        conditions = blob.reserve(4 * len(self.programs))
+
+        for index, program in enumerate(self.programs):
+            blob.set_pointer(conditions + index * 4, blob.write(program))
+
+        blob.set_pointer(WORLD_BLOB_CONDITIONS, conditions)
+
+def write_blob_entity_groups(grouped_list, blob: parse.blob_writer.BlobWriter, string_base: int, context: parse.struct_serialize.SerializeContext, condition_table: ConditionTable):
+    groups = blob.reserve(WORLD_ENTITY_GROUP_SIZE * len(grouped_list))
+
+    for group_index, item in enumerate(grouped_list):
+        def_name = item[0]
+        at = groups + group_index * WORLD_ENTITY_GROUP_SIZE
+
+        type_locations: list[parse.struct_serialize.TypeLocation] = []
+        struct_size, struct_alignment = parse.struct_serialize.obj_gather_types(item[1][0].def_type, type_locations, context)
+
+        blob.set_pointer(at, string_base + context.get_string_offset(def_name))
+
+        blob.align(max(struct_alignment, 4))
+        definitions = blob.tell()
+
+        for entry in item[1]:
+            definition = io.BytesIO()
+            parse.struct_serialize.write_obj(definition, entry.obj, entry.def_type, context)
+            definition_bytes = definition.getvalue()
+            definition_start = blob.write(definition_bytes + bytes(struct_size - len(definition_bytes)))
+
+            for type_location in type_locations:
+                if type_location.type_id == parse.struct_serialize.TYPE_ID_STR:
+                    blob.relocate_offset(definition_start + type_location.offset, string_base)
+
+        blob.set_pointer(at + 4, definitions)
+
+        condition_indices = blob.reserve(2 * len(item[1]))
+
+        for entry_index, entry in enumerate(item[1]):
+            condition_index = WORLD_CONDITION_ALWAYS
+
+            if 'condition' in entry.obj:
+                condition_index = condition_table.get_index(entry.obj['condition'], entry.obj.name + ".condition")
+
+            blob.pack_into(condition_indices + entry_index * 2, "H", condition_index)
+
+        blob.set_pointer(at + 8, condition_indices)
+        blob.pack_into(at + 12, "HH", len(item[1]), struct_size)
+
+    blob.set_pointer(WORLD_BLOB_ENTITY_GROUPS, groups)
+
+def write_blob_loading_zones(world: World, blob: parse.blob_writer.BlobWriter, string_base: int, context: parse.struct_serialize.SerializeContext, base_transform: mathutils.Matrix):
+    loading_zones = blob.reserve(LOADING_ZONE_SIZE * len(world.loading_zones))
+
+    for index, loading_zone in enumerate(world.loading_zones):
+        at = loading_zones + index * LOADING_ZONE_SIZE
+        bb_min, bb_max = loading_zone.bounding_box(base_transform)
+        blob.pack_into(at, "ffffff", bb_min.x, bb_min.y, bb_min.z, bb_max.x, bb_max.y, bb_max.z)
+        blob.set_pointer(at + 24, string_base + context.get_string_offset(loading_zone.target))
+
+    blob.set_pointer(WORLD_BLOB_LOADING_ZONES, loading_zones)
+
+def write_manifest(manifest_filename: str, blob: parse.blob_writer.BlobWriter, static_meshes):
+    """the manifest lets the game prefetch a world before it is needed"""
+    dependencies = []
+
+    for mesh in static_meshes:
+        if not mesh[0].startswith('materials/'):
+            continue
+
+        material_romname = f"rom:/{mesh[0]}.mat"
+
+        if not material_romname in dependencies:
+            dependencies.append(material_romname)
+
+    with open(manifest_filename, 'wb') as file:
+        file.write('WMAN'.encode())
+        file.write(struct.pack('>IHB', len(blob.data), len(static_meshes), len(dependencies)))
+
+        for dependency in dependencies:
+            dependency_bytes = dependency.encode()
+            file.write(len(dependency_bytes).to_bytes(1, 'big'))
+            file.write(dependency_bytes)
+
 def process_scene():
     input_filename = sys.argv[1]
     output_filename = sys.argv[-1]
@@ -160,78 +302,59 @@ def process_scene():
         if obj.rigid_body and obj.rigid_body.collision_shape == 'MESH':
             world.world_mesh_collider.append(mesh, final_transform)
 
-    with open(output_filename, 'wb') as file:
-        file.write('WRLD'.encode())
-
-        file.write(len(world.locations).to_bytes(1, 'big'))
-
-        for location in world.locations:
-            location_bytes = location.name.encode()
-            file.write(len(location_bytes).to_bytes(1, 'big'))
-            file.write(location_bytes)
+    grouped: dict[str, list[ObjectEntry]] = {}
 
-            parse.struct_serialize.write_vector3_position(file, location.obj)
-            parse.struct_serialize.write_vector2_rotation(file, location.obj)
+    for object in world.objects:
+        key = object.name
 
-        write_static(world, base_transform, file)
+        parse.struct_serialize.layout_strings(object.obj, object.def_type, context, None)
 
-        world.world_mesh_collider.write_out(file)
+        if key in grouped:
+            grouped[key].append(object)
+        else:
+            grouped[key] = [object]
 
-        grouped: dict[str, list[ObjectEntry]] = {}
+    grouped_list = sorted(list(grouped.items()), key=lambda x: x[0])
 
-        for object in world.objects:
-            key = object.name
+    for location in world.locations:
+        context.get_string_offset(location.name)
 
-            parse.struct_serialize.layout_strings(object.obj, object.def_type, context, None)
+    for item in grouped_list:
+        context.get_string_offset(item[0])
 
-            if key in grouped:
-                grouped[key].append(object)
-            else:
-                grouped[key] = [object]
+    for loading_zone in world.loading_zones:
+        context.get_string_offset(loading_zone.target)
 
-        for loading_zone in world.loading_zones:
-            context.get_string_offset(loading_zone.target)
+    blob = parse.blob_writer.BlobWriter()
+    blob.reserve(WORLD_BLOB_SIZE)
 
-        context.write_strings(file)
+    string_base = blob.write(context.string_bytes())
 
-        grouped_list = sorted(list(grouped.items()), key=lambda x: x[0])
+    write_blob_locations(world, blob, string_base, context)
+    world.world_mesh_collider.write_blob(blob, 0)
+    condition_table = ConditionTable(variable_context)
+    write_blob_entity_groups(grouped_list, blob, string_base, context, condition_table)
+    write_blob_loading_zones(world, blob, string_base, context, base_transform)
+    condition_table.write_blob(blob)
 
-        file.write(len(grouped_list).to_bytes(2, 'big'))
+    blob.pack_into(WORLD_BLOB_COUNTS, "HHHH", len(world.locations), len(grouped_list), len(world.loading_zones), len(condition_table.programs))
+    blob.align(8)
 
-        for item in grouped_list:
-            def_name = item[0]
+    static_meshes = gather_static(world, base_transform)
 
-            file.write(len(def_name).to_bytes(1, 'big'))
-            file.write(def_name.encode())
+    # scenes with a lot of particles or skinned meshes can request a
+    # larger frame memory pool, 0 uses the default size
+    frame_memory_kb = int(bpy.context.scene.get('frame_memory_kb', 0))
 
-            type_locations: list[parse.struct_serialize.TypeLocation] = []
+    with open(output_filename, 'wb') as file:
+        file.write('WRLD'.encode())
+        file.write(struct.pack('>HHIIHxx', WORLD_VERSION, len(static_meshes), len(blob.data), len(blob.relocations), frame_memory_kb))
 
-            file.write(len(item[1]).to_bytes(2, 'big'))
-            struct_size, struct_alignment = parse.struct_serialize.obj_gather_types(item[1][0].def_type, type_locations, context)
-            file.write(struct_size.to_bytes(2, 'big'))
+        blob.write_out(file)
+        blob.write_relocations(file)
 
-            file.write(struct.pack(">B", len(type_locations)))
+        write_static(static_meshes, file)
 
-            for type_location in type_locations:
-                file.write(struct.pack(">BB", type_location.type_id, type_location.offset))
-            
-            for entry in item[1]:
-                parse.struct_serialize.write_obj(file, entry.obj, entry.def_type, context)
-
-            for entry in item[1]:
-                condition_text = entry.obj['condition'] if 'condition' in entry.obj else 'true'
-                condition = cutscene.parser.parse_expression(condition_text, entry.obj.name + ".condition")
-                script = cutscene.expresion_generator.generate_script(condition, variable_context, 'int')
-                script.serialize(file)
-
-        file.write(struct.pack(">H", len(world.loading_zones)))
-
-        for loading_zone in world.loading_zones:
-            bb_min, bb_max = loading_zone.bounding_box(base_transform)
-            print(bb_min, bb_max)
-            file.write(struct.pack(">fff", bb_min.x, bb_min.y, bb_min.z))
-            file.write(struct.pack(">fff", bb_max.x, bb_max.y, bb_max.z))
-            file.write(struct.pack(">I", context.get_string_offset(loading_zone.target)))
-            
+    write_manifest(output_filename.replace('.world', '.manifest'), blob, static_meshes)
 
 process_scene()
\ No newline at end of file
@@ -3,19 +3,21 @@ const fs = require('fs');
 const call_pairings = [
     ['malloc', 'free'],
     ['material_load', 'material_release'],
-    ['material_cache_load', 'material_cache_release'],
+    [['material_cache_load', 'material_cache_load_id'], 'material_cache_release'],
     [
         ['render_scene_add', 'render_scene_add_renderable', 'render_scene_add_renderable_single_axis'], 
         'render_scene_remove'
     ],
     ['renderable_single_axis_init', 'renderable_single_axis_destroy'],
     ['renderable_init', 'renderable_destroy'],
-    ['update_add', 'update_remove'],
+    [['update_add', 'update_add_interval'], 'update_remove'],
     ['collision_scene_add', 'collision_scene_remove'],
     ['animator_init', 'animator_destroy'],
-    ['animation_cache_load', 'animation_cache_release'],
+    [['animation_cache_load', 'animation_cache_load_id'], 'animation_cache_release'],
     ['spell_exec_init', 'spell_exec_destroy'],
     ['effect_malloc', 'effect_free'],
+    ['world_malloc', 'world_free'],
+    ['tagged_malloc', 'tagged_free'],
     ['rspq_block_end', 'rspq_block_free'],
     ['health_init', 'health_destroy'],
 ];